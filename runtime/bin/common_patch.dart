@@ -33,7 +33,7 @@ import "dart:math" show min;
 
 import "dart:nativewrappers" show NativeFieldWrapperClass1;
 
-import "dart:typed_data" show Uint8List;
+import "dart:typed_data" show Int32List, Uint8List;
 
 /// These are the additional parts of this patch library:
 // part "directory_patch.dart";
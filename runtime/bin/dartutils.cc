@@ -661,6 +661,30 @@ bool DartUtils::PostInt64(Dart_Port port_id, int64_t value) {
   return Dart_PostCObject(port_id, &object);
 }
 
+bool DartUtils::PostInt32Array(Dart_Port port_id,
+                               int32_t* values,
+                               intptr_t length) {
+  // Post a message with an Int32List holding the values.
+  Dart_CObject object;
+  object.type = Dart_CObject_kTypedData;
+  object.value.as_typed_data.type = Dart_TypedData_kInt32;
+  object.value.as_typed_data.length = length;
+  object.value.as_typed_data.values = reinterpret_cast<uint8_t*>(values);
+  return Dart_PostCObject(port_id, &object);
+}
+
+bool DartUtils::PostInt64Array(Dart_Port port_id,
+                               int64_t* values,
+                               intptr_t length) {
+  // Post a message with an Int64List holding the values.
+  Dart_CObject object;
+  object.type = Dart_CObject_kTypedData;
+  object.value.as_typed_data.type = Dart_TypedData_kInt64;
+  object.value.as_typed_data.length = length;
+  object.value.as_typed_data.values = reinterpret_cast<uint8_t*>(values);
+  return Dart_PostCObject(port_id, &object);
+}
+
 Dart_Handle DartUtils::GetDartType(const char* library_url,
                                    const char* class_name) {
   return Dart_GetType(Dart_LookupLibrary(NewString(library_url)),
@@ -161,6 +161,12 @@ class DartUtils {
   static bool PostNull(Dart_Port port_id);
   static bool PostInt32(Dart_Port port_id, int32_t value);
   static bool PostInt64(Dart_Port port_id, int64_t value);
+  static bool PostInt32Array(Dart_Port port_id,
+                             int32_t* values,
+                             intptr_t length);
+  static bool PostInt64Array(Dart_Port port_id,
+                             int64_t* values,
+                             intptr_t length);
 
   static Dart_Handle GetDartType(const char* library_url,
                                  const char* class_name);
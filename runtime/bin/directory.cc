@@ -8,13 +8,16 @@
 #include "bin/directory.h"
 
 #include "bin/dartutils.h"
+#include "bin/file.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
 #include "bin/log.h"
 #include "bin/namespace.h"
 #include "bin/typed_data_utils.h"
 #include "bin/utils.h"
 #include "include/dart_api.h"
 #include "platform/assert.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -345,6 +348,108 @@ CObject* Directory::CreateTempRequest(const CObjectArray& request) {
   return new CObjectString(CObject::NewString(result));
 }
 
+// The response to a ListNext request: pairs of a response type and its
+// argument. Consecutive files, directories and links are packed into a single
+// external Uint8List argument of a kListPacked pair, each as its type
+// followed by its null terminated path, rather than being sent as a pair
+// each.
+class DirectoryListingBatch {
+ public:
+  DirectoryListingBatch()
+      : array_(new CObjectArray(CObject::NewArray(kArraySize))),
+        index_(0),
+        packed_(NULL),
+        packed_length_(0),
+        packed_capacity_(0) {}
+
+  ~DirectoryListingBatch() {
+    if (packed_ != NULL) {
+      IOBuffer::Free(packed_);
+    }
+  }
+
+  // Whether more entries should be added. Leaves room for a packed pair and
+  // an error or done pair after the last entry.
+  bool HasRoom() const {
+    return (packed_length_ < kPackedSize) && (index_ + 4 <= kArraySize);
+  }
+
+  bool AddEntry(AsyncDirectoryListing::Response type, const char* path) {
+    const intptr_t path_length = strlen(path);
+    const intptr_t length = packed_length_ + path_length + 2;
+    if (length > packed_capacity_) {
+      const intptr_t capacity =
+          Utils::Maximum(Utils::Maximum(length, 2 * packed_capacity_),
+                         kMinimumPackedCapacity);
+      packed_ = IOBuffer::Reallocate(packed_, capacity);
+      if (packed_ == NULL) {
+        OUT_OF_MEMORY();
+      }
+      packed_capacity_ = capacity;
+    }
+    packed_[packed_length_] = type;
+    memmove(packed_ + packed_length_ + 1, path, path_length);
+    packed_[length - 1] = '\0';
+    packed_length_ = length;
+    return HasRoom();
+  }
+
+  bool AddError(CObject* error, const char* path) {
+    Flush();
+    CObjectArray* response = new CObjectArray(CObject::NewArray(3));
+    response->SetAt(0, new CObjectInt32(CObject::NewInt32(
+                           AsyncDirectoryListing::kListError)));
+    response->SetAt(1, new CObjectString(CObject::NewString(path)));
+    response->SetAt(2, error);
+    Add(AsyncDirectoryListing::kListError, response);
+    return HasRoom();
+  }
+
+  void AddDone() {
+    Flush();
+    Add(AsyncDirectoryListing::kListDone, CObject::Null());
+  }
+
+  CObjectArray* Finish() {
+    Flush();
+    // The listing usually ends before it fills the array.
+    array_->AsApiCObject()->value.as_array.length = index_;
+    return array_;
+  }
+
+ private:
+  static const intptr_t kArraySize = 128;
+  static const intptr_t kPackedSize = 256 * KB;
+  static const intptr_t kMinimumPackedCapacity = 4 * KB;
+
+  void Add(AsyncDirectoryListing::Response type, CObject* argument) {
+    ASSERT(index_ + 2 <= kArraySize);
+    array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
+    array_->SetAt(index_++, argument);
+  }
+
+  void Flush() {
+    if (packed_length_ == 0) {
+      return;
+    }
+    Dart_CObject* packed = CObject::NewExternalUint8Array(
+        packed_length_, packed_, packed_, IOBuffer::Finalizer);
+    Add(AsyncDirectoryListing::kListPacked,
+        new CObjectExternalUint8Array(packed));
+    packed_ = NULL;
+    packed_length_ = 0;
+    packed_capacity_ = 0;
+  }
+
+  CObjectArray* array_;
+  intptr_t index_;
+  uint8_t* packed_;
+  intptr_t packed_length_;
+  intptr_t packed_capacity_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryListingBatch);
+};
+
 static CObject* CreateIllegalArgumentError() {
   // Respond with an illegal argument list error message.
   CObjectArray* error = new CObjectArray(CObject::NewArray(3));
@@ -361,16 +466,17 @@ CObject* Directory::ListStartRequest(const CObjectArray& request) {
   }
   Namespace* namespc = CObjectToNamespacePointer(request[0]);
   RefCntReleaseScope<Namespace> rs(namespc);
-  if ((request.Length() != 4) || !request[1]->IsUint8Array() ||
-      !request[2]->IsBool() || !request[3]->IsBool()) {
+  if ((request.Length() != 5) || !request[1]->IsUint8Array() ||
+      !request[2]->IsBool() || !request[3]->IsBool() || !request[4]->IsBool()) {
     return CreateIllegalArgumentError();
   }
   CObjectUint8Array path(request[1]);
   CObjectBool recursive(request[2]);
   CObjectBool follow_links(request[3]);
+  CObjectBool parallel(request[4]);
   AsyncDirectoryListing* dir_listing = new AsyncDirectoryListing(
       namespc, reinterpret_cast<const char*>(path.Buffer()), recursive.Value(),
-      follow_links.Value());
+      follow_links.Value(), parallel.Value());
   if (dir_listing->error()) {
     // Report error now, so we capture the correct OSError.
     CObject* err = CObject::NewOSError();
@@ -395,17 +501,19 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   AsyncDirectoryListing* dir_listing =
       reinterpret_cast<AsyncDirectoryListing*>(ptr.Value());
   RefCntReleaseScope<AsyncDirectoryListing> rs(dir_listing);
+  if (dir_listing->parallel()) {
+    DirectoryListingBatch batch;
+    dir_listing->ListParallel(&batch);
+    return batch.Finish();
+  }
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
-  CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
-  dir_listing->SetArray(response, kArraySize);
+  DirectoryListingBatch batch;
+  dir_listing->set_batch(&batch);
   Directory::List(dir_listing);
-  // In case the listing ended before it hit the buffer length, we need to
-  // override the array length.
-  response->AsApiCObject()->value.as_array.length = dir_listing->index();
-  return response;
+  dir_listing->set_batch(NULL);
+  return batch.Finish();
 }
 
 CObject* Directory::ListStopRequest(const CObjectArray& request) {
@@ -423,7 +531,7 @@ CObject* Directory::ListStopRequest(const CObjectArray& request) {
   // with any other call on the listing. We don't do an extra Release(), and
   // we don't delete the weak persistent handle. The file is closed here, but
   // the memory for the listing will be cleaned up when the finalizer runs.
-  dir_listing->PopAll();
+  dir_listing->Stop();
   return new CObjectBool(CObject::Bool(true));
 }
 
@@ -446,52 +554,163 @@ CObject* Directory::RenameRequest(const CObjectArray& request) {
              : CObject::NewOSError();
 }
 
-bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
-                                                          const char* arg) {
-  array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
-  if (arg != NULL) {
-    size_t len = strlen(arg);
-    Dart_CObject* io_buffer = CObject::NewIOBuffer(len);
-    uint8_t* data = io_buffer->value.as_external_typed_data.data;
-    strncpy(reinterpret_cast<char*>(data), arg, len);
+// A subdirectory waiting to be listed in parallel mode. It is either not
+// opened yet, or partially listed into an earlier batch.
+struct PendingDirectory {
+  char* path;
+  DirectoryListing* listing;
+  PendingDirectory* next;
+};
 
-    CObjectExternalUint8Array* external_array =
-        new CObjectExternalUint8Array(io_buffer);
-    array_->SetAt(index_++, external_array);
-  } else {
-    array_->SetAt(index_++, CObject::Null());
+// Lists a single directory of a parallel mode listing into the batch of the
+// ListNext request listing it, and adds its subdirectories to the pending
+// ones.
+class SubdirectoryListing : public DirectoryListing {
+ public:
+  SubdirectoryListing(AsyncDirectoryListing* owner, const char* dir_name)
+      : DirectoryListing(owner->namespc(), dir_name, false, false),
+        owner_(owner),
+        batch_(NULL) {}
+
+  void set_batch(DirectoryListingBatch* batch) { batch_ = batch; }
+
+  virtual bool HandleDirectory(const char* dir_name) {
+    owner_->AddPendingDirectory(dir_name);
+    return batch_->AddEntry(AsyncDirectoryListing::kListDirectory, dir_name);
+  }
+
+  virtual bool HandleFile(const char* file_name) {
+    return batch_->AddEntry(AsyncDirectoryListing::kListFile, file_name);
+  }
+
+  virtual bool HandleLink(const char* link_name) {
+    return batch_->AddEntry(AsyncDirectoryListing::kListLink, link_name);
+  }
+
+  virtual bool HandleError() {
+    CObject* err = CObject::NewOSError();
+    return batch_->AddError(err, error() ? "Invalid path" : CurrentPath());
+  }
+
+ private:
+  AsyncDirectoryListing* owner_;
+  DirectoryListingBatch* batch_;
+
+  DISALLOW_COPY_AND_ASSIGN(SubdirectoryListing);
+};
+
+AsyncDirectoryListing::AsyncDirectoryListing(Namespace* namespc,
+                                             const char* dir_name,
+                                             bool recursive,
+                                             bool follow_links,
+                                             bool parallel)
+    : ReferenceCounted(),
+      DirectoryListing(namespc, dir_name, recursive, follow_links),
+      batch_(NULL),
+      parallel_(parallel && recursive && !follow_links),
+      pending_(NULL),
+      active_(0),
+      done_(false) {
+  if (parallel_) {
+    // The directory itself is the first one to list.
+    pending_ = new PendingDirectory();
+    pending_->path = strdup(dir_name);
+    pending_->listing = NULL;
+    pending_->next = NULL;
+  }
+}
+
+AsyncDirectoryListing::~AsyncDirectoryListing() {
+  Stop();
+}
+
+void AsyncDirectoryListing::AddPendingDirectory(const char* dir_name) {
+  PendingDirectory* pending = new PendingDirectory();
+  pending->path = reinterpret_cast<char*>(
+      malloc(strlen(dir_name) + strlen(File::PathSeparator()) + 1));
+  strcpy(pending->path, dir_name);  // NOLINT
+  strcat(pending->path, File::PathSeparator());  // NOLINT
+  pending->listing = NULL;
+  MutexLocker ml(&mutex_);
+  pending->next = pending_;
+  pending_ = pending;
+}
+
+void AsyncDirectoryListing::ListParallel(DirectoryListingBatch* batch) {
+  while (batch->HasRoom()) {
+    SubdirectoryListing* listing;
+    {
+      MutexLocker ml(&mutex_);
+      PendingDirectory* pending = pending_;
+      if (pending == NULL) {
+        // The listing is done once no directory is pending or being listed.
+        // Otherwise the requests listing the rest report it.
+        if ((active_ == 0) && !done_) {
+          done_ = true;
+          batch->AddDone();
+        }
+        return;
+      }
+      pending_ = pending->next;
+      active_++;
+      listing = static_cast<SubdirectoryListing*>(pending->listing);
+      if (listing == NULL) {
+        listing = new SubdirectoryListing(this, pending->path);
+      }
+      free(pending->path);
+      delete pending;
+    }
+    listing->set_batch(batch);
+    Directory::List(listing);
+    listing->set_batch(NULL);
+    MutexLocker ml(&mutex_);
+    active_--;
+    if (!listing->error() && !listing->IsEmpty()) {
+      // The batch is full. Finish the directory in a later batch.
+      PendingDirectory* pending = new PendingDirectory();
+      pending->path = NULL;
+      pending->listing = listing;
+      pending->next = pending_;
+      pending_ = pending;
+      return;
+    }
+    delete listing;
+  }
+}
+
+void AsyncDirectoryListing::Stop() {
+  PopAll();
+  MutexLocker ml(&mutex_);
+  while (pending_ != NULL) {
+    PendingDirectory* pending = pending_;
+    pending_ = pending->next;
+    free(pending->path);
+    delete pending->listing;
+    delete pending;
   }
-  return index_ < length_;
 }
 
 bool AsyncDirectoryListing::HandleDirectory(const char* dir_name) {
-  return AddFileSystemEntityToResponse(kListDirectory, dir_name);
+  return batch_->AddEntry(kListDirectory, dir_name);
 }
 
 bool AsyncDirectoryListing::HandleFile(const char* file_name) {
-  return AddFileSystemEntityToResponse(kListFile, file_name);
+  return batch_->AddEntry(kListFile, file_name);
 }
 
 bool AsyncDirectoryListing::HandleLink(const char* link_name) {
-  return AddFileSystemEntityToResponse(kListLink, link_name);
+  return batch_->AddEntry(kListLink, link_name);
 }
 
 void AsyncDirectoryListing::HandleDone() {
-  AddFileSystemEntityToResponse(kListDone, NULL);
+  batch_->AddDone();
 }
 
 bool AsyncDirectoryListing::HandleError() {
-  CObject* err = CObject::NewOSError();
-  array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(kListError)));
-  CObjectArray* response = new CObjectArray(CObject::NewArray(3));
-  response->SetAt(0, new CObjectInt32(CObject::NewInt32(kListError)));
   // Delay calling CurrentPath() until after CObject::NewOSError() in case
   // CurrentPath() pollutes the OS error code.
-  response->SetAt(1, new CObjectString(CObject::NewString(
-                         error() ? "Invalid path" : CurrentPath())));
-  response->SetAt(2, err);
-  array_->SetAt(index_++, response);
-  return index_ < length_;
+  CObject* err = CObject::NewOSError();
+  return batch_->AddError(err, error() ? "Invalid path" : CurrentPath());
 }
 
 bool SyncDirectoryListing::HandleDirectory(const char* dir_name) {
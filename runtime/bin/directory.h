@@ -153,6 +153,10 @@ class DirectoryListing {
   bool follow_links_;
 };
 
+class DirectoryListingBatch;
+
+struct PendingDirectory;
+
 class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
                               public DirectoryListing {
  public:
@@ -161,18 +165,15 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
     kListDirectory = 1,
     kListLink = 2,
     kListError = 3,
-    kListDone = 4
+    kListDone = 4,
+    kListPacked = 5
   };
 
   AsyncDirectoryListing(Namespace* namespc,
                         const char* dir_name,
                         bool recursive,
-                        bool follow_links)
-      : ReferenceCounted(),
-        DirectoryListing(namespc, dir_name, recursive, follow_links),
-        array_(NULL),
-        index_(0),
-        length_(0) {}
+                        bool follow_links,
+                        bool parallel);
 
   virtual bool HandleDirectory(const char* dir_name);
   virtual bool HandleFile(const char* file_name);
@@ -180,21 +181,37 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
   virtual bool HandleError();
   virtual void HandleDone();
 
-  void SetArray(CObjectArray* array, intptr_t length) {
-    ASSERT(length % 2 == 0);
-    array_ = array;
-    index_ = 0;
-    length_ = length;
-  }
+  void set_batch(DirectoryListingBatch* batch) { batch_ = batch; }
+
+  // In parallel mode, each subdirectory is listed on its own, and any number
+  // of ListNext requests may list different subdirectories at the same time.
+  // Links are not followed in parallel mode.
+  bool parallel() const { return parallel_; }
+
+  // Lists pending subdirectories into [batch] until it is full, and adds
+  // kListDone to it once all of them are listed. Called concurrently by
+  // ListNext requests in parallel mode.
+  void ListParallel(DirectoryListingBatch* batch);
 
-  intptr_t index() const { return index_; }
+  // Adds the subdirectory [dir_name] to the ones waiting to be listed in
+  // parallel mode.
+  void AddPendingDirectory(const char* dir_name);
+
+  // Closes the directories being listed and drops the pending ones.
+  void Stop();
 
  private:
-  virtual ~AsyncDirectoryListing() {}
-  bool AddFileSystemEntityToResponse(Response response, const char* arg);
-  CObjectArray* array_;
-  intptr_t index_;
-  intptr_t length_;
+  virtual ~AsyncDirectoryListing();
+
+  DirectoryListingBatch* batch_;
+  bool parallel_;
+
+  // Parallel mode state, guarded by mutex_. Directories that are partially
+  // listed are at the front of pending_, so that they are finished first.
+  Mutex mutex_;
+  PendingDirectory* pending_;
+  intptr_t active_;
+  bool done_;
 
   friend class ReferenceCounted<AsyncDirectoryListing>;
   DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncDirectoryListing);
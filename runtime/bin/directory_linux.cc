@@ -7,14 +7,15 @@
 
 #include "bin/directory.h"
 
-#include <dirent.h>     // NOLINT
-#include <errno.h>      // NOLINT
-#include <fcntl.h>      // NOLINT
-#include <stdlib.h>     // NOLINT
-#include <string.h>     // NOLINT
-#include <sys/param.h>  // NOLINT
-#include <sys/stat.h>   // NOLINT
-#include <unistd.h>     // NOLINT
+#include <dirent.h>       // NOLINT
+#include <errno.h>        // NOLINT
+#include <fcntl.h>        // NOLINT
+#include <stdlib.h>       // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/param.h>    // NOLINT
+#include <sys/stat.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/dartutils.h"
@@ -80,6 +81,43 @@ struct LinkList {
   LinkList* next;
 };
 
+// The entries of a directory, read in bulk with getdents64 rather than one
+// buffer of a fixed small size at a time by readdir.
+class DirectoryEntries {
+ public:
+  DirectoryEntries() : offset_(0), length_(0) {}
+
+  // Returns the next entry, or NULL with errno set to 0 at the end of the
+  // directory and to the error otherwise.
+  dirent64* Next(intptr_t fd) {
+    if (offset_ == length_) {
+      intptr_t result = TEMP_FAILURE_RETRY(
+          syscall(SYS_getdents64, fd, buffer_, sizeof(buffer_)));
+      if (result <= 0) {
+        if (result == 0) {
+          errno = 0;
+        }
+        return NULL;
+      }
+      offset_ = 0;
+      length_ = result;
+    }
+    dirent64* entry = reinterpret_cast<dirent64*>(buffer_ + offset_);
+    offset_ += entry->d_reclen;
+    return entry;
+  }
+
+ private:
+  static const intptr_t kBufferSize = 64 * KB;
+
+  // Entries are 8 byte aligned in the buffer.
+  uint64_t buffer_[kBufferSize / sizeof(uint64_t)];
+  intptr_t offset_;
+  intptr_t length_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryEntries);
+};
+
 ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (done_) {
     return kListDone;
@@ -98,13 +136,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   }
 
   if (lister_ == 0) {
-    do {
-      lister_ = reinterpret_cast<intptr_t>(fdopendir(fd_));
-    } while ((lister_ == 0) && (errno == EINTR));
-    if (lister_ == 0) {
-      done_ = true;
-      return kListError;
-    }
+    lister_ = reinterpret_cast<intptr_t>(new DirectoryEntries());
     if (parent_ != NULL) {
       if (!listing->path_buffer().Add(File::PathSeparator())) {
         return kListError;
@@ -118,8 +150,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
 
   // Iterate the directory and post the directories and files to the
   // ports.
-  errno = 0;
-  dirent* entry = readdir(reinterpret_cast<DIR*>(lister_));
+  dirent64* entry = reinterpret_cast<DirectoryEntries*>(lister_)->Next(fd_);
   if (entry != NULL) {
     if (!listing->path_buffer().Add(entry->d_name)) {
       done_ = true;
@@ -223,9 +254,9 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
 
 DirectoryListingEntry::~DirectoryListingEntry() {
   ResetLink();
-  if (lister_ != 0) {
-    // This also closes fd_.
-    VOID_NO_RETRY_EXPECTED(closedir(reinterpret_cast<DIR*>(lister_)));
+  delete reinterpret_cast<DirectoryEntries*>(lister_);
+  if (fd_ != -1) {
+    FDUtils::SaveErrorAndClose(fd_);
   }
 }
 
@@ -55,6 +55,8 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
   }
 }
 
+intptr_t EventHandler::thread_count_ = 1;
+
 static EventHandler* event_handler = NULL;
 static Monitor* shutdown_monitor = NULL;
 
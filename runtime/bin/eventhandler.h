@@ -643,10 +643,22 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  /**
+   * Number of threads the event-handler spreads descriptors and timers over.
+   * Must be set before Start. Currently only honored on Linux.
+   */
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t count) {
+    ASSERT(count > 0);
+    thread_count_ = count;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
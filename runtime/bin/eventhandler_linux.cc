@@ -24,6 +24,7 @@
 #include "bin/log.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "platform/atomic.h"
 #include "platform/utils.h"
 
 namespace dart {
@@ -42,6 +43,57 @@ intptr_t DescriptorInfo::GetPollEvents() {
   return events;
 }
 
+void PendingEvents::Add(Dart_Port port,
+                        Dart_Port dispatch_port,
+                        intptr_t events) {
+  if (length_ == kMaxEvents) {
+    Flush();
+  }
+  ports_[length_] = port;
+  dispatch_ports_[length_] = dispatch_port;
+  events_[length_] = static_cast<int32_t>(events);
+  length_++;
+}
+
+void PendingEvents::Flush() {
+  bool posted[kMaxEvents] = {false};
+  int32_t events[kMaxEvents];
+  int64_t pairs[2 * kMaxEvents];
+  for (intptr_t i = 0; i < length_; i++) {
+    if (posted[i]) {
+      continue;
+    }
+    const Dart_Port dispatch_port = dispatch_ports_[i];
+    if (dispatch_port != ILLEGAL_PORT) {
+      intptr_t length = 0;
+      for (intptr_t j = i; j < length_; j++) {
+        if (!posted[j] && (dispatch_ports_[j] == dispatch_port)) {
+          pairs[length++] = ports_[j];
+          pairs[length++] = events_[j];
+          posted[j] = true;
+        }
+      }
+      DartUtils::PostInt64Array(dispatch_port, pairs, length);
+      continue;
+    }
+    const Dart_Port port = ports_[i];
+    intptr_t count = 0;
+    for (intptr_t j = i; j < length_; j++) {
+      if (!posted[j] && (dispatch_ports_[j] == ILLEGAL_PORT) &&
+          (ports_[j] == port)) {
+        events[count++] = events_[j];
+        posted[j] = true;
+      }
+    }
+    if (count == 1) {
+      DartUtils::PostInt32(port, events[0]);
+    } else {
+      DartUtils::PostInt32Array(port, events, count);
+    }
+  }
+  length_ = 0;
+}
+
 // Unregister the file descriptor for a DescriptorInfo structure with
 // epoll.
 static void RemoveFromEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
@@ -68,8 +120,8 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
-EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+EventHandlerShard::EventHandlerShard(EventHandlerImplementation* owner)
+    : owner_(owner), socket_map_(&SimpleHashMap::SamePointerValue, 16) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
   if (result != 0) {
@@ -125,7 +177,7 @@ static void DeleteDescriptorInfo(void* info) {
   delete di;
 }
 
-EventHandlerImplementation::~EventHandlerImplementation() {
+EventHandlerShard::~EventHandlerShard() {
   socket_map_.Clear(DeleteDescriptorInfo);
   close(epoll_fd_);
   close(timer_fd_);
@@ -133,8 +185,8 @@ EventHandlerImplementation::~EventHandlerImplementation() {
   close(interrupt_fds_[1]);
 }
 
-void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
-                                                     DescriptorInfo* di) {
+void EventHandlerShard::UpdateEpollInstance(intptr_t old_mask,
+                                            DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -147,9 +199,8 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   }
 }
 
-DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
-    intptr_t fd,
-    bool is_listening) {
+DescriptorInfo* EventHandlerShard::GetDescriptorInfo(intptr_t fd,
+                                                     bool is_listening) {
   ASSERT(fd >= 0);
   SimpleHashMap::Entry* entry = socket_map_.Lookup(
       GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), true);
@@ -169,9 +220,9 @@ DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
   return di;
 }
 
-void EventHandlerImplementation::WakeupHandler(intptr_t id,
-                                               Dart_Port dart_port,
-                                               int64_t data) {
+void EventHandlerShard::WakeupHandler(intptr_t id,
+                                      Dart_Port dart_port,
+                                      int64_t data) {
   InterruptMessage msg;
   msg.id = id;
   msg.dart_port = dart_port;
@@ -190,7 +241,7 @@ void EventHandlerImplementation::WakeupHandler(intptr_t id,
   }
 }
 
-void EventHandlerImplementation::HandleInterruptFd() {
+void EventHandlerShard::HandleInterruptFd() {
   const intptr_t MAX_MESSAGES = kInterruptMessageSize;
   InterruptMessage msg[MAX_MESSAGES];
   ssize_t bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
@@ -210,6 +261,9 @@ void EventHandlerImplementation::HandleInterruptFd() {
       }
       DescriptorInfo* di =
           GetDescriptorInfo(socket->fd(), IS_LISTENING_SOCKET(msg[i].data));
+      if (!di->IsListeningSocket()) {
+        di->set_dispatch_port(socket->dispatch_port());
+      }
       if (IS_COMMAND(msg[i].data, kShutdownReadCommand)) {
         ASSERT(!di->IsListeningSocket());
         // Close the socket for reading.
@@ -231,6 +285,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
 
         intptr_t fd = di->fd();
         ASSERT(fd == socket->fd());
+        const Dart_Port dispatch_port = di->dispatch_port();
         if (di->IsListeningSocket()) {
           // We only close the socket file descriptor from the operating
           // system if there are no other dart socket objects which
@@ -255,7 +310,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
           delete di;
           socket->SetClosedFd();
         }
-        DartUtils::PostInt32(port, 1 << kDestroyedEvent);
+        pending_events_.Add(port, dispatch_port, 1 << kDestroyedEvent);
       } else if (IS_COMMAND(msg[i].data, kReturnTokenCommand)) {
         int count = TOKEN_COUNT(msg[i].data);
         intptr_t old_mask = di->Mask();
@@ -276,7 +331,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
   }
 }
 
-void EventHandlerImplementation::UpdateTimerFd() {
+void EventHandlerShard::UpdateTimerFd() {
   struct itimerspec it;
   memset(&it, 0, sizeof(it));
   if (timeout_queue_.HasTimeout()) {
@@ -320,8 +375,8 @@ static void PrintEventMask(intptr_t fd, intptr_t events) {
 }
 #endif
 
-intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
-                                                   DescriptorInfo* di) {
+intptr_t EventHandlerShard::GetPollEvents(intptr_t events,
+                                          DescriptorInfo* di) {
 #ifdef DEBUG_POLL
   PrintEventMask(di->fd(), events);
 #endif
@@ -342,8 +397,7 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
-void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
-                                              int size) {
+void EventHandlerShard::HandleEvents(struct epoll_event* events, int size) {
   bool interrupt_seen = false;
   for (int i = 0; i < size; i++) {
     if (events[i].data.ptr == NULL) {
@@ -369,7 +423,7 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
         Dart_Port port = di->NextNotifyDartPort(event_mask);
         ASSERT(port != 0);
         UpdateEpollInstance(old_mask, di);
-        DartUtils::PostInt32(port, event_mask);
+        pending_events_.Add(port, di->dispatch_port(), event_mask);
       }
     }
   }
@@ -378,57 +432,117 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
     // the current events.
     HandleInterruptFd();
   }
+  pending_events_.Flush();
 }
 
-void EventHandlerImplementation::Poll(uword args) {
+void EventHandlerShard::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
   static const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
-  ASSERT(handler_impl != NULL);
+  EventHandlerShard* shard = reinterpret_cast<EventHandlerShard*>(args);
+  ASSERT(shard != NULL);
 
-  while (!handler_impl->shutdown_) {
+  while (!shard->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
+        epoll_wait(shard->epoll_fd_, events, kMaxEvents, -1));
     ASSERT(EAGAIN == EWOULDBLOCK);
     if (result <= 0) {
       if (errno != EWOULDBLOCK) {
         perror("Poll failed");
       }
     } else {
-      handler_impl->HandleEvents(events, result);
+      shard->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
-  handler->NotifyShutdownDone();
+  shard->owner_->NotifyShardShutdownDone();
 }
 
-void EventHandlerImplementation::Start(EventHandler* handler) {
-  int result =
-      Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                    reinterpret_cast<uword>(handler));
+void EventHandlerShard::Start() {
+  int result = Thread::Start("dart:io EventHandler", &EventHandlerShard::Poll,
+                             reinterpret_cast<uword>(this));
   if (result != 0) {
     FATAL1("Failed to start event handler thread %d", result);
   }
 }
 
+void EventHandlerShard::SendData(intptr_t id,
+                                 Dart_Port dart_port,
+                                 int64_t data) {
+  WakeupHandler(id, dart_port, data);
+}
+
+EventHandlerImplementation::EventHandlerImplementation()
+    : handler_(NULL),
+      shards_(NULL),
+      shard_count_(EventHandler::thread_count()),
+      running_shards_(0) {
+  ASSERT(shard_count_ > 0);
+  shards_ = new EventHandlerShard*[shard_count_];
+  for (intptr_t i = 0; i < shard_count_; i++) {
+    shards_[i] = new EventHandlerShard(this);
+  }
+}
+
+EventHandlerImplementation::~EventHandlerImplementation() {
+  for (intptr_t i = 0; i < shard_count_; i++) {
+    delete shards_[i];
+  }
+  delete[] shards_;
+}
+
+void EventHandlerImplementation::Start(EventHandler* handler) {
+  handler_ = handler;
+  running_shards_ = shard_count_;
+  for (intptr_t i = 0; i < shard_count_; i++) {
+    shards_[i]->Start();
+  }
+}
+
 void EventHandlerImplementation::Shutdown() {
-  SendData(kShutdownId, 0, 0);
+  for (intptr_t i = 0; i < shard_count_; i++) {
+    shards_[i]->SendData(kShutdownId, 0, 0);
+  }
+}
+
+void EventHandlerImplementation::NotifyShardShutdownDone() {
+  if (AtomicOperations::FetchAndDecrement(&running_shards_) == 1) {
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler_->NotifyShutdownDone();
+  }
+}
+
+EventHandlerShard* EventHandlerImplementation::ShardFor(intptr_t id,
+                                                        Dart_Port dart_port) {
+  if (shard_count_ == 1) {
+    return shards_[0];
+  }
+  uint32_t hash;
+  if (id == kTimerId) {
+    hash = dart::Utils::WordHash(static_cast<intptr_t>(dart_port));
+  } else {
+    // Closed sockets all end up on the first shard, which drops the message.
+    intptr_t fd = reinterpret_cast<Socket*>(id)->fd();
+    if (fd < 0) {
+      return shards_[0];
+    }
+    hash = dart::Utils::WordHash(fd);
+  }
+  return shards_[hash % shard_count_];
 }
 
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
-  WakeupHandler(id, dart_port, data);
+  ASSERT(id != kShutdownId);
+  ShardFor(id, dart_port)->SendData(id, dart_port, data);
 }
 
-void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
+void* EventHandlerShard::GetHashmapKeyFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return reinterpret_cast<void*>(fd + 1);
 }
 
-uint32_t EventHandlerImplementation::GetHashmapHashFromFd(intptr_t fd) {
+uint32_t EventHandlerShard::GetHashmapHashFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return dart::Utils::WordHash(fd + 1);
 }
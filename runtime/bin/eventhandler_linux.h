@@ -22,18 +22,27 @@ namespace bin {
 
 class DescriptorInfo : public DescriptorInfoBase {
  public:
-  explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd) {}
+  explicit DescriptorInfo(intptr_t fd)
+      : DescriptorInfoBase(fd), dispatch_port_(ILLEGAL_PORT) {}
 
   virtual ~DescriptorInfo() {}
 
   intptr_t GetPollEvents();
 
+  // The dispatch port of the isolate owning a connected socket, see
+  // Socket::dispatch_port(). Listening sockets can be shared between
+  // isolates, so their events always go to the ports of their listeners.
+  Dart_Port dispatch_port() const { return dispatch_port_; }
+  void set_dispatch_port(Dart_Port port) { dispatch_port_ = port; }
+
   virtual void Close() {
     close(fd_);
     fd_ = -1;
   }
 
  private:
+  Dart_Port dispatch_port_;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -58,10 +67,40 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
-class EventHandlerImplementation {
+// Collects the events while one batch of epoll events is handled, so that
+// each isolate dispatch port, or each port of a socket without one, is sent
+// a single message per batch.
+class PendingEvents {
  public:
-  EventHandlerImplementation();
-  ~EventHandlerImplementation();
+  PendingEvents() : length_(0) {}
+
+  void Add(Dart_Port port, Dart_Port dispatch_port, intptr_t events);
+
+  // Posts the collected events in the order they were added. A dispatch port
+  // gets an Int64List of (port, events) pairs for all of its sockets. Other
+  // ports get an int for a single event and an Int32List for several.
+  void Flush();
+
+ private:
+  static const intptr_t kMaxEvents = 64;
+
+  Dart_Port ports_[kMaxEvents];
+  Dart_Port dispatch_ports_[kMaxEvents];
+  int32_t events_[kMaxEvents];
+  intptr_t length_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingEvents);
+};
+
+class EventHandlerImplementation;
+
+// One event handler thread with its own epoll instance, timer and interrupt
+// pipe. Each descriptor and each timer is owned by exactly one shard, so all
+// messages about it are handled in order by the same thread.
+class EventHandlerShard {
+ public:
+  explicit EventHandlerShard(EventHandlerImplementation* owner);
+  ~EventHandlerShard();
 
   void UpdateEpollInstance(intptr_t old_mask, DescriptorInfo* di);
 
@@ -69,8 +108,7 @@ class EventHandlerImplementation {
   // descriptor. Creates a new one if one is not found.
   DescriptorInfo* GetDescriptorInfo(intptr_t fd, bool is_listening);
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
-  void Start(EventHandler* handler);
-  void Shutdown();
+  void Start();
 
  private:
   void HandleEvents(struct epoll_event* events, int size);
@@ -83,13 +121,44 @@ class EventHandlerImplementation {
   static void* GetHashmapKeyFromFd(intptr_t fd);
   static uint32_t GetHashmapHashFromFd(intptr_t fd);
 
+  EventHandlerImplementation* owner_;
   SimpleHashMap socket_map_;
   TimeoutQueue timeout_queue_;
+  PendingEvents pending_events_;
   bool shutdown_;
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
 
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerShard);
+};
+
+class EventHandlerImplementation {
+ public:
+  EventHandlerImplementation();
+  ~EventHandlerImplementation();
+
+  void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
+  void Start(EventHandler* handler);
+  void Shutdown();
+
+ private:
+  friend class EventHandlerShard;
+
+  // Descriptors are assigned to shards by their file descriptor, which
+  // listening sockets shared between isolates also have in common, and
+  // timers by their port.
+  EventHandlerShard* ShardFor(intptr_t id, Dart_Port dart_port);
+
+  // Called by each shard when its thread is done. The last one notifies the
+  // [EventHandler].
+  void NotifyShardShutdownDone();
+
+  EventHandler* handler_;
+  EventHandlerShard** shards_;
+  intptr_t shard_count_;
+  intptr_t running_shards_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
 
@@ -3,7 +3,18 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/eventhandler.h"
+
+#if !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+#endif
+
+#include "bin/lockers.h"
+#include "bin/socket.h"
+#include "bin/thread.h"
 #include "platform/assert.h"
+#include "vm/benchmark_test.h"
+#include "vm/timer.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -80,4 +91,197 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
 }
 
 }  // namespace bin
+
+#if !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+
+// Counts the events of each kind the event handler posts to native ports and
+// the messages it posts them in.
+class EventCounter {
+ public:
+  EventCounter() : in_events_(0), destroyed_events_(0), messages_(0) {}
+
+  void Add(int64_t events) {
+    bin::MonitorLocker ml(&monitor_);
+    if ((events & (1 << bin::kInEvent)) != 0) {
+      in_events_++;
+    }
+    if ((events & (1 << bin::kDestroyedEvent)) != 0) {
+      destroyed_events_++;
+    }
+    ml.Notify();
+  }
+
+  void AddMessage() {
+    bin::MonitorLocker ml(&monitor_);
+    messages_++;
+  }
+
+  void WaitFor(intptr_t in_events, intptr_t destroyed_events) {
+    bin::MonitorLocker ml(&monitor_);
+    while ((in_events_ < in_events) || (destroyed_events_ < destroyed_events)) {
+      ml.Wait();
+    }
+  }
+
+  intptr_t messages() {
+    bin::MonitorLocker ml(&monitor_);
+    return messages_;
+  }
+
+ private:
+  bin::Monitor monitor_;
+  intptr_t in_events_;
+  intptr_t destroyed_events_;
+  intptr_t messages_;
+};
+
+static EventCounter* event_counter = NULL;
+
+static void CountEvents(Dart_Port dest_port_id, Dart_CObject* message) {
+  event_counter->AddMessage();
+  if (message->type == Dart_CObject_kInt32) {
+    event_counter->Add(message->value.as_int32);
+  } else if (message->type == Dart_CObject_kInt64) {
+    event_counter->Add(message->value.as_int64);
+  } else if (message->type == Dart_CObject_kTypedData) {
+    if (message->value.as_typed_data.type == Dart_TypedData_kInt64) {
+      // (port, events) pairs of several sockets posted to a dispatch port.
+      const int64_t* pairs =
+          reinterpret_cast<int64_t*>(message->value.as_typed_data.values);
+      const intptr_t length =
+          message->value.as_typed_data.length / sizeof(int64_t);
+      EXPECT_EQ(0, length % 2);
+      for (intptr_t i = 1; i < length; i += 2) {
+        event_counter->Add(pairs[i]);
+      }
+      return;
+    }
+    // Events the event handler collected for this port in one batch.
+    EXPECT_EQ(Dart_TypedData_kInt32, message->value.as_typed_data.type);
+    const int32_t* events =
+        reinterpret_cast<int32_t*>(message->value.as_typed_data.values);
+    const intptr_t length =
+        message->value.as_typed_data.length / sizeof(int32_t);
+    for (intptr_t i = 0; i < length; i++) {
+      event_counter->Add(events[i]);
+    }
+  }
+}
+
+// Opens, polls and closes |rounds| batches of |connections| connections
+// through the event handler, the way a server with many short lived clients
+// does. Every connection has its own port, like a _NativeSocket. If
+// |dispatch| is set, the connections also share a dispatch port, like the
+// sockets of one isolate. Returns the number of messages posted.
+static intptr_t ChurnConnections(intptr_t connections,
+                                 intptr_t rounds,
+                                 bool dispatch) {
+  const intptr_t kMaxConnections = 64;
+  ASSERT(connections <= kMaxConnections);
+  EventCounter counter;
+  event_counter = &counter;
+  Dart_Port dispatch_port = ILLEGAL_PORT;
+  if (dispatch) {
+    dispatch_port = Dart_NewNativePort("EventDispatcher", CountEvents, false);
+    EXPECT(dispatch_port != ILLEGAL_PORT);
+  }
+  Dart_Port ports[kMaxConnections];
+  for (intptr_t i = 0; i < connections; i++) {
+    ports[i] = Dart_NewNativePort("EventCounter", CountEvents, false);
+    EXPECT(ports[i] != ILLEGAL_PORT);
+  }
+
+  bin::Socket* sockets[kMaxConnections];
+  int peers[kMaxConnections];
+  for (intptr_t round = 1; round <= rounds; round++) {
+    for (intptr_t i = 0; i < connections; i++) {
+      int fds[2];
+      EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+      sockets[i] = new bin::Socket(fds[0]);
+      sockets[i]->set_dispatch_port(dispatch_port);
+      peers[i] = fds[1];
+      sockets[i]->Retain();
+      bin::EventHandler::SendFromNative(
+          reinterpret_cast<intptr_t>(sockets[i]), ports[i],
+          (1 << bin::kSetEventMaskCommand) | (1 << bin::kInEvent));
+      EXPECT_EQ(1, write(peers[i], "x", 1));
+    }
+    counter.WaitFor(round * connections, (round - 1) * connections);
+    for (intptr_t i = 0; i < connections; i++) {
+      sockets[i]->Retain();
+      bin::EventHandler::SendFromNative(reinterpret_cast<intptr_t>(sockets[i]),
+                                        ports[i], 1 << bin::kCloseCommand);
+    }
+    counter.WaitFor(round * connections, round * connections);
+    for (intptr_t i = 0; i < connections; i++) {
+      sockets[i]->Release();
+      close(peers[i]);
+    }
+  }
+
+  for (intptr_t i = 0; i < connections; i++) {
+    EXPECT(Dart_CloseNativePort(ports[i]));
+  }
+  if (dispatch) {
+    EXPECT(Dart_CloseNativePort(dispatch_port));
+  }
+  event_counter = NULL;
+  return counter.messages();
+}
+
+// Runs on the single event handler thread run_vm_tests starts.
+BENCHMARK(EventHandlerConnectionChurn) {
+  Timer timer(true, "Event handler connection churn benchmark");
+  timer.Start();
+  ChurnConnections(64, 64, false);
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+// The same churn with the events of all connections going through one
+// dispatch port.
+BENCHMARK(EventHandlerConnectionChurnDispatched) {
+  Timer timer(true, "Event handler dispatched connection churn benchmark");
+  timer.Start();
+  ChurnConnections(64, 64, true);
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+BENCHMARK_HELPER(EventHandlerConnectionChurnMessages, "MessageCount") {
+  benchmark->set_score(ChurnConnections(64, 64, false));
+}
+
+BENCHMARK_HELPER(EventHandlerConnectionChurnDispatchedMessages,
+                 "MessageCount") {
+  benchmark->set_score(ChurnConnections(64, 64, true));
+}
+
+// Sockets sharing a dispatch port get the events of each batch in one
+// message, instead of one message per socket.
+VM_UNIT_TEST_CASE(EventHandlerDispatchPortBatchesSockets) {
+  const intptr_t per_socket = ChurnConnections(64, 4, false);
+  const intptr_t dispatched = ChurnConnections(64, 4, true);
+  EXPECT(dispatched < per_socket);
+}
+
+// Restarts the event handler with several threads, so connections are
+// spread over more than one shard, and checks every event still arrives.
+VM_UNIT_TEST_CASE(EventHandlerShardedConnections) {
+  const intptr_t kThreadCount = 4;
+  const intptr_t old_thread_count = bin::EventHandler::thread_count();
+  bin::EventHandler::Stop();
+  bin::EventHandler::set_thread_count(kThreadCount);
+  bin::EventHandler::Start();
+
+  ChurnConnections(64, 4, false);
+  ChurnConnections(64, 4, true);
+
+  bin::EventHandler::Stop();
+  bin::EventHandler::set_thread_count(old_thread_count);
+  bin::EventHandler::Start();
+}
+
+#endif  // !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+
 }  // namespace dart
@@ -35,16 +35,20 @@ static bool IsFile(Dart_Handle file_obj) {
 // The file pointer has been passed into Dart as an intptr_t and it is safe
 // to pull it out of Dart as a 64-bit integer, cast it to an intptr_t and
 // from there to a File pointer.
-static File* GetFile(Dart_NativeArguments args) {
+File* File::GetFileNativeField(Dart_Handle file_obj) {
   File* file;
-  Dart_Handle dart_this = ThrowIfError(Dart_GetNativeArgument(args, 0));
-  DEBUG_ASSERT(IsFile(dart_this));
+  DEBUG_ASSERT(IsFile(file_obj));
   Dart_Handle result = Dart_GetNativeInstanceField(
-      dart_this, kFileNativeFieldIndex, reinterpret_cast<intptr_t*>(&file));
+      file_obj, kFileNativeFieldIndex, reinterpret_cast<intptr_t*>(&file));
   ASSERT(!Dart_IsError(result));
   return file;
 }
 
+static File* GetFile(Dart_NativeArguments args) {
+  Dart_Handle dart_this = ThrowIfError(Dart_GetNativeArgument(args, 0));
+  return File::GetFileNativeField(dart_this);
+}
+
 static void SetFile(Dart_Handle dart_this, intptr_t file_pointer) {
   DEBUG_ASSERT(IsFile(dart_this));
   Dart_Handle result = Dart_SetNativeInstanceField(
@@ -293,6 +297,40 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(File_AllocateBuffer)(Dart_NativeArguments args) {
+  // The length is checked in Dart code to be a non-negative integer.
+  intptr_t length = DartUtils::GetNativeIntptrArgument(args, 0);
+  Dart_SetReturnValue(args, DirectBuffer::Allocate(length));
+}
+
+void FUNCTION_NAME(File_GetBufferPointers)(Dart_NativeArguments args) {
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t count = 0;
+  ThrowIfError(Dart_ListLength(buffers_obj, &count));
+  DirectBuffer** buffers = reinterpret_cast<DirectBuffer**>(
+      Dart_ScopeAllocate(count * sizeof(*buffers)));
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle buffer = ThrowIfError(Dart_ListGetAt(buffers_obj, i));
+    buffers[i] = DirectBuffer::Get(buffer);
+    if (buffers[i] == NULL) {
+      // Requests only take pointers when all of their buffers are direct.
+      for (intptr_t j = 0; j < i; j++) {
+        buffers[j]->Release();
+      }
+      Dart_SetReturnValue(args, Dart_Null());
+      return;
+    }
+  }
+  // The pointers are retained, and released by the request they are passed
+  // to.
+  Dart_Handle pointers = ThrowIfError(Dart_NewList(count));
+  for (intptr_t i = 0; i < count; i++) {
+    ThrowIfError(Dart_ListSetAt(
+        pointers, i, Dart_NewInteger(reinterpret_cast<intptr_t>(buffers[i]))));
+  }
+  Dart_SetReturnValue(args, pointers);
+}
+
 void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
   File* file = GetFile(args);
   ASSERT(file != NULL);
@@ -1348,6 +1386,229 @@ CObject* File::WriteFromRequest(const CObjectArray& request) {
              : CObject::NewOSError();
 }
 
+static DirectBuffer* CObjectToDirectBuffer(CObject* cobject) {
+  CObjectIntptr value(cobject);
+  return reinterpret_cast<DirectBuffer*>(value.Value());
+}
+
+// Releases the references to the direct buffers passed at [index] of a
+// malformed request, either one buffer or an array of them, which the
+// request would otherwise have released when done.
+static void ReleaseDirectBuffers(const CObjectArray& request, intptr_t index) {
+  if (request.Length() <= index) {
+    return;
+  }
+  if (request[index]->IsIntptr()) {
+    CObjectToDirectBuffer(request[index])->Release();
+  } else if (request[index]->IsArray()) {
+    CObjectArray pointers(request[index]);
+    for (intptr_t i = 0; i < pointers.Length(); i++) {
+      if (pointers[i]->IsIntptr()) {
+        CObjectToDirectBuffer(pointers[i])->Release();
+      }
+    }
+  }
+}
+
+// Reads at position until length bytes are read or the end of the file is
+// reached. Returns the number of bytes read, or -1 on error.
+static int64_t ReadFullyAt(File* file,
+                           uint8_t* buffer,
+                           int64_t length,
+                           int64_t position) {
+  int64_t total = 0;
+  while (total < length) {
+    int64_t bytes_read =
+        file->ReadAt(buffer + total, length - total, position + total);
+    if (bytes_read < 0) {
+      return -1;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    total += bytes_read;
+  }
+  return total;
+}
+
+static bool WriteFullyAt(File* file,
+                         const uint8_t* buffer,
+                         int64_t length,
+                         int64_t position) {
+  int64_t total = 0;
+  while (total < length) {
+    int64_t bytes_written =
+        file->WriteAt(buffer + total, length - total, position + total);
+    if (bytes_written < 0) {
+      return false;
+    }
+    total += bytes_written;
+  }
+  return true;
+}
+
+CObject* File::ReadAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 5) ||
+      (!request[1]->IsNull() && !request[1]->IsIntptr()) ||
+      !request[2]->IsInt32OrInt64() || !request[3]->IsInt32OrInt64() ||
+      !request[4]->IsInt32OrInt64()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  const int64_t start = CObjectInt32OrInt64ToInt64(request[2]);
+  const int64_t length = CObjectInt32OrInt64ToInt64(request[3]);
+  const int64_t position = CObjectInt32OrInt64ToInt64(request[4]);
+  if (request[1]->IsIntptr()) {
+    // Read directly into the buffer, and reply with the number of bytes read.
+    DirectBuffer* buffer = CObjectToDirectBuffer(request[1]);
+    RefCntReleaseScope<DirectBuffer> buffer_scope(buffer);
+    if (file->IsClosed()) {
+      return CObject::FileClosedError();
+    }
+    ASSERT((start >= 0) && (start + length <= buffer->length()));
+    const int64_t bytes_read =
+        ReadFullyAt(file, buffer->data() + start, length, position);
+    if (bytes_read < 0) {
+      return CObject::NewOSError();
+    }
+    return new CObjectInt64(CObject::NewInt64(bytes_read));
+  }
+  // Read into a new buffer, which is replied like for ReadInto.
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
+  if (io_buffer == NULL) {
+    return CObject::NewOSError();
+  }
+  uint8_t* data = io_buffer->value.as_external_typed_data.data;
+  const int64_t bytes_read = ReadFullyAt(file, data, length, position);
+  if (bytes_read < 0) {
+    CObject::FreeIOBufferData(io_buffer);
+    return CObject::NewOSError();
+  }
+  CObjectExternalUint8Array* external_array =
+      new CObjectExternalUint8Array(io_buffer);
+  external_array->SetLength(bytes_read);
+  CObjectArray* result = new CObjectArray(CObject::NewArray(3));
+  result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+  result->SetAt(1, new CObjectInt64(CObject::NewInt64(bytes_read)));
+  result->SetAt(2, external_array);
+  return result;
+}
+
+CObject* File::ReadVAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 3) || !request[1]->IsArray() ||
+      !request[2]->IsInt32OrInt64()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  CObjectArray pointers(request[1]);
+  const intptr_t count = pointers.Length();
+  DirectBuffer** buffers = reinterpret_cast<DirectBuffer**>(
+      Dart_ScopeAllocate(count * sizeof(*buffers)));
+  uint8_t** data =
+      reinterpret_cast<uint8_t**>(Dart_ScopeAllocate(count * sizeof(*data)));
+  int64_t* lengths =
+      reinterpret_cast<int64_t*>(Dart_ScopeAllocate(count * sizeof(*lengths)));
+  for (intptr_t i = 0; i < count; i++) {
+    ASSERT(pointers[i]->IsIntptr());
+    buffers[i] = CObjectToDirectBuffer(pointers[i]);
+    data[i] = buffers[i]->data();
+    lengths[i] = buffers[i]->length();
+  }
+  CObject* result = NULL;
+  if (file->IsClosed()) {
+    result = CObject::FileClosedError();
+  } else {
+    // Read until all the buffers are full or the end of the file is reached.
+    int64_t position = CObjectInt32OrInt64ToInt64(request[2]);
+    int64_t total = 0;
+    intptr_t index = 0;
+    while (index < count) {
+      int64_t bytes_read = file->ReadVAt(data + index, lengths + index,
+                                         count - index, position + total);
+      if (bytes_read < 0) {
+        result = CObject::NewOSError();
+        break;
+      }
+      if (bytes_read == 0) {
+        break;
+      }
+      total += bytes_read;
+      while ((index < count) && (bytes_read >= lengths[index])) {
+        bytes_read -= lengths[index];
+        index++;
+      }
+      if (index < count) {
+        data[index] += bytes_read;
+        lengths[index] -= bytes_read;
+      }
+    }
+    if (result == NULL) {
+      result = new CObjectInt64(CObject::NewInt64(total));
+    }
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    buffers[i]->Release();
+  }
+  return result;
+}
+
+CObject* File::WriteAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 5) ||
+      (!request[1]->IsIntptr() && !request[1]->IsTypedData()) ||
+      !request[2]->IsInt32OrInt64() || !request[3]->IsInt32OrInt64() ||
+      !request[4]->IsInt32OrInt64()) {
+    ReleaseDirectBuffers(request, 1);
+    return CObject::IllegalArgumentError();
+  }
+  int64_t start = CObjectInt32OrInt64ToInt64(request[2]);
+  int64_t end = CObjectInt32OrInt64ToInt64(request[3]);
+  const int64_t position = CObjectInt32OrInt64ToInt64(request[4]);
+  if (request[1]->IsIntptr()) {
+    // Write directly from the buffer.
+    DirectBuffer* buffer = CObjectToDirectBuffer(request[1]);
+    RefCntReleaseScope<DirectBuffer> buffer_scope(buffer);
+    if (file->IsClosed()) {
+      return CObject::FileClosedError();
+    }
+    ASSERT((start >= 0) && (start <= end) && (end <= buffer->length()));
+    return WriteFullyAt(file, buffer->data() + start, end - start, position)
+               ? new CObjectInt64(CObject::NewInt64(end - start))
+               : CObject::NewOSError();
+  }
+  // Write from the copy of the typed data in the request.
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  CObjectTypedData typed_data(request[1]);
+  start = start * SizeInBytes(typed_data.Type());
+  end = end * SizeInBytes(typed_data.Type());
+  return WriteFullyAt(file, typed_data.Buffer() + start, end - start,
+                      position)
+             ? new CObjectInt64(CObject::NewInt64(end - start))
+             : CObject::NewOSError();
+}
+
 CObject* File::CreateLinkRequest(const CObjectArray& request) {
   if ((request.Length() != 3) || !request[0]->IsIntptr()) {
     return CObject::IllegalArgumentError();
@@ -114,6 +114,21 @@ class File : public ReferenceCounted<File> {
   // occurred the result will be set to false.
   bool ReadFully(void* buffer, int64_t num_bytes);
   bool WriteFully(const void* buffer, int64_t num_bytes);
+
+  // ReadAt/WriteAt attempt to transfer num_bytes to/from buffer at position
+  // in the file, without using or changing the file position. They return
+  // the number of bytes read/written.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+  int64_t WriteAt(const void* buffer, int64_t num_bytes, int64_t position);
+
+  // Attempts to read into the count buffers in turn from position in the
+  // file, without using or changing the file position, with a single system
+  // call where the platform supports it. Returns the total number of bytes
+  // read, which may end in the middle of any of the buffers.
+  int64_t ReadVAt(uint8_t* const* buffers,
+                  const int64_t* lengths,
+                  intptr_t count,
+                  int64_t position);
   bool WriteByte(uint8_t byte) { return WriteFully(&byte, 1); }
 
   bool Print(const char* format, ...) PRINTF_ATTRIBUTE(2, 3) {
@@ -183,6 +198,10 @@ class File : public ReferenceCounted<File> {
   // (stdin, stout or stderr).
   static File* OpenStdio(int fd);
 
+  // Returns the File held by a _RandomAccessFileOpsImpl object, or NULL if
+  // the file has been closed.
+  static File* GetFileNativeField(Dart_Handle file_obj);
+
   static bool Exists(Namespace* namespc, const char* path);
   static bool Create(Namespace* namespc, const char* path);
   static bool CreateLink(Namespace* namespc,
@@ -255,6 +274,9 @@ class File : public ReferenceCounted<File> {
   static CObject* ReadRequest(const CObjectArray& request);
   static CObject* ReadIntoRequest(const CObjectArray& request);
   static CObject* WriteFromRequest(const CObjectArray& request);
+  static CObject* ReadAtRequest(const CObjectArray& request);
+  static CObject* ReadVAtRequest(const CObjectArray& request);
+  static CObject* WriteAtRequest(const CObjectArray& request);
   static CObject* CreateLinkRequest(const CObjectArray& request);
   static CObject* DeleteLinkRequest(const CObjectArray& request);
   static CObject* RenameLinkRequest(const CObjectArray& request);
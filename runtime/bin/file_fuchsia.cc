@@ -113,6 +113,35 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return NO_RETRY_EXPECTED(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return NO_RETRY_EXPECTED(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return NO_RETRY_EXPECTED(pwrite(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::ReadVAt(uint8_t* const* buffers,
+                      const int64_t* lengths,
+                      intptr_t count,
+                      int64_t position) {
+  int64_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    int64_t bytes_read = ReadAt(buffers[i], lengths[i], position + total);
+    if (bytes_read < 0) {
+      // Report the error on the next call if some bytes were read.
+      return (total > 0) ? total : bytes_read;
+    }
+    total += bytes_read;
+    if (bytes_read < lengths[i]) {
+      break;
+    }
+  }
+  return total;
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
@@ -14,6 +14,7 @@
 #include <sys/sendfile.h>  // NOLINT
 #include <sys/stat.h>      // NOLINT
 #include <sys/types.h>     // NOLINT
+#include <sys/uio.h>       // NOLINT
 #include <unistd.h>        // NOLINT
 #include <utime.h>         // NOLINT
 
@@ -113,6 +114,34 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pread64(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pwrite64(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::ReadVAt(uint8_t* const* buffers,
+                      const int64_t* lengths,
+                      intptr_t count,
+                      int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  // Any further buffers are left for the next call.
+  const intptr_t kMaxBuffers = 64;
+  struct iovec iov[kMaxBuffers];
+  count = Utils::Minimum(count, kMaxBuffers);
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = buffers[i];
+    iov[i].iov_len = lengths[i];
+  }
+  return TEMP_FAILURE_RETRY(preadv64(handle_->fd(), iov, count, position));
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
@@ -53,6 +53,21 @@ class _File {
   static int _openStdio(int fd) native "File_OpenStdio";
 }
 
+@patch
+class RandomAccessFile {
+  @patch
+  static Uint8List allocateBuffer(int length) {
+    RangeError.checkNotNegative(length, "length");
+    Uint8List result = _allocateBuffer(length);
+    if (result == null) {
+      throw new OutOfMemoryError();
+    }
+    return result;
+  }
+
+  static _allocateBuffer(int length) native "File_AllocateBuffer";
+}
+
 @patch
 class _RandomAccessFileOps {
   @patch
@@ -77,6 +92,7 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   readInto(List<int> buffer, int start, int end) native "File_ReadInto";
   writeByte(int value) native "File_WriteByte";
   writeFrom(List<int> buffer, int start, int end) native "File_WriteFrom";
+  bufferPointers(List<List<int>> buffers) native "File_GetBufferPointers";
   position() native "File_Position";
   setPosition(int position) native "File_SetPosition";
   truncate(int length) native "File_Truncate";
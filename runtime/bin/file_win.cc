@@ -156,6 +156,71 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return bytes_written;
 }
 
+// Reading and writing at an offset moves the file pointer of a synchronous
+// handle, so it is put back afterwards.
+static int64_t TransferAt(File* file,
+                          bool write,
+                          void* buffer,
+                          int64_t num_bytes,
+                          int64_t position) {
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(file->GetFD()));
+  const int64_t saved_position = file->Position();
+  if (saved_position < 0) {
+    return -1;
+  }
+  OVERLAPPED overlapped;
+  ZeroMemory(&overlapped, sizeof(overlapped));
+  overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+  const DWORD length =
+      static_cast<DWORD>(Utils::Minimum<int64_t>(num_bytes, kMaxInt32));
+  DWORD transferred = 0;
+  BOOL result =
+      write ? WriteFile(handle, buffer, length, &transferred, &overlapped)
+            : ReadFile(handle, buffer, length, &transferred, &overlapped);
+  DWORD error = result ? ERROR_SUCCESS : GetLastError();
+  if (!write && (error == ERROR_HANDLE_EOF)) {
+    result = TRUE;
+    transferred = 0;
+  }
+  file->SetPosition(saved_position);
+  if (!result) {
+    SetLastError(error);
+    return -1;
+  }
+  return transferred;
+}
+
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TransferAt(this, false, buffer, num_bytes, position);
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TransferAt(this, true, const_cast<void*>(buffer), num_bytes,
+                    position);
+}
+
+int64_t File::ReadVAt(uint8_t* const* buffers,
+                      const int64_t* lengths,
+                      intptr_t count,
+                      int64_t position) {
+  int64_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    int64_t bytes_read = ReadAt(buffers[i], lengths[i], position + total);
+    if (bytes_read < 0) {
+      // Report the error on the next call if some bytes were read.
+      return (total > 0) ? total : bytes_read;
+    }
+    total += bytes_read;
+    if (bytes_read < lengths[i]) {
+      break;
+    }
+  }
+  return total;
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
@@ -427,8 +427,11 @@ static void MaybeLoadCode() {
     CHECK_RESULT(result);
   }
 
+  // For AOT snapshots the feedback is only recorded here and used by the
+  // precompiler to lay out the generated code.
   if ((load_type_feedback_filename != NULL) &&
-      ((snapshot_kind == kCoreJIT) || (snapshot_kind == kAppJIT))) {
+      ((snapshot_kind == kCoreJIT) || (snapshot_kind == kAppJIT) ||
+       IsSnapshottingForPrecompilation())) {
     uint8_t* buffer = NULL;
     intptr_t size = 0;
     ReadFile(load_type_feedback_filename, &buffer, &size);
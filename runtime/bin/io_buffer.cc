@@ -4,6 +4,11 @@
 
 #include "bin/io_buffer.h"
 
+#include <new>  // NOLINT
+
+#include "bin/lockers.h"
+#include "bin/thread.h"
+
 namespace dart {
 namespace bin {
 
@@ -29,5 +34,123 @@ uint8_t* IOBuffer::Allocate(intptr_t size) {
   return reinterpret_cast<uint8_t*>(malloc(size));
 }
 
+uint8_t* IOBuffer::Reallocate(uint8_t* buffer, intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(buffer, new_size));
+}
+
+Mutex* IOBufferPool::mutex_ = new Mutex();
+uint8_t* IOBufferPool::free_list_ = NULL;
+intptr_t IOBufferPool::free_count_ = 0;
+
+uint8_t* IOBufferPool::Allocate() {
+  {
+    MutexLocker ml(mutex_);
+    if (free_list_ != NULL) {
+      // Unused buffers are linked through their first word.
+      uint8_t* buffer = free_list_;
+      free_list_ = *reinterpret_cast<uint8_t**>(buffer);
+      free_count_--;
+      return buffer;
+    }
+  }
+  return IOBuffer::Allocate(kBufferSize);
+}
+
+void IOBufferPool::Free(uint8_t* buffer) {
+  {
+    MutexLocker ml(mutex_);
+    if (free_count_ < kMaxPooledBuffers) {
+      *reinterpret_cast<uint8_t**>(buffer) = free_list_;
+      free_list_ = buffer;
+      free_count_++;
+      return;
+    }
+  }
+  IOBuffer::Free(buffer);
+}
+
+Dart_Handle IOBufferPool::Wrap(uint8_t* buffer, intptr_t length) {
+  ASSERT(length <= kBufferSize);
+  if (length < kMinWrapLength) {
+    // Copy short reads out, so the pooled buffer is not held for the lifetime
+    // of a small Uint8List that the GC does not count as 64KB.
+    uint8_t* data = IOBuffer::Allocate(length);
+    if (data != NULL) {
+      memmove(data, buffer, length);
+    }
+    Free(buffer);
+    if (data == NULL) {
+      return Dart_Null();
+    }
+    Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+        Dart_TypedData_kUint8, data, length, data, length,
+        IOBuffer::Finalizer);
+    if (Dart_IsError(result)) {
+      IOBuffer::Free(data);
+      Dart_PropagateError(result);
+    }
+    return result;
+  }
+  // The whole pooled buffer stays allocated until the Uint8List is finalized,
+  // so report all of it to the GC.
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, buffer, length, buffer, kBufferSize,
+      IOBufferPool::Finalizer);
+  if (Dart_IsError(result)) {
+    Free(buffer);
+    Dart_PropagateError(result);
+  }
+  return result;
+}
+
+Dart_Handle DirectBuffer::Allocate(intptr_t length) {
+  uint8_t* memory = IOBuffer::Allocate(sizeof(DirectBuffer) + length);
+  if (memory == NULL) {
+    return Dart_Null();
+  }
+  DirectBuffer* buffer = new (memory) DirectBuffer(length);
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, buffer->data(), length, buffer, length,
+      DirectBuffer::Finalizer);
+  if (Dart_IsError(result)) {
+    buffer->Release();
+    Dart_PropagateError(result);
+  }
+  // The finalizer peer cannot be read back, so the buffer is also stored as
+  // the peer of the Uint8List.
+  Dart_Handle peer_result = Dart_SetPeer(result, buffer);
+  if (Dart_IsError(peer_result)) {
+    Dart_PropagateError(peer_result);
+  }
+  return result;
+}
+
+DirectBuffer* DirectBuffer::Get(Dart_Handle object) {
+  if (Dart_GetTypeOfExternalTypedData(object) != Dart_TypedData_kUint8) {
+    return NULL;
+  }
+  void* peer = NULL;
+  if (Dart_IsError(Dart_GetPeer(object, &peer)) || (peer == NULL)) {
+    return NULL;
+  }
+  // Other code may set a peer on an external Uint8List too, so check that
+  // the data follows the peer, without reading the peer.
+  Dart_TypedData_Type type;
+  void* data = NULL;
+  intptr_t length = 0;
+  Dart_Handle result =
+      Dart_TypedDataAcquireData(object, &type, &data, &length);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  Dart_TypedDataReleaseData(object);
+  DirectBuffer* buffer = reinterpret_cast<DirectBuffer*>(peer);
+  if (data != reinterpret_cast<void*>(buffer + 1)) {
+    return NULL;
+  }
+  buffer->Retain();
+  return buffer;
+}
+
 }  // namespace bin
 }  // namespace dart
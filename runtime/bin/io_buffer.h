@@ -5,12 +5,15 @@
 #ifndef RUNTIME_BIN_IO_BUFFER_H_
 #define RUNTIME_BIN_IO_BUFFER_H_
 
+#include "bin/reference_counting.h"
 #include "include/dart_api.h"
 #include "platform/globals.h"
 
 namespace dart {
 namespace bin {
 
+class Mutex;
+
 class IOBuffer {
  public:
   // Allocate an IO buffer dart object (of type Uint8List) backed by
@@ -20,6 +23,9 @@ class IOBuffer {
   // Allocate IO buffer storage.
   static uint8_t* Allocate(intptr_t size);
 
+  // Grow or shrink IO buffer storage, like realloc.
+  static uint8_t* Reallocate(uint8_t* buffer, intptr_t new_size);
+
   // Function for disposing of IO buffer storage. All backing storage
   // for IO buffers must be freed using this function.
   static void Free(void* buffer) { free(buffer); }
@@ -36,6 +42,87 @@ class IOBuffer {
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
 };
 
+// A pool of fixed size receive buffers shared by all isolates. Socket reads
+// that fit into one are read directly into a pooled buffer. Large reads give
+// that buffer to Dart as external typed data, and it returns to the pool when
+// that is finalized. Short reads are copied out of it.
+class IOBufferPool {
+ public:
+  static const intptr_t kBufferSize = 64 * KB;
+
+  // Get a buffer of kBufferSize bytes.
+  static uint8_t* Allocate();
+
+  // Return a buffer to the pool.
+  static void Free(uint8_t* buffer);
+
+  // Allocate a Uint8List dart object holding the first [length] bytes of
+  // [buffer]. Short reads are copied into a buffer of their own and [buffer]
+  // goes back to the pool right away. Otherwise the object is backed by
+  // [buffer], which goes back to the pool when the object is finalized.
+  // Returns null if the memory for a copy cannot be allocated.
+  static Dart_Handle Wrap(uint8_t* buffer, intptr_t length);
+
+ private:
+  // Reads shorter than this are copied instead of wrapped, so a Uint8List
+  // never pins a pooled buffer more than twice its size.
+  static const intptr_t kMinWrapLength = kBufferSize / 2;
+
+  // The number of unused buffers kept for reuse.
+  static const intptr_t kMaxPooledBuffers = 16;
+
+  static void Finalizer(void* isolate_callback_data,
+                        Dart_WeakPersistentHandle handle,
+                        void* buffer) {
+    Free(reinterpret_cast<uint8_t*>(buffer));
+  }
+
+  static Mutex* mutex_;
+  static uint8_t* free_list_;
+  static intptr_t free_count_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOBufferPool);
+};
+
+// A buffer given to Dart as an external Uint8List, which IO service requests
+// read into and write from directly instead of copying the data through a
+// CObject. Both the Uint8List and the requests in flight hold a reference, so
+// the memory stays allocated until the requests complete even if the
+// Uint8List is finalized first, e.g. when the isolate shuts down.
+class DirectBuffer : public ReferenceCounted<DirectBuffer> {
+ public:
+  // Allocate a Uint8List dart object of [length] bytes backed by a new
+  // DirectBuffer. Returns null if the memory cannot be allocated.
+  static Dart_Handle Allocate(intptr_t length);
+
+  // Returns the DirectBuffer backing [object] with a new reference, or NULL
+  // if [object] is not a Uint8List from Allocate.
+  static DirectBuffer* Get(Dart_Handle object);
+
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+  intptr_t length() const { return length_; }
+
+  // The data follows the buffer in the same allocation.
+  void operator delete(void* pointer) { IOBuffer::Free(pointer); }
+
+ private:
+  explicit DirectBuffer(intptr_t length)
+      : ReferenceCounted(), length_(length) {}
+  ~DirectBuffer() {}
+
+  static void Finalizer(void* isolate_callback_data,
+                        Dart_WeakPersistentHandle handle,
+                        void* buffer) {
+    reinterpret_cast<DirectBuffer*>(buffer)->Release();
+  }
+
+  const intptr_t length_;
+
+  friend class ReferenceCounted<DirectBuffer>;
+  DISALLOW_COPY_AND_ASSIGN(DirectBuffer);
+};
+
 }  // namespace bin
 }  // namespace dart
 
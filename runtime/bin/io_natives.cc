@@ -35,6 +35,7 @@ namespace bin {
   V(Directory_SystemTemp, 1)                                                   \
   V(EventHandler_SendData, 3)                                                  \
   V(EventHandler_TimerMillisecondClock, 0)                                     \
+  V(File_AllocateBuffer, 1)                                                    \
   V(File_AreIdentical, 3)                                                      \
   V(File_Close, 1)                                                             \
   V(File_Copy, 3)                                                              \
@@ -44,6 +45,7 @@ namespace bin {
   V(File_DeleteLink, 2)                                                        \
   V(File_Exists, 2)                                                            \
   V(File_Flush, 1)                                                             \
+  V(File_GetBufferPointers, 2)                                                 \
   V(File_GetPointer, 1)                                                        \
   V(File_GetStdioHandleType, 1)                                                \
   V(File_GetType, 3)                                                           \
@@ -135,6 +137,7 @@ namespace bin {
   V(Socket_CreateBindConnect, 4)                                               \
   V(Socket_CreateBindDatagram, 6)                                              \
   V(Socket_CreateConnect, 3)                                                   \
+  V(Socket_GetPointer, 1)                                                      \
   V(Socket_GetPort, 1)                                                         \
   V(Socket_GetRemotePeer, 1)                                                   \
   V(Socket_GetError, 1)                                                        \
@@ -146,12 +149,17 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
+  V(Socket_ReadInto, 4)                                                        \
   V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_RecvMultiple, 3)                                                    \
   V(Socket_SendTo, 6)                                                          \
+  V(Socket_SendToMultiple, 5)                                                  \
+  V(Socket_SetDispatchPort, 3)                                                 \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteListV, 3)                                                      \
   V(Stdin_ReadByte, 1)                                                         \
   V(Stdin_GetEchoMode, 1)                                                      \
   V(Stdin_SetEchoMode, 2)                                                      \
@@ -0,0 +1,64 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_RING_H_
+#define RUNTIME_BIN_IO_RING_H_
+
+#include "bin/builtin.h"
+#include "bin/dartutils.h"
+#include "platform/allocation.h"
+#include "platform/globals.h"
+
+// The ring needs the io_uring kernel headers, which older sysroots lack.
+#if defined(HOST_OS_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define DART_IO_RING_SUPPORTED
+#endif
+#endif
+
+namespace dart {
+namespace bin {
+
+// Completes the IO service requests that read, write and get the length of
+// an open file on a kernel submission ring (io_uring on Linux), instead of
+// blocking an IO service thread pool worker in a system call for each of
+// them. Requests are submitted to the kernel in batches and completed on a
+// single ring thread, which posts the replies.
+class IORing : public AllStatic {
+ public:
+  // Submits the request [request_id] with arguments [data] to the ring and
+  // returns true, in which case the reply [message_id, response] is posted to
+  // [reply_port] when the request completes. Returns false if the request is
+  // not one the ring handles, or the ring is unavailable or full, in which
+  // case the caller must handle the request itself.
+  static bool Submit(Dart_Port reply_port,
+                     int32_t message_id,
+                     intptr_t request_id,
+                     const CObjectArray& data);
+
+  // Whether the kernel supports the ring. Requests are left to the thread
+  // pool when it does not.
+  static bool available();
+
+  // Makes the ring stop submitting requests, as when the kernel reports
+  // [error] for it. Requests not yet submitted fail with [error], and later
+  // ones are left to the thread pool. Used by tests of the fallback.
+  static void Fail(int error);
+
+  // Whether requests are submitted to the ring at all. Used by benchmarks to
+  // compare against the thread pool.
+  static bool enabled() { return enabled_; }
+  static void set_enabled(bool enabled) { enabled_ = enabled; }
+
+ private:
+  static bool enabled_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IORing);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_IO_RING_H_
@@ -0,0 +1,619 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_ring.h"
+
+#if defined(DART_IO_RING_SUPPORTED)
+
+#include <errno.h>           // NOLINT
+#include <fcntl.h>           // NOLINT
+#include <linux/io_uring.h>  // NOLINT
+#include <linux/stat.h>      // NOLINT
+#include <sys/mman.h>        // NOLINT
+#include <sys/syscall.h>     // NOLINT
+#include <unistd.h>          // NOLINT
+
+#include "bin/fdutils.h"
+#include "bin/file.h"
+#include "bin/io_buffer.h"
+#include "bin/lockers.h"
+#include "bin/thread.h"
+#include "bin/utils.h"
+#include "platform/atomic.h"
+#include "platform/utils.h"
+
+#if defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service_no_ssl.h"
+#else
+#include "bin/io_service.h"
+#endif
+
+namespace dart {
+namespace bin {
+
+bool IORing::enabled_ = true;
+
+// The number of requests that can be in flight on the ring at a time. When
+// the ring is full, requests are handled by the thread pool.
+static const uint32_t kRingEntries = 256;
+
+// Larger transfers are left to the thread pool, as the ring operations
+// transfer at most this many bytes at a time.
+static const int64_t kMaxTransferSize = 1 * GB;
+
+// How often, in milliseconds, the ring thread polls for the completions of
+// the requests in flight after waiting on the ring failed.
+static const int64_t kFailedPollInterval = 1;
+
+// A request in flight on the ring. It holds a reference to the file until its
+// reply has been posted.
+struct IORingRequest {
+  IORingRequest(Dart_Port reply_port,
+                int32_t message_id,
+                intptr_t request_id,
+                File* file)
+      : reply_port(reply_port),
+        message_id(message_id),
+        request_id(request_id),
+        file(file),
+        buffer(NULL),
+        length(0),
+        done(0),
+        next(NULL) {}
+
+  Dart_Port reply_port;
+  int32_t message_id;
+  intptr_t request_id;
+  File* file;
+  uint8_t* buffer;
+  int64_t length;
+  int64_t done;
+  struct statx stat;
+  // Links the requests failed together when the ring fails.
+  IORingRequest* next;
+};
+
+class Ring {
+ public:
+  // Returns the process wide ring, or NULL if the kernel does not support
+  // the ring operations used.
+  static Ring* Get();
+
+  // Queues an operation for [request] and submits the queued operations.
+  // Returns false if the ring is full or has failed.
+  bool Submit(IORingRequest* request);
+
+  // Stops submitting to the ring after the kernel reported [error]. Requests
+  // not yet submitted fail with [error], and new requests are left to the
+  // thread pool. Requests the kernel already has still complete.
+  void Fail(int error);
+
+ private:
+  Ring(int fd,
+       const struct io_uring_params& params,
+       uint8_t* sq,
+       uint8_t* cq,
+       struct io_uring_sqe* sqes);
+
+  static Ring* Create();
+  static void Run(uword parameter);
+
+  void Prepare(IORingRequest* request);
+  void Flush();
+  void FailUnsubmitted();
+  void Reap();
+  void Complete(IORingRequest* request, int32_t result);
+  void PostReply(IORingRequest* request, Dart_CObject* response);
+
+  static Mutex* mutex_;
+  static bool initialized_;
+  static Ring* ring_;
+
+  const int fd_;
+  const uint32_t entries_;
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t* sq_mask_;
+  uint32_t* sq_array_;
+  struct io_uring_sqe* sqes_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t* cq_mask_;
+  struct io_uring_cqe* cqes_;
+
+  // The state below is guarded by the ring mutex.
+  // Requests submitted and not yet completed.
+  uint32_t in_flight_;
+  // Operations queued and not yet submitted to the kernel.
+  uint32_t unsubmitted_;
+  // Whether a thread is submitting the queued operations. Threads queuing
+  // operations meanwhile leave them to be submitted in the same batch.
+  bool submitting_;
+  // The error the ring failed with, or 0.
+  int error_;
+
+  DISALLOW_COPY_AND_ASSIGN(Ring);
+};
+
+Mutex* Ring::mutex_ = new Mutex();
+bool Ring::initialized_ = false;
+Ring* Ring::ring_ = NULL;
+
+static int IORingSetup(uint32_t entries, struct io_uring_params* params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int IORingEnter(int fd,
+                       uint32_t to_submit,
+                       uint32_t min_complete,
+                       uint32_t flags) {
+  return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL,
+                 0);
+}
+
+Ring::Ring(int fd,
+           const struct io_uring_params& params,
+           uint8_t* sq,
+           uint8_t* cq,
+           struct io_uring_sqe* sqes)
+    : fd_(fd),
+      entries_(params.sq_entries),
+      sq_head_(reinterpret_cast<uint32_t*>(sq + params.sq_off.head)),
+      sq_tail_(reinterpret_cast<uint32_t*>(sq + params.sq_off.tail)),
+      sq_mask_(reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask)),
+      sq_array_(reinterpret_cast<uint32_t*>(sq + params.sq_off.array)),
+      sqes_(sqes),
+      cq_head_(reinterpret_cast<uint32_t*>(cq + params.cq_off.head)),
+      cq_tail_(reinterpret_cast<uint32_t*>(cq + params.cq_off.tail)),
+      cq_mask_(reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask)),
+      cqes_(reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes)),
+      in_flight_(0),
+      unsubmitted_(0),
+      submitting_(false),
+      error_(0) {}
+
+Ring* Ring::Get() {
+  MutexLocker ml(mutex_);
+  if (!initialized_) {
+    ring_ = Create();
+    initialized_ = true;
+  }
+  return ring_;
+}
+
+Ring* Ring::Create() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = IORingSetup(kRingEntries, &params);
+  if (fd < 0) {
+    return NULL;
+  }
+  // Reads and writes use the file position like the thread pool does, which
+  // needs IORING_FEAT_RW_CUR_POS. The kernels with it also support statx.
+  if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+    close(fd);
+    return NULL;
+  }
+  size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  size_t cq_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_size = Utils::Maximum(sq_size, cq_size);
+  }
+  void* sq = mmap(NULL, sq_size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq == MAP_FAILED) {
+    close(fd);
+    return NULL;
+  }
+  void* cq = sq;
+  if (!single_mmap) {
+    cq = mmap(NULL, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+              fd, IORING_OFF_CQ_RING);
+    if (cq == MAP_FAILED) {
+      munmap(sq, sq_size);
+      close(fd);
+      return NULL;
+    }
+  }
+  const size_t sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    if (!single_mmap) {
+      munmap(cq, cq_size);
+    }
+    munmap(sq, sq_size);
+    close(fd);
+    return NULL;
+  }
+  FDUtils::SetCloseOnExec(fd);
+  // The ring and its thread live for the rest of the process.
+  Ring* ring = new Ring(fd, params, reinterpret_cast<uint8_t*>(sq),
+                        reinterpret_cast<uint8_t*>(cq),
+                        reinterpret_cast<struct io_uring_sqe*>(sqes));
+  int result = Thread::Start("dart:io IORing", &Ring::Run,
+                             reinterpret_cast<uword>(ring));
+  if (result != 0) {
+    FATAL1("Failed to start IO ring thread %d", result);
+  }
+  return ring;
+}
+
+bool Ring::Submit(IORingRequest* request) {
+  {
+    MutexLocker ml(mutex_);
+    if ((in_flight_ == entries_) || (error_ != 0)) {
+      return false;
+    }
+    in_flight_++;
+    Prepare(request);
+    if (submitting_) {
+      return true;
+    }
+    submitting_ = true;
+  }
+  Flush();
+  return true;
+}
+
+void Ring::Prepare(IORingRequest* request) {
+  // Each request in flight has at most one operation queued, so the
+  // submission queue has room.
+  const uint32_t tail = *sq_tail_;
+  const uint32_t index = tail & *sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->fd = request->file->GetFD();
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+  switch (request->request_id) {
+    case IOService::kFileReadRequest:
+    case IOService::kFileReadIntoRequest:
+      sqe->opcode = IORING_OP_READ;
+      sqe->addr = reinterpret_cast<uint64_t>(request->buffer);
+      sqe->len = request->length;
+      // Read from and advance the file position.
+      sqe->off = static_cast<uint64_t>(-1);
+      break;
+    case IOService::kFileWriteFromRequest:
+      sqe->opcode = IORING_OP_WRITE;
+      sqe->addr = reinterpret_cast<uint64_t>(request->buffer + request->done);
+      sqe->len = request->length - request->done;
+      sqe->off = static_cast<uint64_t>(-1);
+      break;
+    case IOService::kFileLengthRequest:
+      sqe->opcode = IORING_OP_STATX;
+      sqe->addr = reinterpret_cast<uint64_t>("");
+      sqe->len = STATX_SIZE;
+      sqe->off = reinterpret_cast<uint64_t>(&request->stat);
+      sqe->statx_flags = AT_EMPTY_PATH;
+      break;
+    default:
+      UNREACHABLE();
+  }
+  sq_array_[index] = index;
+  AtomicOperations::StoreRelease(sq_tail_, tail + 1);
+  unsubmitted_++;
+}
+
+void Ring::Flush() {
+  while (true) {
+    uint32_t to_submit;
+    {
+      MutexLocker ml(mutex_);
+      to_submit = unsubmitted_;
+      if (to_submit == 0) {
+        submitting_ = false;
+        return;
+      }
+      if (error_ != 0) {
+        break;
+      }
+    }
+    int result = IORingEnter(fd_, to_submit, 0, 0);
+    if (result < 0) {
+      const int error = errno;
+      if ((error != EINTR) && (error != EAGAIN) && (error != EBUSY)) {
+        Fail(error);
+      }
+      continue;
+    }
+    MutexLocker ml(mutex_);
+    unsubmitted_ -= result;
+  }
+  FailUnsubmitted();
+}
+
+void Ring::Fail(int error) {
+  MutexLocker ml(mutex_);
+  if (error_ == 0) {
+    error_ = error;
+  }
+}
+
+void Ring::FailUnsubmitted() {
+  // Only the submitting thread gets here, so the kernel is not consuming the
+  // queue meanwhile and the operations it has not consumed can be taken back.
+  IORingRequest* failed = NULL;
+  int error;
+  {
+    MutexLocker ml(mutex_);
+    const uint32_t head = AtomicOperations::LoadAcquire(sq_head_);
+    uint32_t tail = *sq_tail_;
+    while (tail != head) {
+      tail--;
+      struct io_uring_sqe* sqe = &sqes_[sq_array_[tail & *sq_mask_]];
+      IORingRequest* request = reinterpret_cast<IORingRequest*>(sqe->user_data);
+      request->next = failed;
+      failed = request;
+    }
+    AtomicOperations::StoreRelease(sq_tail_, head);
+    unsubmitted_ = 0;
+    submitting_ = false;
+    error = error_;
+  }
+  while (failed != NULL) {
+    IORingRequest* next = failed->next;
+    Complete(failed, -error);
+    failed = next;
+  }
+}
+
+void Ring::Run(uword parameter) {
+  Ring* ring = reinterpret_cast<Ring*>(parameter);
+  while (true) {
+    int result = IORingEnter(ring->fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    if ((result < 0) && (errno != EINTR)) {
+      ring->Fail(errno);
+      break;
+    }
+    ring->Reap();
+  }
+  // The kernel still posts the completions of the requests it has, so poll
+  // for them until none are left.
+  while (true) {
+    ring->Reap();
+    {
+      MutexLocker ml(mutex_);
+      if (ring->in_flight_ == 0) {
+        return;
+      }
+    }
+    TimerUtils::Sleep(kFailedPollInterval);
+  }
+}
+
+void Ring::Reap() {
+  uint32_t head = *cq_head_;
+  const uint32_t tail = AtomicOperations::LoadAcquire(cq_tail_);
+  while (head != tail) {
+    struct io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+    IORingRequest* request = reinterpret_cast<IORingRequest*>(cqe->user_data);
+    const int32_t result = cqe->res;
+    head++;
+    AtomicOperations::StoreRelease(cq_head_, head);
+    Complete(request, result);
+  }
+}
+
+void Ring::PostReply(IORingRequest* request, Dart_CObject* response) {
+  Dart_CObject message_id;
+  message_id.type = Dart_CObject_kInt32;
+  message_id.value.as_int32 = request->message_id;
+  Dart_CObject* values[2] = {&message_id, response};
+  Dart_CObject message;
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.length = 2;
+  message.value.as_array.values = values;
+  Dart_PostCObject(request->reply_port, &message);
+}
+
+void Ring::Complete(IORingRequest* request, int32_t result) {
+  const intptr_t request_id = request->request_id;
+  if ((result >= 0) && (request_id == IOService::kFileWriteFromRequest)) {
+    request->done += result;
+    if (request->done < request->length) {
+      // Write the rest, like File::WriteFully. The request keeps its place.
+      bool flush = false;
+      {
+        MutexLocker ml(mutex_);
+        if (error_ == 0) {
+          Prepare(request);
+          flush = !submitting_;
+          submitting_ = true;
+        } else {
+          result = -error_;
+        }
+      }
+      if (result >= 0) {
+        if (flush) {
+          Flush();
+        }
+        return;
+      }
+    }
+  }
+
+  Dart_CObject response;
+  if (result < 0) {
+    // Replies like CObject::NewOSError.
+    OSError os_error;
+    os_error.SetCodeAndMessage(OSError::kSystem, -result);
+    Dart_CObject error_values[3];
+    error_values[0].type = Dart_CObject_kInt32;
+    error_values[0].value.as_int32 = CObject::kOSError;
+    error_values[1].type = Dart_CObject_kInt32;
+    error_values[1].value.as_int32 = os_error.code();
+    error_values[2].type = Dart_CObject_kString;
+    error_values[2].value.as_string = os_error.message();
+    Dart_CObject* error[3] = {&error_values[0], &error_values[1],
+                              &error_values[2]};
+    response.type = Dart_CObject_kArray;
+    response.value.as_array.length = 3;
+    response.value.as_array.values = error;
+    PostReply(request, &response);
+  } else if ((request_id == IOService::kFileReadRequest) ||
+             (request_id == IOService::kFileReadIntoRequest)) {
+    // Replies like File::ReadRequest and File::ReadIntoRequest.
+    Dart_CObject success;
+    success.type = Dart_CObject_kInt32;
+    success.value.as_int32 = CObject::kSuccess;
+    Dart_CObject bytes_read;
+    bytes_read.type = Dart_CObject_kInt64;
+    bytes_read.value.as_int64 = result;
+    Dart_CObject data;
+    data.type = Dart_CObject_kExternalTypedData;
+    data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    data.value.as_external_typed_data.length = result;
+    data.value.as_external_typed_data.data = request->buffer;
+    data.value.as_external_typed_data.peer = request->buffer;
+    data.value.as_external_typed_data.callback = IOBuffer::Finalizer;
+    Dart_CObject* values[3] = {&success, &bytes_read, &data};
+    if (request_id == IOService::kFileReadRequest) {
+      values[1] = &data;
+    }
+    response.type = Dart_CObject_kArray;
+    response.value.as_array.length =
+        (request_id == IOService::kFileReadRequest) ? 2 : 3;
+    response.value.as_array.values = values;
+    PostReply(request, &response);
+    // The buffer is now owned by the message, which frees it if the reply is
+    // not delivered.
+    request->buffer = NULL;
+  } else {
+    // Both writes and lengths reply with a single integer.
+    response.type = Dart_CObject_kInt64;
+    response.value.as_int64 = (request_id == IOService::kFileLengthRequest)
+                                  ? request->stat.stx_size
+                                  : request->length;
+    PostReply(request, &response);
+  }
+
+  IOBuffer::Free(request->buffer);
+  request->file->Release();
+  delete request;
+  MutexLocker ml(mutex_);
+  in_flight_--;
+}
+
+static int64_t CObjectToInt64(CObject* cobject) {
+  if (cobject->IsInt32()) {
+    CObjectInt32 value(cobject);
+    return value.Value();
+  }
+  CObjectInt64 value(cobject);
+  return value.Value();
+}
+
+static bool IsByteData(Dart_TypedData_Type type) {
+  return (type == Dart_TypedData_kInt8) || (type == Dart_TypedData_kUint8) ||
+         (type == Dart_TypedData_kUint8Clamped);
+}
+
+// Fills in the buffer for [request] from the arguments in [data], which are
+// checked like the corresponding File request does. Returns false if the
+// request is left to the thread pool, which also reports any errors.
+static bool PrepareRequest(IORingRequest* request, const CObjectArray& data) {
+  switch (request->request_id) {
+    case IOService::kFileReadRequest:
+    case IOService::kFileReadIntoRequest: {
+      if ((data.Length() != 2) || !data[1]->IsInt32OrInt64()) {
+        return false;
+      }
+      const int64_t length = CObjectToInt64(data[1]);
+      if ((length < 0) || (length > kMaxTransferSize)) {
+        return false;
+      }
+      request->length = length;
+      request->buffer = IOBuffer::Allocate(length);
+      return request->buffer != NULL;
+    }
+    case IOService::kFileWriteFromRequest: {
+      if ((data.Length() != 4) || !data[1]->IsTypedData() ||
+          !data[2]->IsInt32OrInt64() || !data[3]->IsInt32OrInt64()) {
+        return false;
+      }
+      // The request data only lives as long as the IO service callback, so
+      // the bytes are copied out. Output to stdout and stderr is left to
+      // File::WriteFully, which also reports it to the service protocol.
+      CObjectTypedData typed_data(data[1]);
+      const int64_t start = CObjectToInt64(data[2]);
+      const int64_t end = CObjectToInt64(data[3]);
+      const intptr_t fd = request->file->GetFD();
+      if (!IsByteData(typed_data.Type()) || (start < 0) || (end < start) ||
+          (end > typed_data.Length()) || (end - start > kMaxTransferSize) ||
+          (fd == STDOUT_FILENO) || (fd == STDERR_FILENO)) {
+        return false;
+      }
+      request->length = end - start;
+      request->buffer = IOBuffer::Allocate(request->length);
+      if (request->buffer == NULL) {
+        return false;
+      }
+      memmove(request->buffer, typed_data.Buffer() + start, request->length);
+      return true;
+    }
+    case IOService::kFileLengthRequest:
+      return data.Length() == 1;
+    default:
+      return false;
+  }
+}
+
+bool IORing::available() {
+  return Ring::Get() != NULL;
+}
+
+void IORing::Fail(int error) {
+  Ring* ring = Ring::Get();
+  if (ring != NULL) {
+    ring->Fail(error);
+  }
+}
+
+bool IORing::Submit(Dart_Port reply_port,
+                    int32_t message_id,
+                    intptr_t request_id,
+                    const CObjectArray& data) {
+  if (!enabled_) {
+    return false;
+  }
+  switch (request_id) {
+    case IOService::kFileReadRequest:
+    case IOService::kFileReadIntoRequest:
+    case IOService::kFileWriteFromRequest:
+    case IOService::kFileLengthRequest:
+      break;
+    default:
+      return false;
+  }
+  if ((data.Length() < 1) || !data[0]->IsIntptr()) {
+    return false;
+  }
+  Ring* ring = Ring::Get();
+  if (ring == NULL) {
+    return false;
+  }
+  CObjectIntptr file_pointer(data[0]);
+  File* file = reinterpret_cast<File*>(file_pointer.Value());
+  if (file->IsClosed()) {
+    return false;
+  }
+  IORingRequest* request =
+      new IORingRequest(reply_port, message_id, request_id, file);
+  if (!PrepareRequest(request, data) || !ring->Submit(request)) {
+    IOBuffer::Free(request->buffer);
+    delete request;
+    return false;
+  }
+  // The reference to the file passed with the request is released when the
+  // request completes.
+  return true;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_IO_RING_SUPPORTED)
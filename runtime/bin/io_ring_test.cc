@@ -0,0 +1,738 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_ring.h"
+
+#include <errno.h>   // NOLINT
+#include <fcntl.h>   // NOLINT
+#include <unistd.h>  // NOLINT
+
+#include "bin/directory.h"
+#include "bin/file.h"
+#include "bin/io_buffer.h"
+#include "bin/lockers.h"
+#include "bin/thread.h"
+#include "include/dart_native_api.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/benchmark_test.h"
+#include "vm/timer.h"
+#include "vm/unit_test.h"
+
+#if defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service_no_ssl.h"
+#else
+#include "bin/io_service.h"
+#endif
+
+namespace dart {
+
+static const intptr_t kBenchmarkFileSize = 16 * MB;
+static const intptr_t kRandomReadSize = 4 * KB;
+static const intptr_t kRandomReads = 20000;
+static const intptr_t kCopyChunkSize = 64 * KB;
+static const intptr_t kMaxBenchmarkFiles = 8;
+static const int64_t kLargeFileSize = static_cast<int64_t>(4) * GB;
+static const intptr_t kReadChunkSize = 16 * MB;
+
+// Drives the IO service from a native reply port the way dart:io drives it
+// from Dart: each file has one request in flight at a time, and the message
+// id of a request is the index of its file.
+struct IOServiceBenchmark {
+  bin::Monitor* monitor;
+  Dart_Port service_port;
+  Dart_Port reply_port;
+  bin::File* files[kMaxBenchmarkFiles];
+  // Random reads: whether a read, rather than setting the position, is in
+  // flight for each file, and the number of reads left to start.
+  bool reading[kMaxBenchmarkFiles];
+  intptr_t reads_left;
+  uint32_t random;
+  // Sequential copy from files[0] to files[1], or sequential reads of
+  // files[0] into a DirectBuffer or, copying the data out of the reply, into
+  // read_buffer.
+  int64_t copied;
+  bin::DirectBuffer* direct_buffer;
+  uint8_t* read_buffer;
+  // The number of files with a request in flight.
+  intptr_t active;
+};
+
+static IOServiceBenchmark io_benchmark;
+
+static void PostFileRequest(intptr_t index,
+                            intptr_t request_id,
+                            Dart_CObject** arguments,
+                            intptr_t argument_count) {
+  bin::File* file = io_benchmark.files[index];
+  // The IO service releases the reference, as for requests from dart:io.
+  file->Retain();
+  Dart_CObject file_pointer;
+  file_pointer.type = Dart_CObject_kInt64;
+  file_pointer.value.as_int64 = reinterpret_cast<intptr_t>(file);
+  Dart_CObject* data_values[5] = {&file_pointer};
+  for (intptr_t i = 0; i < argument_count; i++) {
+    data_values[i + 1] = arguments[i];
+  }
+  Dart_CObject data;
+  data.type = Dart_CObject_kArray;
+  data.value.as_array.length = argument_count + 1;
+  data.value.as_array.values = data_values;
+  Dart_CObject message_id;
+  message_id.type = Dart_CObject_kInt32;
+  message_id.value.as_int32 = index;
+  Dart_CObject reply_port;
+  reply_port.type = Dart_CObject_kSendPort;
+  reply_port.value.as_send_port.id = io_benchmark.reply_port;
+  reply_port.value.as_send_port.origin_id = ILLEGAL_PORT;
+  Dart_CObject request;
+  request.type = Dart_CObject_kInt32;
+  request.value.as_int32 = request_id;
+  Dart_CObject* values[4] = {&message_id, &reply_port, &request, &data};
+  Dart_CObject message;
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.length = 4;
+  message.value.as_array.values = values;
+  EXPECT(Dart_PostCObject(io_benchmark.service_port, &message));
+}
+
+// Integers that fit arrive as kInt32, whatever type they were posted as.
+static bool IsInteger(Dart_CObject* object) {
+  return (object->type == Dart_CObject_kInt32) ||
+         (object->type == Dart_CObject_kInt64);
+}
+
+static int64_t IntegerValue(Dart_CObject* object) {
+  return (object->type == Dart_CObject_kInt32) ? object->value.as_int32
+                                               : object->value.as_int64;
+}
+
+static void PostRandomSetPosition(intptr_t index) {
+  io_benchmark.random = io_benchmark.random * 1103515245 + 12345;
+  Dart_CObject position;
+  position.type = Dart_CObject_kInt64;
+  position.value.as_int64 =
+      ((io_benchmark.random >> 8) % (kBenchmarkFileSize / kRandomReadSize)) *
+      kRandomReadSize;
+  Dart_CObject* arguments[1] = {&position};
+  PostFileRequest(index, bin::IOService::kFileSetPositionRequest, arguments,
+                  1);
+}
+
+static void PostRead(intptr_t index, intptr_t length) {
+  Dart_CObject read_length;
+  read_length.type = Dart_CObject_kInt64;
+  read_length.value.as_int64 = length;
+  Dart_CObject* arguments[1] = {&read_length};
+  PostFileRequest(index, bin::IOService::kFileReadRequest, arguments, 1);
+}
+
+// Finishes the request in flight for a file, and wakes up the benchmark when
+// it was the last one.
+static void FinishFile(bin::MonitorLocker* ml) {
+  io_benchmark.active--;
+  if (io_benchmark.active == 0) {
+    ml->Notify();
+  }
+}
+
+static void RandomReadReply(Dart_Port dest_port_id, Dart_CObject* message) {
+  intptr_t index = message->value.as_array.values[0]->value.as_int32;
+  Dart_CObject* response = message->value.as_array.values[1];
+  bin::MonitorLocker ml(io_benchmark.monitor);
+  if (!io_benchmark.reading[index]) {
+    EXPECT_EQ(Dart_CObject_kBool, response->type);
+    io_benchmark.reading[index] = true;
+    PostRead(index, kRandomReadSize);
+    return;
+  }
+  EXPECT_EQ(Dart_CObject_kArray, response->type);
+  EXPECT_EQ(kRandomReadSize,
+            response->value.as_array.values[1]->value.as_typed_data.length);
+  io_benchmark.reading[index] = false;
+  if (io_benchmark.reads_left > 0) {
+    io_benchmark.reads_left--;
+    PostRandomSetPosition(index);
+  } else {
+    FinishFile(&ml);
+  }
+}
+
+static void SequentialCopyReply(Dart_Port dest_port_id,
+                                Dart_CObject* message) {
+  intptr_t index = message->value.as_array.values[0]->value.as_int32;
+  Dart_CObject* response = message->value.as_array.values[1];
+  bin::MonitorLocker ml(io_benchmark.monitor);
+  if (index == 1) {
+    // The chunk is written, read the next one.
+    EXPECT(IsInteger(response));
+    io_benchmark.copied += IntegerValue(response);
+    if (io_benchmark.copied < kBenchmarkFileSize) {
+      PostRead(0, kCopyChunkSize);
+    } else {
+      FinishFile(&ml);
+    }
+    return;
+  }
+  EXPECT_EQ(Dart_CObject_kArray, response->type);
+  Dart_CObject* chunk = response->value.as_array.values[1];
+  EXPECT_EQ(Dart_CObject_kTypedData, chunk->type);
+  Dart_CObject start;
+  start.type = Dart_CObject_kInt64;
+  start.value.as_int64 = 0;
+  Dart_CObject end;
+  end.type = Dart_CObject_kInt64;
+  end.value.as_int64 = chunk->value.as_typed_data.length;
+  Dart_CObject* arguments[3] = {chunk, &start, &end};
+  PostFileRequest(1, bin::IOService::kFileWriteFromRequest, arguments, 3);
+}
+
+// Reads the next chunk of files[0] the way readIntoAt does when given a
+// buffer from allocateBuffer, or the way readInto does.
+static void PostSequentialRead() {
+  Dart_CObject length;
+  length.type = Dart_CObject_kInt64;
+  length.value.as_int64 = kReadChunkSize;
+  if (io_benchmark.direct_buffer == NULL) {
+    Dart_CObject* arguments[1] = {&length};
+    PostFileRequest(0, bin::IOService::kFileReadIntoRequest, arguments, 1);
+    return;
+  }
+  // The request releases the reference, as for readIntoAt.
+  io_benchmark.direct_buffer->Retain();
+  Dart_CObject pointer;
+  pointer.type = Dart_CObject_kInt64;
+  pointer.value.as_int64 =
+      reinterpret_cast<intptr_t>(io_benchmark.direct_buffer);
+  Dart_CObject start;
+  start.type = Dart_CObject_kInt64;
+  start.value.as_int64 = 0;
+  Dart_CObject position;
+  position.type = Dart_CObject_kInt64;
+  position.value.as_int64 = io_benchmark.copied;
+  Dart_CObject* arguments[4] = {&pointer, &start, &length, &position};
+  PostFileRequest(0, bin::IOService::kFileReadAtRequest, arguments, 4);
+}
+
+static void SequentialReadReply(Dart_Port dest_port_id,
+                                Dart_CObject* message) {
+  Dart_CObject* response = message->value.as_array.values[1];
+  bin::MonitorLocker ml(io_benchmark.monitor);
+  int64_t bytes_read;
+  if (io_benchmark.direct_buffer != NULL) {
+    EXPECT(IsInteger(response));
+    bytes_read = IntegerValue(response);
+  } else {
+    EXPECT_EQ(Dart_CObject_kArray, response->type);
+    Dart_CObject* chunk = response->value.as_array.values[2];
+    EXPECT_EQ(Dart_CObject_kTypedData, chunk->type);
+    bytes_read = chunk->value.as_typed_data.length;
+    // readInto copies the data into the list it was given.
+    memmove(io_benchmark.read_buffer, chunk->value.as_typed_data.values,
+            bytes_read);
+  }
+  io_benchmark.copied += bytes_read;
+  if ((bytes_read > 0) && (io_benchmark.copied < kLargeFileSize)) {
+    PostSequentialRead();
+  } else {
+    FinishFile(&ml);
+  }
+}
+
+static uint8_t FileByte(intptr_t index, intptr_t position) {
+  return static_cast<uint8_t>(position * 31 + index);
+}
+
+// Creates a file of [size] bytes in [directory], opened for reading and
+// writing at position 0.
+static bin::File* CreateTestFile(const char* directory,
+                                 intptr_t index,
+                                 intptr_t size) {
+  char path[PATH_MAX];
+  Utils::SNPrint(path, sizeof(path), "%s/file%" Pd, directory, index);
+  bin::File* file = bin::File::Open(NULL, path, bin::File::kWriteTruncate);
+  EXPECT(file != NULL);
+  uint8_t* data = new uint8_t[size];
+  for (intptr_t i = 0; i < size; i++) {
+    data[i] = FileByte(index, i);
+  }
+  EXPECT(file->WriteFully(data, size));
+  EXPECT(file->SetPosition(0));
+  delete[] data;
+  return file;
+}
+
+static const char* CreateTestDirectory() {
+  char prefix[PATH_MAX];
+  Utils::SNPrint(prefix, sizeof(prefix), "%s/io_ring_test",
+                 bin::Directory::SystemTemp(NULL));
+  const char* directory = bin::Directory::CreateTemp(NULL, prefix);
+  EXPECT(directory != NULL);
+  return directory;
+}
+
+// Runs requests on [file_count] files through the IO service, with the ring
+// enabled or not, and returns the time taken. [start] posts the first
+// requests, and [handler] the rest as the replies come in.
+static int64_t RunIOServiceBenchmark(bool use_ring,
+                                     intptr_t file_count,
+                                     Dart_NativeMessageHandler handler,
+                                     void (*start)()) {
+  Dart_EnterScope();
+  const char* directory = CreateTestDirectory();
+  memset(&io_benchmark, 0, sizeof(io_benchmark));
+  io_benchmark.monitor = new bin::Monitor();
+  io_benchmark.service_port = bin::IOService::GetServicePort();
+  io_benchmark.reply_port = Dart_NewNativePort("IORingBenchmark", handler,
+                                               false);
+  for (intptr_t i = 0; i < file_count; i++) {
+    io_benchmark.files[i] = CreateTestFile(directory, i, kBenchmarkFileSize);
+  }
+  io_benchmark.reads_left = kRandomReads - file_count;
+  const bool enabled = bin::IORing::enabled();
+  bin::IORing::set_enabled(use_ring);
+
+  Timer timer(true, "IO service benchmark");
+  timer.Start();
+  {
+    bin::MonitorLocker ml(io_benchmark.monitor);
+    start();
+    while (io_benchmark.active > 0) {
+      ml.Wait();
+    }
+  }
+  timer.Stop();
+
+  bin::IORing::set_enabled(enabled);
+  Dart_CloseNativePort(io_benchmark.reply_port);
+  Dart_CloseNativePort(io_benchmark.service_port);
+  for (intptr_t i = 0; i < file_count; i++) {
+    io_benchmark.files[i]->Release();
+  }
+  delete io_benchmark.monitor;
+  EXPECT(bin::Directory::Delete(NULL, directory, true));
+  Dart_ExitScope();
+  return timer.TotalElapsedTime();
+}
+
+static void StartRandomReads() {
+  io_benchmark.active = kMaxBenchmarkFiles;
+  for (intptr_t i = 0; i < kMaxBenchmarkFiles; i++) {
+    PostRandomSetPosition(i);
+  }
+}
+
+static int64_t RandomReads(bool use_ring) {
+  return RunIOServiceBenchmark(use_ring, kMaxBenchmarkFiles, RandomReadReply,
+                               StartRandomReads);
+}
+
+// Copies the first file over the second one.
+static void StartSequentialCopy() {
+  io_benchmark.active = 1;
+  PostRead(0, kCopyChunkSize);
+}
+
+static int64_t SequentialCopy(bool use_ring) {
+  return RunIOServiceBenchmark(use_ring, 2, SequentialCopyReply,
+                               StartSequentialCopy);
+}
+
+// Reads a file of kLargeFileSize bytes from start to end on the thread pool,
+// with readIntoAt into a DirectBuffer if [direct] is set and with readInto
+// otherwise, and returns the time taken. The file is sparse, so this measures
+// the IO service and the copies rather than the disk.
+static int64_t SequentialReadInto(bool direct) {
+  Dart_EnterScope();
+  const char* directory = CreateTestDirectory();
+  memset(&io_benchmark, 0, sizeof(io_benchmark));
+  io_benchmark.monitor = new bin::Monitor();
+  io_benchmark.service_port = bin::IOService::GetServicePort();
+  io_benchmark.reply_port =
+      Dart_NewNativePort("IORingBenchmark", SequentialReadReply, false);
+  char path[PATH_MAX];
+  Utils::SNPrint(path, sizeof(path), "%s/large", directory);
+  bin::File* file = bin::File::Open(NULL, path, bin::File::kWriteTruncate);
+  EXPECT(file != NULL);
+  EXPECT(file->Truncate(kLargeFileSize));
+  io_benchmark.files[0] = file;
+  if (direct) {
+    Dart_Handle buffer = bin::DirectBuffer::Allocate(kReadChunkSize);
+    EXPECT(!Dart_IsNull(buffer));
+    io_benchmark.direct_buffer = bin::DirectBuffer::Get(buffer);
+  } else {
+    io_benchmark.read_buffer = new uint8_t[kReadChunkSize];
+  }
+  const bool enabled = bin::IORing::enabled();
+  bin::IORing::set_enabled(false);
+
+  Timer timer(true, "IO service sequential read benchmark");
+  timer.Start();
+  {
+    bin::MonitorLocker ml(io_benchmark.monitor);
+    io_benchmark.active = 1;
+    PostSequentialRead();
+    while (io_benchmark.active > 0) {
+      ml.Wait();
+    }
+  }
+  timer.Stop();
+  EXPECT_EQ(kLargeFileSize, io_benchmark.copied);
+
+  bin::IORing::set_enabled(enabled);
+  Dart_CloseNativePort(io_benchmark.reply_port);
+  Dart_CloseNativePort(io_benchmark.service_port);
+  if (direct) {
+    io_benchmark.direct_buffer->Release();
+  } else {
+    delete[] io_benchmark.read_buffer;
+  }
+  file->Release();
+  delete io_benchmark.monitor;
+  EXPECT(bin::Directory::Delete(NULL, directory, true));
+  Dart_ExitScope();
+  return timer.TotalElapsedTime();
+}
+
+static const intptr_t kTestFileSize = 10000;
+static const intptr_t kMaxErrorMessage = 256;
+
+// A reply of the IO service, copied out of the message.
+struct IOServiceReply {
+  // The type of the reply, with kInt64 for any integer.
+  Dart_CObject_Type type;
+  // The value of an integer or boolean reply.
+  int64_t value;
+  // For an array reply, its length, the status in its first element and the
+  // integer, string and data that follow: the OS error code and message, or
+  // the number of bytes read and the data.
+  intptr_t length;
+  int32_t status;
+  int64_t error_code;
+  char error_message[kMaxErrorMessage];
+  intptr_t data_length;
+  uint8_t data[kTestFileSize];
+};
+
+static IOServiceReply io_reply;
+static bool io_reply_received = false;
+
+static void CopyReply(Dart_Port dest_port_id, Dart_CObject* message) {
+  Dart_CObject* response = message->value.as_array.values[1];
+  bin::MonitorLocker ml(io_benchmark.monitor);
+  memset(&io_reply, 0, sizeof(io_reply));
+  io_reply.type = response->type;
+  io_reply.data_length = -1;
+  if (IsInteger(response)) {
+    io_reply.type = Dart_CObject_kInt64;
+    io_reply.value = IntegerValue(response);
+  } else if (response->type == Dart_CObject_kBool) {
+    io_reply.value = response->value.as_bool ? 1 : 0;
+  } else if (response->type == Dart_CObject_kArray) {
+    io_reply.length = response->value.as_array.length;
+    Dart_CObject** values = response->value.as_array.values;
+    EXPECT_EQ(Dart_CObject_kInt32, values[0]->type);
+    io_reply.status = values[0]->value.as_int32;
+    for (intptr_t i = 1; i < io_reply.length; i++) {
+      Dart_CObject* value = values[i];
+      if (value->type == Dart_CObject_kTypedData) {
+        io_reply.data_length = value->value.as_typed_data.length;
+        EXPECT(io_reply.data_length <= kTestFileSize);
+        memmove(io_reply.data, value->value.as_typed_data.values,
+                Utils::Minimum(io_reply.data_length, kTestFileSize));
+      } else if (value->type == Dart_CObject_kString) {
+        strncpy(io_reply.error_message, value->value.as_string,
+                kMaxErrorMessage - 1);
+      } else if (IsInteger(value) && (i == 1)) {
+        io_reply.error_code = IntegerValue(value);
+      }
+    }
+  }
+  io_reply_received = true;
+  ml.Notify();
+}
+
+static const char* StartIOServiceTest() {
+  Dart_EnterScope();
+  memset(&io_benchmark, 0, sizeof(io_benchmark));
+  io_benchmark.monitor = new bin::Monitor();
+  io_benchmark.service_port = bin::IOService::GetServicePort();
+  io_benchmark.reply_port = Dart_NewNativePort("IORingTest", CopyReply, false);
+  return CreateTestDirectory();
+}
+
+static void StopIOServiceTest(const char* directory) {
+  Dart_CloseNativePort(io_benchmark.reply_port);
+  Dart_CloseNativePort(io_benchmark.service_port);
+  delete io_benchmark.monitor;
+  EXPECT(bin::Directory::Delete(NULL, directory, true));
+  Dart_ExitScope();
+}
+
+// Sends a request for [file] through the IO service, with the ring enabled or
+// not, and copies the reply to [reply].
+static void RunFileRequest(bool use_ring,
+                           bin::File* file,
+                           intptr_t request_id,
+                           Dart_CObject** arguments,
+                           intptr_t argument_count,
+                           IOServiceReply* reply) {
+  const bool enabled = bin::IORing::enabled();
+  bin::IORing::set_enabled(use_ring);
+  io_benchmark.files[0] = file;
+  {
+    bin::MonitorLocker ml(io_benchmark.monitor);
+    io_reply_received = false;
+    PostFileRequest(0, request_id, arguments, argument_count);
+    while (!io_reply_received) {
+      ml.Wait();
+    }
+    memmove(reply, &io_reply, sizeof(io_reply));
+  }
+  bin::IORing::set_enabled(enabled);
+}
+
+static void RunRead(bool use_ring,
+                    bin::File* file,
+                    intptr_t request_id,
+                    int64_t length,
+                    IOServiceReply* reply) {
+  Dart_CObject read_length;
+  read_length.type = Dart_CObject_kInt64;
+  read_length.value.as_int64 = length;
+  Dart_CObject* arguments[1] = {&read_length};
+  RunFileRequest(use_ring, file, request_id, arguments, 1, reply);
+}
+
+static void RunWrite(bool use_ring,
+                     bin::File* file,
+                     uint8_t* data,
+                     intptr_t length,
+                     IOServiceReply* reply) {
+  Dart_CObject bytes;
+  bytes.type = Dart_CObject_kTypedData;
+  bytes.value.as_typed_data.type = Dart_TypedData_kUint8;
+  bytes.value.as_typed_data.length = length;
+  bytes.value.as_typed_data.values = data;
+  Dart_CObject start;
+  start.type = Dart_CObject_kInt64;
+  start.value.as_int64 = 0;
+  Dart_CObject end;
+  end.type = Dart_CObject_kInt64;
+  end.value.as_int64 = length;
+  Dart_CObject* arguments[3] = {&bytes, &start, &end};
+  RunFileRequest(use_ring, file, bin::IOService::kFileWriteFromRequest,
+                 arguments, 3, reply);
+}
+
+static void ExpectSameReply(const IOServiceReply& expected,
+                            const IOServiceReply& actual) {
+  EXPECT_EQ(expected.type, actual.type);
+  EXPECT_EQ(expected.value, actual.value);
+  EXPECT_EQ(expected.length, actual.length);
+  EXPECT_EQ(expected.status, actual.status);
+  EXPECT_EQ(expected.error_code, actual.error_code);
+  EXPECT_STREQ(expected.error_message, actual.error_message);
+  EXPECT_EQ(expected.data_length, actual.data_length);
+  if (expected.data_length == actual.data_length) {
+    EXPECT(memcmp(expected.data, actual.data,
+                  Utils::Maximum<intptr_t>(expected.data_length, 0)) == 0);
+  }
+}
+
+// Reads across the end of a file and at its end, which reply with fewer
+// bytes than requested and with none, the same way on the ring as on the
+// thread pool.
+TEST_CASE(IORing_ReadAtEndOfFile) {
+  const intptr_t kTail = 100;
+  const intptr_t request_ids[2] = {bin::IOService::kFileReadRequest,
+                                   bin::IOService::kFileReadIntoRequest};
+  const char* directory = StartIOServiceTest();
+  for (intptr_t r = 0; r < 2; r++) {
+    IOServiceReply* replies[2][3];
+    for (intptr_t ring = 0; ring < 2; ring++) {
+      bin::File* file = CreateTestFile(directory, 0, kTestFileSize);
+      const int64_t lengths[3] = {kTestFileSize - kTail, 1000, 1000};
+      for (intptr_t i = 0; i < 3; i++) {
+        replies[ring][i] = new IOServiceReply();
+        RunRead(ring == 1, file, request_ids[r], lengths[i],
+                replies[ring][i]);
+      }
+      file->Release();
+    }
+    for (intptr_t ring = 0; ring < 2; ring++) {
+      IOServiceReply* tail = replies[ring][1];
+      EXPECT_EQ(Dart_CObject_kArray, tail->type);
+      EXPECT_EQ(bin::CObject::kSuccess, tail->status);
+      EXPECT_EQ(kTail, tail->data_length);
+      for (intptr_t i = 0; i < kTail; i++) {
+        EXPECT_EQ(FileByte(0, kTestFileSize - kTail + i), tail->data[i]);
+      }
+      EXPECT_EQ(0, replies[ring][2]->data_length);
+    }
+    for (intptr_t i = 0; i < 3; i++) {
+      ExpectSameReply(*replies[0][i], *replies[1][i]);
+      delete replies[0][i];
+      delete replies[1][i];
+    }
+  }
+  StopIOServiceTest(directory);
+}
+
+// A failed read replies with the same OS error on the ring as on the thread
+// pool.
+TEST_CASE(IORing_ErrorReplyMatchesThreadPool) {
+  const char* directory = StartIOServiceTest();
+  // The file is only open for writing, so reading it fails with EBADF.
+  char path[PATH_MAX];
+  Utils::SNPrint(path, sizeof(path), "%s/write_only", directory);
+  bin::File* file = bin::File::Open(NULL, path, bin::File::kWriteOnlyTruncate);
+  EXPECT(file != NULL);
+  IOServiceReply* replies[2];
+  for (intptr_t ring = 0; ring < 2; ring++) {
+    replies[ring] = new IOServiceReply();
+    RunRead(ring == 1, file, bin::IOService::kFileReadRequest, 10,
+            replies[ring]);
+    EXPECT_EQ(Dart_CObject_kArray, replies[ring]->type);
+    EXPECT_EQ(3, replies[ring]->length);
+    EXPECT_EQ(bin::CObject::kOSError, replies[ring]->status);
+    EXPECT_EQ(EBADF, replies[ring]->error_code);
+    EXPECT(strlen(replies[ring]->error_message) > 0);
+  }
+  ExpectSameReply(*replies[0], *replies[1]);
+  delete replies[0];
+  delete replies[1];
+  file->Release();
+  StopIOServiceTest(directory);
+}
+
+struct PipeReader {
+  int fd;
+  intptr_t expected;
+  intptr_t received;
+  bool matches;
+  bool done;
+  bin::Monitor* monitor;
+};
+
+// Drains the pipe a little at a time, so the writer only finds room for part
+// of its data.
+static void ReadPipe(uword parameter) {
+  PipeReader* reader = reinterpret_cast<PipeReader*>(parameter);
+  uint8_t buffer[512];
+  while (reader->received < reader->expected) {
+    ssize_t result = read(reader->fd, buffer, sizeof(buffer));
+    if (result <= 0) {
+      if ((result < 0) && (errno == EINTR)) {
+        continue;
+      }
+      break;
+    }
+    for (ssize_t i = 0; i < result; i++) {
+      if (buffer[i] != FileByte(0, reader->received + i)) {
+        reader->matches = false;
+      }
+    }
+    reader->received += result;
+  }
+  bin::MonitorLocker ml(reader->monitor);
+  reader->done = true;
+  ml.Notify();
+}
+
+// Writes more than a pipe holds, which the kernel may complete in parts.
+// The ring writes the rest like File::WriteFully before replying.
+TEST_CASE(IORing_WriteMoreThanPipeHolds) {
+  const intptr_t kLength = 256 * KB;
+  const char* directory = StartIOServiceTest();
+  uint8_t* data = new uint8_t[kLength];
+  for (intptr_t i = 0; i < kLength; i++) {
+    data[i] = FileByte(0, i);
+  }
+  for (intptr_t ring = 0; ring < 2; ring++) {
+    int fds[2];
+    EXPECT_EQ(0, pipe(fds));
+    fcntl(fds[1], F_SETPIPE_SZ, 4 * KB);
+    bin::File* file = bin::File::OpenStdio(fds[1]);
+    bin::Monitor monitor;
+    PipeReader reader = {fds[0], kLength, 0, true, false, &monitor};
+    EXPECT_EQ(0, bin::Thread::Start("IORingTest pipe reader", ReadPipe,
+                                    reinterpret_cast<uword>(&reader)));
+    IOServiceReply* reply = new IOServiceReply();
+    RunWrite(ring == 1, file, data, kLength, reply);
+    EXPECT_EQ(Dart_CObject_kInt64, reply->type);
+    EXPECT_EQ(kLength, reply->value);
+    // Closing the pipe ends the reader even if data is missing.
+    file->Release();
+    {
+      bin::MonitorLocker ml(&monitor);
+      while (!reader.done) {
+        ml.Wait();
+      }
+    }
+    EXPECT_EQ(kLength, reader.received);
+    EXPECT(reader.matches);
+    delete reply;
+    close(fds[0]);
+  }
+  delete[] data;
+  StopIOServiceTest(directory);
+}
+
+// Once the ring fails, or when the kernel does not support it, requests are
+// still answered by the thread pool. The ring stays failed for the rest of
+// the process.
+TEST_CASE(IORing_FallBackToThreadPool) {
+  const char* directory = StartIOServiceTest();
+  bin::File* file = CreateTestFile(directory, 0, kTestFileSize);
+  IOServiceReply* reply = new IOServiceReply();
+  RunRead(true, file, bin::IOService::kFileReadRequest, 10, reply);
+  EXPECT_EQ(10, reply->data_length);
+
+  bin::IORing::Fail(EIO);
+  RunRead(true, file, bin::IOService::kFileReadRequest, 10, reply);
+  EXPECT_EQ(Dart_CObject_kArray, reply->type);
+  EXPECT_EQ(bin::CObject::kSuccess, reply->status);
+  EXPECT_EQ(10, reply->data_length);
+  for (intptr_t i = 0; i < 10; i++) {
+    EXPECT_EQ(FileByte(0, 10 + i), reply->data[i]);
+  }
+  uint8_t data[10] = {0};
+  RunWrite(true, file, data, 10, reply);
+  EXPECT_EQ(Dart_CObject_kInt64, reply->type);
+  EXPECT_EQ(10, reply->value);
+  RunFileRequest(true, file, bin::IOService::kFileLengthRequest, NULL, 0,
+                 reply);
+  EXPECT_EQ(Dart_CObject_kInt64, reply->type);
+  EXPECT_EQ(kTestFileSize, reply->value);
+  delete reply;
+  file->Release();
+  StopIOServiceTest(directory);
+}
+
+BENCHMARK(IOServiceRandomReadsThreadPool) {
+  benchmark->set_score(RandomReads(false));
+}
+
+BENCHMARK(IOServiceRandomReadsRing) {
+  benchmark->set_score(RandomReads(true));
+}
+
+BENCHMARK(IOServiceSequentialCopyThreadPool) {
+  benchmark->set_score(SequentialCopy(false));
+}
+
+BENCHMARK(IOServiceSequentialCopyRing) {
+  benchmark->set_score(SequentialCopy(true));
+}
+
+BENCHMARK(IOServiceSequentialReadInto) {
+  benchmark->set_score(SequentialReadInto(false));
+}
+
+BENCHMARK(IOServiceSequentialReadIntoAt) {
+  benchmark->set_score(SequentialReadInto(true));
+}
+
+}  // namespace dart
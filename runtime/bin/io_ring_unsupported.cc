@@ -0,0 +1,30 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_ring.h"
+
+#if !defined(DART_IO_RING_SUPPORTED)
+
+namespace dart {
+namespace bin {
+
+bool IORing::enabled_ = true;
+
+bool IORing::available() {
+  return false;
+}
+
+void IORing::Fail(int error) {}
+
+bool IORing::Submit(Dart_Port reply_port,
+                    int32_t message_id,
+                    intptr_t request_id,
+                    const CObjectArray& data) {
+  return false;
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // !defined(DART_IO_RING_SUPPORTED)
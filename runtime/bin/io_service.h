@@ -59,7 +59,11 @@ namespace bin {
   V(Directory, ListNext, 39)                                                   \
   V(Directory, ListStop, 40)                                                   \
   V(Directory, Rename, 41)                                                     \
-  V(SSLFilter, ProcessFilter, 42)
+  V(SSLFilter, ProcessFilter, 42)                                              \
+  V(File, ReadAt, 43)                                                          \
+  V(File, ReadVAt, 44)                                                         \
+  V(File, WriteAt, 45)                                                         \
+  V(Socket, SendFile, 46)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
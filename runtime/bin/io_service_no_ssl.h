@@ -60,7 +60,11 @@ namespace bin {
   V(Directory, ListStart, 38)                                                  \
   V(Directory, ListNext, 39)                                                   \
   V(Directory, ListStop, 40)                                                   \
-  V(Directory, Rename, 41)
+  V(Directory, Rename, 41)                                                     \
+  V(File, ReadAt, 43)                                                          \
+  V(File, ReadVAt, 44)                                                         \
+  V(File, WriteAt, 45)                                                         \
+  V(Socket, SendFile, 46)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
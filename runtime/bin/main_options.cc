@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bin/eventhandler.h"
 #include "bin/log.h"
 #include "bin/options.h"
 #include "bin/platform.h"
@@ -72,6 +73,16 @@ DFE* Options::dfe_ = NULL;
 DEFINE_STRING_OPTION_CB(dfe, { Options::dfe()->set_frontend_filename(value); });
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+DEFINE_STRING_OPTION_CB(io_event_handler_threads, {
+  char* end = NULL;
+  const intptr_t count = strtol(value, &end, 10);
+  if ((*end != '\0') || (count <= 0)) {
+    Log::PrintErr("Invalid thread count for option io_event_handler_threads\n");
+    return false;
+  }
+  EventHandler::set_thread_count(count);
+});
+
 static void hot_reload_test_mode_callback(CommandLineOptions* vm_options) {
   // Identity reload.
   vm_options->AddArgument("--identity_reload");
@@ -199,6 +210,9 @@ void Options::PrintUsage() {
 "--root-certs-cache=<path>\n"
 "  The path to a cache directory containing the trusted root certificates to\n"
 "  use for secure socket connections.\n"
+"--io-event-handler-threads=<count>\n"
+"  The number of threads dart:io uses to wait for socket and timer events\n"
+"  on Linux (default 1).\n"
 #if defined(HOST_OS_LINUX) || \
     defined(HOST_OS_ANDROID) || \
     defined(HOST_OS_FUCHSIA)
@@ -157,10 +157,17 @@ class Process {
   static bool ModeIsAttached(ProcessStartMode mode);
   static bool ModeHasStdio(ProcessStartMode mode);
 
+  // Whether attached processes are started without copying the page tables
+  // of this process, where supported (Linux). Used by benchmarks to compare
+  // against fork.
+  static bool use_vfork() { return use_vfork_; }
+  static void set_use_vfork(bool use_vfork) { use_vfork_ = use_vfork; }
+
  private:
   static int global_exit_code_;
   static Mutex* global_exit_code_mutex_;
   static ExitHook exit_hook_;
+  static bool use_vfork_;
 
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(Process);
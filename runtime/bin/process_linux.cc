@@ -10,9 +10,12 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <sched.h>         // NOLINT
+#include <signal.h>        // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
+#include <sys/mman.h>      // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
@@ -37,6 +40,7 @@ namespace bin {
 int Process::global_exit_code_ = 0;
 Mutex* Process::global_exit_code_mutex_ = new Mutex();
 Process::ExitHook Process::exit_hook_ = NULL;
+bool Process::use_vfork_ = true;
 
 // ProcessInfo is used to map a process id to the file descriptor for
 // the pipe used to communicate the exit code of the process to Dart.
@@ -70,11 +74,20 @@ class ProcessInfoList {
  public:
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Like AddProcess, for callers that hold mutex(). Holding it from before
+  // a process is started until it is added makes the exit code handler wait
+  // for the process to be added, should it exit before that.
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
   }
 
+  static Mutex* mutex() { return mutex_; }
+
   static intptr_t LookupProcessExitFd(pid_t pid) {
     MutexLocker locker(mutex_);
     ProcessInfo* current = active_processes_;
@@ -277,6 +290,7 @@ class ProcessStarter {
     write_out_[1] = -1;
     exec_control_[0] = -1;
     exec_control_[1] = -1;
+    working_directory_fd_ = -1;
 
     program_arguments_ = reinterpret_cast<char**>(Dart_ScopeAllocate(
         (arguments_length + 2) * sizeof(*program_arguments_)));
@@ -304,37 +318,14 @@ class ProcessStarter {
       return err;
     }
 
-    // Fork to create the new process.
-    pid_t pid = TEMP_FAILURE_RETRY(fork());
-    if (pid < 0) {
-      // Failed to fork.
-      return CleanupAndReturnError();
-    } else if (pid == 0) {
-      // This runs in the new process.
-      NewProcess();
-    }
-
-    // This runs in the original process.
-
-    // If the child process is not started in detached mode, be sure to
-    // listen for exit-codes, now that we have a non detached child process
-    // and also Register this child process.
-    if (Process::ModeIsAttached(mode_)) {
-      ExitCodeHandler::ProcessStarted();
-      err = RegisterProcess(pid);
-      if (err != 0) {
-        return err;
-      }
+    pid_t pid;
+    if (Process::ModeIsAttached(mode_) && Process::use_vfork()) {
+      err = SpawnProcess(&pid);
+    } else {
+      err = ForkProcess(&pid);
     }
-
-    // Notify child process to start. This is done to delay the call to exec
-    // until the process is registered above, and we are ready to receive the
-    // exit code.
-    char msg = '1';
-    int bytes_written =
-        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
-    if (bytes_written != sizeof(msg)) {
-      return CleanupAndReturnError();
+    if (err != 0) {
+      return err;
     }
 
     // Read the result of executing the child process.
@@ -391,6 +382,229 @@ class ProcessStarter {
   }
 
  private:
+  // Starts the new process with fork, which copies the page tables of this
+  // process. The new process waits to be notified before it execs.
+  int ForkProcess(pid_t* child_pid) {
+    // Fork to create the new process.
+    pid_t pid = TEMP_FAILURE_RETRY(fork());
+    if (pid < 0) {
+      // Failed to fork.
+      return CleanupAndReturnError();
+    } else if (pid == 0) {
+      // This runs in the new process.
+      NewProcess();
+    }
+
+    // This runs in the original process.
+
+    // If the child process is not started in detached mode, be sure to
+    // listen for exit-codes, now that we have a non detached child process
+    // and also Register this child process.
+    if (Process::ModeIsAttached(mode_)) {
+      ExitCodeHandler::ProcessStarted();
+      int err = RegisterProcess(pid);
+      if (err != 0) {
+        return err;
+      }
+    }
+
+    // Notify child process to start. This is done to delay the call to exec
+    // until the process is registered above, and we are ready to receive the
+    // exit code.
+    char msg = '1';
+    int bytes_written =
+        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
+    if (bytes_written != sizeof(msg)) {
+      return CleanupAndReturnError();
+    }
+    *child_pid = pid;
+    return 0;
+  }
+
+  // Starts an attached process with clone(CLONE_VM | CLONE_VFORK), like
+  // vfork. The new process shares the memory of this one until it execs, so
+  // starting it takes the same time however large this process is. This
+  // thread is suspended until then.
+  //
+  // As the new process must not change any memory this process uses,
+  // everything it needs is prepared here: the working directory is opened,
+  // the program is looked up and the environment is chosen. The new process
+  // then only makes system calls.
+  int SpawnProcess(pid_t* child_pid) {
+    if (working_directory_ != NULL) {
+      NamespaceScope ns(namespc_, working_directory_);
+      working_directory_fd_ = TEMP_FAILURE_RETRY(openat64(
+          ns.fd(), ns.path(), O_PATH | O_DIRECTORY | O_CLOEXEC));
+      if (working_directory_fd_ < 0) {
+        return CleanupAndReturnError();
+      }
+    }
+    spawn_path_ = DartUtils::ScopedCString(PATH_MAX);
+    if (!FindPathInNamespace(spawn_path_, PATH_MAX, working_directory_fd_)) {
+      return CleanupAndReturnError();
+    }
+    spawn_environment_ =
+        (program_environment_ != NULL) ? program_environment_ : environ;
+    search_path_ = NULL;
+    for (char** variable = spawn_environment_; *variable != NULL; variable++) {
+      if (strncmp(*variable, "PATH=", 5) == 0) {
+        search_path_ = *variable + 5;
+        break;
+      }
+    }
+    if (search_path_ == NULL) {
+      // The search path execvp uses when PATH is not set.
+      search_path_ = "/bin:/usr/bin";
+    }
+    intptr_t arguments_length = 0;
+    while (program_arguments_[arguments_length] != NULL) {
+      arguments_length++;
+    }
+    // The arguments to run a program that is not an executable file as a
+    // shell script, as execvp does. The program is filled in when it fails.
+    shell_arguments_ = reinterpret_cast<char**>(Dart_ScopeAllocate(
+        (arguments_length + 2) * sizeof(*shell_arguments_)));
+    shell_arguments_[0] = const_cast<char*>("/bin/sh");
+    for (intptr_t i = 1; i <= arguments_length; i++) {
+      shell_arguments_[i + 1] = program_arguments_[i];
+    }
+
+    int event_fds[2];
+    if (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      return CleanupAndReturnError();
+    }
+    void* stack = mmap(NULL, kSpawnStackSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+      int err = CleanupAndReturnError();
+      close(event_fds[0]);
+      close(event_fds[1]);
+      return err;
+    }
+    // Signal handlers of this process must not run in the new process while
+    // it shares the memory of this one, so all signals are blocked until it
+    // has reset the handlers.
+    sigset_t all_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_SETMASK, &all_signals, &signal_mask_);
+    pid_t pid;
+    int clone_errno;
+    {
+      MutexLocker locker(ProcessInfoList::mutex());
+      pid = clone(SpawnedProcessEntry,
+                  reinterpret_cast<uint8_t*>(stack) + kSpawnStackSize,
+                  CLONE_VM | CLONE_VFORK | SIGCHLD, this);
+      clone_errno = errno;
+      if (pid > 0) {
+        ProcessInfoList::AddProcessLocked(pid, event_fds[1]);
+      }
+    }
+    pthread_sigmask(SIG_SETMASK, &signal_mask_, NULL);
+    munmap(stack, kSpawnStackSize);
+    close(working_directory_fd_);
+    working_directory_fd_ = -1;
+    if (pid < 0) {
+      errno = clone_errno;
+      int err = CleanupAndReturnError();
+      close(event_fds[0]);
+      close(event_fds[1]);
+      return err;
+    }
+    ExitCodeHandler::ProcessStarted();
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    *child_pid = pid;
+    return 0;
+  }
+
+  static int SpawnedProcessEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->SpawnedProcess();
+    return 0;
+  }
+
+  // This runs in the new process started by SpawnProcess, on its own stack
+  // but in the memory of the original process.
+  void SpawnedProcess() {
+    // Reset the handlers of caught signals, and restore the signal mask.
+    // Without CLONE_SIGHAND this does not change the original handlers.
+    struct sigaction action;
+    for (int signal = 1; signal < NSIG; signal++) {
+      if ((sigaction(signal, NULL, &action) == 0) &&
+          (action.sa_handler != SIG_IGN) && (action.sa_handler != SIG_DFL)) {
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = SIG_DFL;
+        sigaction(signal, &action, NULL);
+      }
+    }
+    sigprocmask(SIG_SETMASK, &signal_mask_, NULL);
+
+    if (mode_ == kNormal) {
+      if ((dup2(write_out_[0], STDIN_FILENO) == -1) ||
+          (dup2(read_in_[1], STDOUT_FILENO) == -1) ||
+          (dup2(read_err_[1], STDERR_FILENO) == -1)) {
+        ReportChildError();
+      }
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+
+    // Changing the working directory of a namespace only changes how paths
+    // in it are resolved.
+    if ((working_directory_fd_ != -1) && Namespace::IsDefault(namespc_) &&
+        (fchdir(working_directory_fd_) == -1)) {
+      ReportChildError();
+    }
+
+    if (strchr(spawn_path_, '/') != NULL) {
+      ExecSpawnedProcess(spawn_path_);
+      ReportChildError();
+    }
+    // Look the program up in the search path, as execvp does.
+    const intptr_t program_length = strlen(spawn_path_);
+    bool access_denied = false;
+    const char* directory = search_path_;
+    while (true) {
+      const char* end = strchrnul(directory, ':');
+      intptr_t directory_length = end - directory;
+      char path[PATH_MAX];
+      if (directory_length + program_length + 2 <= PATH_MAX) {
+        // An empty entry is the current directory.
+        if (directory_length == 0) {
+          directory = ".";
+          directory_length = 1;
+        }
+        memmove(path, directory, directory_length);
+        path[directory_length] = '/';
+        memmove(path + directory_length + 1, spawn_path_, program_length + 1);
+        ExecSpawnedProcess(path);
+        if (errno == EACCES) {
+          access_denied = true;
+        } else if ((errno != ENOENT) && (errno != ENOTDIR) &&
+                   (errno != ESTALE) && (errno != ENODEV) &&
+                   (errno != ETIMEDOUT)) {
+          ReportChildError();
+        }
+      }
+      if (*end == '\0') {
+        break;
+      }
+      directory = end + 1;
+    }
+    errno = access_denied ? EACCES : ENOENT;
+    ReportChildError();
+  }
+
+  // Execs [path], or runs it with the shell if it is not an executable file.
+  // Returns with errno set on failure.
+  void ExecSpawnedProcess(const char* path) {
+    execve(path, program_arguments_, spawn_environment_);
+    if (errno == ENOEXEC) {
+      shell_arguments_[1] = const_cast<char*>(path);
+      execve(shell_arguments_[0], shell_arguments_, spawn_environment_);
+      errno = ENOEXEC;
+    }
+  }
+
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -436,14 +650,21 @@ class ProcessStarter {
     }
   }
 
-  // Tries to find path_ relative to the current namespace.
+  // Tries to find path_ relative to the current namespace, or to
+  // [working_directory_fd] if it is not -1 and path_ is relative.
   // The path that should be passed to exec is returned in realpath.
   // Returns true on success, and false if there was an error that should
   // be reported to the parent.
-  bool FindPathInNamespace(char* realpath, intptr_t realpath_size) {
+  bool FindPathInNamespace(char* realpath,
+                           intptr_t realpath_size,
+                           intptr_t working_directory_fd) {
     NamespaceScope ns(namespc_, path_);
-    const int fd =
-        TEMP_FAILURE_RETRY(openat64(ns.fd(), ns.path(), O_RDONLY | O_CLOEXEC));
+    const bool relative = !File::IsAbsolutePath(path_);
+    const int fd = TEMP_FAILURE_RETRY(openat64(
+        ((working_directory_fd != -1) && relative) ? working_directory_fd
+                                                     : ns.fd(),
+        ((working_directory_fd != -1) && relative) ? path_ : ns.path(),
+        O_RDONLY | O_CLOEXEC));
     if (fd == -1) {
       if ((errno == ENOENT) && (strchr(path_, '/') == NULL)) {
         // path_ was not found relative to the namespace, but since it didn't
@@ -496,7 +717,7 @@ class ProcessStarter {
     }
 
     char realpath[PATH_MAX];
-    if (!FindPathInNamespace(realpath, PATH_MAX)) {
+    if (!FindPathInNamespace(realpath, PATH_MAX, -1)) {
       ReportChildError();
     }
     // TODO(dart:io) Test for the existence of execveat, and use it instead.
@@ -550,7 +771,7 @@ class ProcessStarter {
           // Report the final PID and do the exec.
           ReportPid(getpid());  // getpid cannot fail.
           char realpath[PATH_MAX];
-          if (!FindPathInNamespace(realpath, PATH_MAX)) {
+          if (!FindPathInNamespace(realpath, PATH_MAX, -1)) {
             ReportChildError();
           }
           // TODO(dart:io) Test for the existence of execveat, and use it
@@ -693,6 +914,10 @@ class ProcessStarter {
     }
     SetChildOsErrorMessage();
     CloseAllPipes();
+    if (working_directory_fd_ != -1) {
+      close(working_directory_fd_);
+      working_directory_fd_ = -1;
+    }
     return actual_errno;
   }
 
@@ -761,6 +986,8 @@ class ProcessStarter {
     ClosePipe(write_out_);
   }
 
+  static const intptr_t kSpawnStackSize = 64 * KB;
+
   int read_in_[2];       // Pipe for stdout to child process.
   int read_err_[2];      // Pipe for stderr to child process.
   int write_out_[2];     // Pipe for stdin to child process.
@@ -769,6 +996,14 @@ class ProcessStarter {
   char** program_arguments_;
   char** program_environment_;
 
+  // Prepared by SpawnProcess for the new process.
+  intptr_t working_directory_fd_;
+  char* spawn_path_;
+  char** spawn_environment_;
+  const char* search_path_;
+  char** shell_arguments_;
+  sigset_t signal_mask_;
+
   Namespace* namespc_;
   const char* path_;
   const char* working_directory_;
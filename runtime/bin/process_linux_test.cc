@@ -0,0 +1,256 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(HOST_OS_LINUX)
+
+#include "bin/process.h"
+
+#include <dirent.h>    // NOLINT
+#include <errno.h>     // NOLINT
+#include <sys/mman.h>  // NOLINT
+#include <sys/stat.h>  // NOLINT
+
+#include "bin/directory.h"
+#include "bin/file.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/benchmark_test.h"
+#include "vm/timer.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const intptr_t kProcessStarts = 200;
+// Forking copies page tables in proportion to the RSS, so fewer processes
+// are started with the larger RSS.
+static const intptr_t kLargeRSS = 256 * MB;
+static const intptr_t kLargeRSSProcessStarts = 20;
+
+// Starts /bin/true [starts] times, with vfork or fork, and returns the
+// average time Process::Start takes, after touching [rss] bytes of memory to
+// make this process that large.
+static int64_t StartProcesses(bool use_vfork, intptr_t rss, intptr_t starts) {
+  Dart_EnterScope();
+  uint8_t* memory = NULL;
+  if (rss > 0) {
+    memory = reinterpret_cast<uint8_t*>(mmap(NULL, rss, PROT_READ | PROT_WRITE,
+                                             MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                                             0));
+    EXPECT(memory != MAP_FAILED);
+    for (intptr_t i = 0; i < rss; i += 4 * KB) {
+      memory[i] = 1;
+    }
+  }
+  const bool saved_use_vfork = bin::Process::use_vfork();
+  bin::Process::set_use_vfork(use_vfork);
+
+  Timer timer(true, "Process start benchmark");
+  for (intptr_t i = 0; i < starts; i++) {
+    char* arguments[1] = {NULL};
+    intptr_t in, out, err, id, exit_event;
+    char* os_error_message = NULL;
+    timer.Start();
+    int result = bin::Process::Start(NULL, "/bin/true", arguments, 0, NULL,
+                                     NULL, 0, bin::kNormal, &in, &out, &err,
+                                     &id, &exit_event, &os_error_message);
+    timer.Stop();
+    EXPECT_EQ(0, result);
+    bin::ProcessResult process_result;
+    EXPECT(bin::Process::Wait(id, in, out, err, exit_event, &process_result));
+    EXPECT_EQ(0, process_result.exit_code());
+  }
+
+  bin::Process::set_use_vfork(saved_use_vfork);
+  if (memory != NULL) {
+    munmap(memory, rss);
+  }
+  Dart_ExitScope();
+  return timer.TotalElapsedTime() / starts;
+}
+
+BENCHMARK(ProcessStartFork) {
+  benchmark->set_score(StartProcesses(false, 0, kProcessStarts));
+}
+
+BENCHMARK(ProcessStartVfork) {
+  benchmark->set_score(StartProcesses(true, 0, kProcessStarts));
+}
+
+BENCHMARK(ProcessStartForkLargeRSS) {
+  benchmark->set_score(
+      StartProcesses(false, kLargeRSS, kLargeRSSProcessStarts));
+}
+
+BENCHMARK(ProcessStartVforkLargeRSS) {
+  benchmark->set_score(StartProcesses(true, kLargeRSS, kLargeRSSProcessStarts));
+}
+
+// Writes a shell script without a #! line, which exits with [exit_code], to
+// [directory]/[name]. Running it fails with ENOEXEC, so it is run by
+// /bin/sh instead.
+static void WriteScript(const char* directory,
+                        const char* name,
+                        int exit_code) {
+  char path[PATH_MAX];
+  Utils::SNPrint(path, sizeof(path), "%s/%s", directory, name);
+  char script[32];
+  Utils::SNPrint(script, sizeof(script), "exit %d\n", exit_code);
+  bin::File* file = bin::File::Open(NULL, path, bin::File::kWriteTruncate);
+  EXPECT(file != NULL);
+  EXPECT(file->WriteFully(script, strlen(script)));
+  file->Release();
+  EXPECT_EQ(0, chmod(path, 0755));
+}
+
+// Starts [path] with vfork or fork, and returns the error Process::Start
+// reports, or 0 after setting [exit_code] to the exit code of the process.
+static int RunProcess(bool use_vfork,
+                      const char* path,
+                      const char* working_directory,
+                      const char* path_variable,
+                      char** os_error_message,
+                      intptr_t* exit_code) {
+  char* arguments[1] = {NULL};
+  char* environment[1] = {const_cast<char*>(path_variable)};
+  intptr_t in, out, err, id, exit_event;
+  *os_error_message = NULL;
+  const bool saved_use_vfork = bin::Process::use_vfork();
+  bin::Process::set_use_vfork(use_vfork);
+  int result = bin::Process::Start(
+      NULL, path, arguments, 0, working_directory,
+      (path_variable != NULL) ? environment : NULL,
+      (path_variable != NULL) ? 1 : 0, bin::kNormal, &in, &out, &err, &id,
+      &exit_event, os_error_message);
+  bin::Process::set_use_vfork(saved_use_vfork);
+  if (result == 0) {
+    bin::ProcessResult process_result;
+    EXPECT(bin::Process::Wait(id, in, out, err, exit_event, &process_result));
+    *exit_code = process_result.exit_code();
+  }
+  return result;
+}
+
+// Runs [path] like RunProcess with vfork, and checks that fork gives the
+// same result.
+static int RunVforked(const char* path,
+                      const char* working_directory,
+                      const char* path_variable,
+                      char** os_error_message,
+                      intptr_t* exit_code) {
+  char* fork_error_message = NULL;
+  intptr_t fork_exit_code = -1;
+  const int fork_result =
+      RunProcess(false, path, working_directory, path_variable,
+                 &fork_error_message, &fork_exit_code);
+  const int result = RunProcess(true, path, working_directory, path_variable,
+                                os_error_message, exit_code);
+  EXPECT_EQ(fork_result, result);
+  if ((fork_result == 0) && (result == 0)) {
+    EXPECT_EQ(fork_exit_code, *exit_code);
+  } else if ((fork_error_message != NULL) && (*os_error_message != NULL)) {
+    EXPECT_STREQ(fork_error_message, *os_error_message);
+  }
+  return result;
+}
+
+TEST_CASE(ProcessStartVforkLookup) {
+  Dart_EnterScope();
+  char prefix[PATH_MAX];
+  Utils::SNPrint(prefix, sizeof(prefix), "%s/process_linux_test",
+                 bin::Directory::SystemTemp(NULL));
+  const char* directory = bin::Directory::CreateTemp(NULL, prefix);
+  EXPECT(directory != NULL);
+  char subdirectory[PATH_MAX];
+  Utils::SNPrint(subdirectory, sizeof(subdirectory), "%s/bin", directory);
+  EXPECT(bin::Directory::Create(NULL, subdirectory));
+  WriteScript(directory, "script", 7);
+  WriteScript(subdirectory, "script_in_bin", 9);
+  char script_path[PATH_MAX];
+  Utils::SNPrint(script_path, sizeof(script_path), "%s/script", directory);
+  char missing_path[PATH_MAX];
+  Utils::SNPrint(missing_path, sizeof(missing_path), "PATH=%s", subdirectory);
+  char empty_entry_path[PATH_MAX];
+  Utils::SNPrint(empty_entry_path, sizeof(empty_entry_path), "PATH=%s::/bin",
+                 subdirectory);
+
+  char* os_error_message;
+  intptr_t exit_code = -1;
+  char expected_message[1024];
+
+  // A program missing from the search path is reported by the new process
+  // on the exec control pipe.
+  EXPECT_EQ(ENOENT, RunVforked("process_linux_test_missing", directory,
+                               missing_path, &os_error_message, &exit_code));
+  EXPECT(os_error_message != NULL);
+  Utils::StrError(ENOENT, expected_message, sizeof(expected_message));
+  EXPECT_STREQ(expected_message, os_error_message);
+
+  // A file that is not an executable is run with /bin/sh.
+  EXPECT_EQ(0, RunVforked(script_path, NULL, NULL, &os_error_message,
+                          &exit_code));
+  EXPECT_EQ(7, exit_code);
+
+  // A relative program is resolved against the working directory.
+  EXPECT_EQ(0, RunVforked("bin/script_in_bin", directory, NULL,
+                          &os_error_message, &exit_code));
+  EXPECT_EQ(9, exit_code);
+
+  // The search path is used for a program without a slash.
+  EXPECT_EQ(0, RunVforked("script_in_bin", NULL, missing_path,
+                          &os_error_message, &exit_code));
+  EXPECT_EQ(9, exit_code);
+
+  // An empty entry in the search path is the working directory.
+  EXPECT_EQ(0, RunVforked("script", directory, empty_entry_path,
+                          &os_error_message, &exit_code));
+  EXPECT_EQ(7, exit_code);
+
+  EXPECT(bin::Directory::Delete(NULL, directory, true));
+  Dart_ExitScope();
+}
+
+// Returns the number of file descriptors open in this process.
+static intptr_t CountOpenFds() {
+  DIR* dir = opendir("/proc/self/fd");
+  EXPECT(dir != NULL);
+  intptr_t count = 0;
+  while (readdir(dir) != NULL) {
+    count++;
+  }
+  closedir(dir);
+  return count;
+}
+
+// A program that cannot be found relative to the working directory fails
+// before the process is started, without leaking the working directory.
+TEST_CASE(ProcessStartBadProgramInWorkingDirectory) {
+  const intptr_t kStarts = 16;
+  Dart_EnterScope();
+  char prefix[PATH_MAX];
+  Utils::SNPrint(prefix, sizeof(prefix), "%s/process_linux_test",
+                 bin::Directory::SystemTemp(NULL));
+  const char* directory = bin::Directory::CreateTemp(NULL, prefix);
+  EXPECT(directory != NULL);
+
+  char* os_error_message;
+  intptr_t exit_code = -1;
+  char expected_message[1024];
+  Utils::StrError(ENOENT, expected_message, sizeof(expected_message));
+  const intptr_t open_fds = CountOpenFds();
+  for (intptr_t i = 0; i < kStarts; i++) {
+    EXPECT_EQ(ENOENT, RunVforked("missing/program", directory, NULL,
+                                 &os_error_message, &exit_code));
+    EXPECT(os_error_message != NULL);
+    EXPECT_STREQ(expected_message, os_error_message);
+  }
+  EXPECT_EQ(open_fds, CountOpenFds());
+
+  EXPECT(bin::Directory::Delete(NULL, directory, true));
+  Dart_ExitScope();
+}
+
+}  // namespace dart
+
+#endif  // defined(HOST_OS_LINUX)
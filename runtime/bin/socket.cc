@@ -332,6 +332,37 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
+    if (length <= IOBufferPool::kBufferSize) {
+      // Read into a pooled buffer and hand out only the part that was read.
+      uint8_t* buffer = IOBufferPool::Allocate();
+      if (buffer == NULL) {
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+        return;
+      }
+      intptr_t bytes_read =
+          SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+      if (bytes_read > 0) {
+        Dart_Handle result = IOBufferPool::Wrap(buffer, bytes_read);
+        if (Dart_IsNull(result)) {
+          result = DartUtils::NewDartOSError();
+        }
+        Dart_SetReturnValue(args, result);
+        return;
+      }
+      if (bytes_read == 0) {
+        // On MacOS when reading from a tty Ctrl-D will result in reading one
+        // less byte then reported as available.
+        IOBufferPool::Free(buffer);
+        Dart_SetReturnValue(args, Dart_Null());
+      } else {
+        ASSERT(bytes_read == -1);
+        // Extract OSError before we free the buffer, as it may override it.
+        OSError os_error;
+        IOBufferPool::Free(buffer);
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+      }
+      return;
+    }
     uint8_t* buffer = NULL;
     Dart_Handle result = IOBuffer::Allocate(length, &buffer);
     if (Dart_IsNull(result)) {
@@ -373,6 +404,37 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
+  }
+  Dart_TypedData_Type type;
+  uint8_t* buffer = NULL;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT((offset + length) <= len);
+  intptr_t bytes_read = SocketBase::Read(socket->fd(), buffer + offset,
+                                         length, SocketBase::kAsync);
+  if (bytes_read >= 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetIntegerReturnValue(args, bytes_read);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
 void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
   // handle 64k datagrams.
@@ -451,6 +513,62 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, result);
 }
 
+void FUNCTION_NAME(Socket_RecvMultiple)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 2);
+  intptr_t count;
+  Dart_Handle result = Dart_ListLength(ends_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(count > 0);
+  intptr_t* lengths =
+      reinterpret_cast<intptr_t*>(Dart_ScopeAllocate(count * sizeof(intptr_t)));
+
+  // Receive the datagrams into equal slots of the buffer and then move them
+  // next to each other.
+  Dart_TypedData_Type type;
+  uint8_t* buffer = NULL;
+  intptr_t len;
+  result = Dart_TypedDataAcquireData(buffer_obj, &type,
+                                     reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  const intptr_t slot_size = len / count;
+  intptr_t received = SocketBase::RecvMultiple(
+      socket->fd(), buffer, slot_size, count, lengths, SocketBase::kAsync);
+  if (received < 0) {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  intptr_t end = 0;
+  for (intptr_t i = 0; i < received; i++) {
+    memmove(buffer + end, buffer + i * slot_size, lengths[i]);
+    end += lengths[i];
+    lengths[i] = end;
+  }
+  Dart_TypedDataReleaseData(buffer_obj);
+
+  int32_t* ends = NULL;
+  result = Dart_TypedDataAcquireData(ends_obj, &type,
+                                     reinterpret_cast<void**>(&ends), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(type == Dart_TypedData_kInt32);
+  for (intptr_t i = 0; i < received; i++) {
+    ends[i] = lengths[i];
+  }
+  Dart_TypedDataReleaseData(ends_obj);
+  Dart_SetIntegerReturnValue(args, received);
+}
+
 void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -494,6 +612,98 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_WriteListV)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle offsets_obj = Dart_GetNativeArgument(args, 2);
+  ASSERT(Dart_IsList(buffers_obj));
+  ASSERT(Dart_IsList(offsets_obj));
+  intptr_t count;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  Dart_Handle* handles = reinterpret_cast<Dart_Handle*>(
+      Dart_ScopeAllocate(count * sizeof(Dart_Handle)));
+  const void** buffers = reinterpret_cast<const void**>(
+      Dart_ScopeAllocate(count * sizeof(void*)));
+  intptr_t* offsets = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(count * sizeof(intptr_t)));
+  intptr_t* lengths = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(count * sizeof(intptr_t)));
+  // Look up all the buffers before acquiring any of their data.
+  for (intptr_t i = 0; i < count; i++) {
+    handles[i] = Dart_ListGetAt(buffers_obj, i);
+    if (Dart_IsError(handles[i])) {
+      Dart_PropagateError(handles[i]);
+    }
+    offsets[i] = DartUtils::GetIntptrValue(Dart_ListGetAt(offsets_obj, i));
+  }
+  intptr_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = NULL;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(
+        handles[i], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) {
+        Dart_TypedDataReleaseData(handles[j]);
+      }
+      Dart_PropagateError(result);
+    }
+    ASSERT(offsets[i] <= len);
+    buffers[i] = buffer + offsets[i];
+    lengths[i] = len - offsets[i];
+    total += lengths[i];
+  }
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (total > 1) {
+      short_write = true;
+    }
+    // Cut the buffers off after half of the bytes.
+    intptr_t remaining = (total + 1) / 2;
+    for (intptr_t i = 0; i < count; i++) {
+      if (lengths[i] > remaining) {
+        lengths[i] = remaining;
+      }
+      remaining -= lengths[i];
+    }
+  }
+  intptr_t bytes_written = SocketBase::WriteV(socket->fd(), buffers, lengths,
+                                              count, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    for (intptr_t i = 0; i < count; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    for (intptr_t i = 0; i < count; i++) {
+      Dart_TypedDataReleaseData(handles[i]);
+    }
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
+void FUNCTION_NAME(Socket_GetPointer)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // Increment the socket's reference count. Socket_GetPointer() should only
+  // be called when we are about to send the Socket* to the IO Service.
+  socket->Retain();
+  Dart_SetIntegerReturnValue(args, reinterpret_cast<intptr_t>(socket));
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -530,6 +740,64 @@ void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_SendToMultiple)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle address_obj = Dart_GetNativeArgument(args, 3);
+  ASSERT(Dart_IsList(address_obj));
+  RawAddr addr;
+  SocketAddress::GetSockAddr(address_obj, &addr);
+  int64_t port = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 4), 0, 65535);
+  SocketAddress::SetAddrPort(&addr, port);
+  intptr_t count;
+  Dart_Handle result = Dart_ListLength(ends_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  intptr_t* lengths =
+      reinterpret_cast<intptr_t*>(Dart_ScopeAllocate(count * sizeof(intptr_t)));
+
+  // Turn the end offsets into datagram lengths.
+  Dart_TypedData_Type type;
+  int32_t* ends = NULL;
+  intptr_t len;
+  result = Dart_TypedDataAcquireData(ends_obj, &type,
+                                     reinterpret_cast<void**>(&ends), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(type == Dart_TypedData_kInt32);
+  intptr_t start = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    ASSERT(ends[i] >= start);
+    lengths[i] = ends[i] - start;
+    start = ends[i];
+  }
+  Dart_TypedDataReleaseData(ends_obj);
+
+  uint8_t* buffer = NULL;
+  result = Dart_TypedDataAcquireData(buffer_obj, &type,
+                                     reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(start <= len);
+  intptr_t sent = SocketBase::SendToMultiple(socket->fd(), buffer, lengths,
+                                             count, addr, SocketBase::kAsync);
+  if (sent >= 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetIntegerReturnValue(args, sent);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
 void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -617,6 +885,25 @@ void FUNCTION_NAME(Socket_SetSocketId)(Dart_NativeArguments args) {
                                  finalizer);
 }
 
+void FUNCTION_NAME(Socket_SetDispatchPort)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Port dispatch_port;
+  Dart_Handle result =
+      Dart_SendPortGetId(Dart_GetNativeArgument(args, 1), &dispatch_port);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  Dart_Port event_port;
+  result = Dart_SendPortGetId(Dart_GetNativeArgument(args, 2), &event_port);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  socket->set_dispatch_port(dispatch_port);
+  // Events posted to the dispatch port name the socket by its event port.
+  Dart_SetIntegerReturnValue(args, event_port);
+}
+
 void FUNCTION_NAME(ServerSocket_CreateBindListen)(Dart_NativeArguments args) {
   RawAddr addr;
   SocketAddress::GetSockAddr(Dart_GetNativeArgument(args, 1), &addr);
@@ -649,6 +936,61 @@ void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
   }
 }
 
+static int64_t CObjectInt32OrInt64ToInt64(CObject* cobject) {
+  ASSERT(cobject->IsInt32OrInt64());
+  if (cobject->IsInt32()) {
+    CObjectInt32 value(cobject);
+    return value.Value();
+  }
+  CObjectInt64 value(cobject);
+  return value.Value();
+}
+
+// Sends part of a file range on the IO service, so the mutator does not wait
+// for the file to be read. The socket is non-blocking, and the reply is the
+// number of bytes sent, which is 0 if the socket would block, or null if the
+// file ended first. _NativeSocket.close waits for the request before it
+// closes the socket.
+CObject* Socket::SendFileRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectIntptr socket_pointer(request[0]);
+  Socket* socket = reinterpret_cast<Socket*>(socket_pointer.Value());
+  RefCntReleaseScope<Socket> rs(socket);
+  if ((request.Length() < 2) || !request[1]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  CObjectIntptr file_pointer(request[1]);
+  File* file = reinterpret_cast<File*>(file_pointer.Value());
+  RefCntReleaseScope<File> fs(file);
+  if ((request.Length() != 4) || !request[2]->IsInt32OrInt64() ||
+      !request[3]->IsInt32OrInt64()) {
+    return CObject::IllegalArgumentError();
+  }
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  const int64_t offset = CObjectInt32OrInt64ToInt64(request[2]);
+  intptr_t length = CObjectInt32OrInt64ToInt64(request[3]);
+  if ((offset < 0) || (length < 0)) {
+    return CObject::IllegalArgumentError();
+  }
+  if (Socket::short_socket_write()) {
+    length = (length + 1) / 2;
+  }
+  intptr_t bytes_sent = SocketBase::SendFile(socket->fd(), file, offset,
+                                             length, SocketBase::kAsync);
+  if (bytes_sent < 0) {
+    return CObject::NewOSError();
+  }
+  if ((bytes_sent == 0) && (length > 0) && (file->Length() <= offset)) {
+    // The file ended before all the requested bytes were sent.
+    return CObject::Null();
+  }
+  return new CObjectInt64(CObject::NewInt64(bytes_sent));
+}
+
 CObject* Socket::LookupRequest(const CObjectArray& request) {
   if ((request.Length() == 2) && request[0]->IsString() &&
       request[1]->IsInt32()) {
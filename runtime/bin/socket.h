@@ -56,6 +56,12 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port port() const { return port_; }
   void set_port(Dart_Port port) { port_ = port; }
 
+  // The port of the isolate's socket event dispatcher. An event handler may
+  // post the events of several sockets of the isolate to it in one message,
+  // as pairs of the socket's port and its events.
+  Dart_Port dispatch_port() const { return dispatch_port_; }
+  void set_dispatch_port(Dart_Port port) { dispatch_port_ = port; }
+
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
   void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
 
@@ -78,6 +84,7 @@ class Socket : public ReferenceCounted<Socket> {
   static CObject* LookupRequest(const CObjectArray& request);
   static CObject* ListInterfacesRequest(const CObjectArray& request);
   static CObject* ReverseLookupRequest(const CObjectArray& request);
+  static CObject* SendFileRequest(const CObjectArray& request);
 
   static Dart_Port GetServicePort();
 
@@ -117,6 +124,7 @@ class Socket : public ReferenceCounted<Socket> {
   intptr_t fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
+  Dart_Port dispatch_port_;
   uint8_t* udp_receive_buffer_;
 
   friend class ReferenceCounted<Socket>;
@@ -23,6 +23,7 @@
 
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
+#include "bin/file.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
 #include "platform/allocation.h"
@@ -152,6 +153,23 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Write the [count] buffers in order with a single system call where the
+  // platform supports it. Returns the total number of bytes written, which
+  // may end in the middle of any of the buffers.
+  static intptr_t WriteV(intptr_t fd,
+                         const void* const* buffers,
+                         const intptr_t* lengths,
+                         intptr_t count,
+                         SocketOpKind sync);
+  // Send up to [num_bytes] bytes of [file] starting at [offset], without
+  // copying them through the caller where the platform supports it. The
+  // file position is not used. Returns the number of bytes sent, which is 0
+  // if the socket would block or at the end of the file.
+  static intptr_t SendFile(intptr_t fd,
+                           File* file,
+                           int64_t offset,
+                           intptr_t num_bytes,
+                           SocketOpKind sync);
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
@@ -165,6 +183,25 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Receive up to [count] datagrams, datagram i into the [slot_size] bytes at
+  // buffer + i * slot_size, with a single system call where the platform
+  // supports it. The length of each datagram received is stored in
+  // [lengths]. Returns the number of datagrams received.
+  static intptr_t RecvMultiple(intptr_t fd,
+                               void* buffer,
+                               intptr_t slot_size,
+                               intptr_t count,
+                               intptr_t* lengths,
+                               SocketOpKind sync);
+  // Send the [count] datagrams stored back to back in [buffer], with the
+  // lengths given by [lengths], to the same address. Returns the number of
+  // datagrams sent.
+  static intptr_t SendToMultiple(intptr_t fd,
+                                 const void* buffer,
+                                 const intptr_t* lengths,
+                                 intptr_t count,
+                                 const RawAddr& addr,
+                                 SocketOpKind sync);
   // Returns true if the given error-number is because the system was not able
   // to bind the socket to a specific IP.
   static bool IsBindError(intptr_t error_number);
@@ -13,10 +13,12 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
+#include "bin/io_buffer.h"
 #include "bin/socket_base_android.h"
 #include "platform/signal_blocker.h"
 
@@ -87,6 +89,27 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return read_bytes;
 }
 
+intptr_t SocketBase::RecvMultiple(intptr_t fd,
+                                  void* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  SocketOpKind sync) {
+  // There is no batched receive, so receive the datagrams one at a time until
+  // no more are available.
+  uint8_t* slots = reinterpret_cast<uint8_t*>(buffer);
+  RawAddr addr;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t bytes_read =
+        RecvFrom(fd, slots + i * slot_size, slot_size, &addr, sync);
+    if (bytes_read <= 0) {
+      return ((i > 0) || (bytes_read == 0)) ? i : bytes_read;
+    }
+    lengths[i] = bytes_read;
+  }
+  return count;
+}
+
 intptr_t SocketBase::Write(intptr_t fd,
                            const void* buffer,
                            intptr_t num_bytes,
@@ -102,6 +125,51 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteV(intptr_t fd,
+                            const void* const* buffers,
+                            const intptr_t* lengths,
+                            intptr_t count,
+                            SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  static const intptr_t kMaxIOVectors = 64;
+  struct iovec iov[kMaxIOVectors];
+  if (count > kMaxIOVectors) {
+    count = kMaxIOVectors;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  // Read the file into a buffer and write that. Bytes that are not written
+  // are read again on the next call.
+  const intptr_t kBufferSize = IOBufferPool::kBufferSize;
+  uint8_t* buffer = IOBufferPool::Allocate();
+  ssize_t read_bytes = TEMP_FAILURE_RETRY(
+      pread64(file->GetFD(), buffer,
+              (num_bytes < kBufferSize) ? num_bytes : kBufferSize, offset));
+  intptr_t written_bytes = read_bytes;
+  if (read_bytes > 0) {
+    written_bytes = Write(fd, buffer, read_bytes, sync);
+  }
+  IOBufferPool::Free(buffer);
+  return written_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -120,6 +188,28 @@ intptr_t SocketBase::SendTo(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendToMultiple(intptr_t fd,
+                                    const void* buffer,
+                                    const intptr_t* lengths,
+                                    intptr_t count,
+                                    const RawAddr& addr,
+                                    SocketOpKind sync) {
+  // There is no batched send, so send the datagrams one at a time until one
+  // is not sent.
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer);
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = SendTo(fd, data, lengths[i], addr, sync);
+    if (written_bytes < 0) {
+      return (i > 0) ? i : written_bytes;
+    }
+    if (written_bytes < lengths[i]) {
+      return i;
+    }
+    data += lengths[i];
+  }
+  return count;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   RawAddr raw;
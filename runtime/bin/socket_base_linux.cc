@@ -7,21 +7,24 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <ifaddrs.h>      // NOLINT
-#include <net/if.h>       // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <ifaddrs.h>       // NOLINT
+#include <net/if.h>        // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <sys/uio.h>       // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
 #include "bin/socket_base_linux.h"
 #include "bin/thread.h"
 #include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -90,6 +93,49 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return read_bytes;
 }
 
+intptr_t SocketBase::RecvMultiple(intptr_t fd,
+                                  void* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  static const intptr_t kMaxMessages = 64;
+  struct mmsghdr messages[kMaxMessages];
+  struct iovec iov[kMaxMessages];
+  uint8_t* slots = reinterpret_cast<uint8_t*>(buffer);
+  intptr_t received = 0;
+  while (received < count) {
+    const intptr_t batch =
+        Utils::Minimum<intptr_t>(count - received, kMaxMessages);
+    memset(messages, 0, batch * sizeof(messages[0]));
+    for (intptr_t i = 0; i < batch; i++) {
+      iov[i].iov_base = slots + (received + i) * slot_size;
+      iov[i].iov_len = slot_size;
+      messages[i].msg_hdr.msg_iov = &iov[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    int result = TEMP_FAILURE_RETRY(recvmmsg(fd, messages, batch, 0, NULL));
+    if (result == -1) {
+      ASSERT(EAGAIN == EWOULDBLOCK);
+      if ((received > 0) || ((sync == kAsync) && (errno == EWOULDBLOCK))) {
+        // Report the datagrams received so far. An error will show up again
+        // on the next receive.
+        break;
+      }
+      return -1;
+    }
+    for (intptr_t i = 0; i < result; i++) {
+      lengths[received + i] = messages[i].msg_len;
+    }
+    received += result;
+    if (result < batch) {
+      break;
+    }
+  }
+  return received;
+}
+
 intptr_t SocketBase::Write(intptr_t fd,
                            const void* buffer,
                            intptr_t num_bytes,
@@ -105,6 +151,49 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteV(intptr_t fd,
+                            const void* const* buffers,
+                            const intptr_t* lengths,
+                            intptr_t count,
+                            SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  static const intptr_t kMaxIOVectors = 64;
+  struct iovec iov[kMaxIOVectors];
+  if (count > kMaxIOVectors) {
+    count = kMaxIOVectors;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  off64_t position = offset;
+  ssize_t sent_bytes =
+      TEMP_FAILURE_RETRY(sendfile64(fd, file->GetFD(), &position, num_bytes));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (sent_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    sent_bytes = 0;
+  }
+  return sent_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -123,6 +212,46 @@ intptr_t SocketBase::SendTo(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendToMultiple(intptr_t fd,
+                                    const void* buffer,
+                                    const intptr_t* lengths,
+                                    intptr_t count,
+                                    const RawAddr& addr,
+                                    SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  static const intptr_t kMaxMessages = 64;
+  struct mmsghdr messages[kMaxMessages];
+  struct iovec iov[kMaxMessages];
+  uint8_t* data = reinterpret_cast<uint8_t*>(const_cast<void*>(buffer));
+  intptr_t sent = 0;
+  while (sent < count) {
+    const intptr_t batch = Utils::Minimum<intptr_t>(count - sent, kMaxMessages);
+    memset(messages, 0, batch * sizeof(messages[0]));
+    for (intptr_t i = 0; i < batch; i++) {
+      iov[i].iov_base = data;
+      iov[i].iov_len = lengths[sent + i];
+      data += lengths[sent + i];
+      messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(&addr.addr);
+      messages[i].msg_hdr.msg_namelen = SocketAddress::GetAddrLength(addr);
+      messages[i].msg_hdr.msg_iov = &iov[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    int result = TEMP_FAILURE_RETRY(sendmmsg(fd, messages, batch, 0));
+    if (result == -1) {
+      ASSERT(EAGAIN == EWOULDBLOCK);
+      if ((sent > 0) || ((sync == kAsync) && (errno == EWOULDBLOCK))) {
+        break;
+      }
+      return -1;
+    }
+    sent += result;
+    if (result < batch) {
+      break;
+    }
+  }
+  return sent;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   RawAddr raw;
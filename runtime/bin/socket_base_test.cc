@@ -0,0 +1,111 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/socket_base.h"
+
+#if !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+#include <arpa/inet.h>   // NOLINT
+#include <fcntl.h>       // NOLINT
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+#endif
+
+#include "platform/assert.h"
+#include "vm/benchmark_test.h"
+#include "vm/timer.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+
+static const intptr_t kDatagramSize = 512;
+static const intptr_t kDatagramsPerRound = 64;
+static const intptr_t kDatagramRounds = 2000;
+
+// Binds a non-blocking UDP socket to an ephemeral loopback port.
+static int BindLoopbackDatagramSocket(bin::RawAddr* addr) {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  EXPECT(fd >= 0);
+  EXPECT_EQ(0, fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK));
+  memset(addr, 0, sizeof(*addr));
+  addr->in.sin_family = AF_INET;
+  addr->in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  EXPECT_EQ(0, bind(fd, &addr->addr, sizeof(addr->in)));
+  socklen_t addr_len = sizeof(addr->ss);
+  EXPECT_EQ(0, getsockname(fd, &addr->addr, &addr_len));
+  return fd;
+}
+
+// Sends and receives batches of datagrams over loopback, one datagram per
+// system call or a batch per system call, and returns the time taken.
+static int64_t DatagramThroughput(bool batched) {
+  bin::RawAddr receiver_addr;
+  bin::RawAddr sender_addr;
+  int receiver = BindLoopbackDatagramSocket(&receiver_addr);
+  int sender = BindLoopbackDatagramSocket(&sender_addr);
+  uint8_t* data = new uint8_t[kDatagramSize * kDatagramsPerRound];
+  memset(data, 0x42, kDatagramSize * kDatagramsPerRound);
+  intptr_t lengths[kDatagramsPerRound];
+  for (intptr_t i = 0; i < kDatagramsPerRound; i++) {
+    lengths[i] = kDatagramSize;
+  }
+  uint8_t* buffer = new uint8_t[kDatagramSize * kDatagramsPerRound];
+  intptr_t received_lengths[kDatagramsPerRound];
+
+  Timer timer(true, "Datagram throughput benchmark");
+  timer.Start();
+  for (intptr_t round = 0; round < kDatagramRounds; round++) {
+    intptr_t sent = 0;
+    intptr_t received = 0;
+    if (batched) {
+      sent = bin::SocketBase::SendToMultiple(sender, data, lengths,
+                                             kDatagramsPerRound, receiver_addr,
+                                             bin::SocketBase::kAsync);
+      while (received < sent) {
+        intptr_t result = bin::SocketBase::RecvMultiple(
+            receiver, buffer, kDatagramSize, kDatagramsPerRound - received,
+            received_lengths + received, bin::SocketBase::kAsync);
+        EXPECT(result > 0);
+        received += result;
+      }
+    } else {
+      for (intptr_t i = 0; i < kDatagramsPerRound; i++) {
+        EXPECT_EQ(kDatagramSize, bin::SocketBase::SendTo(
+                                     sender, data + i * kDatagramSize,
+                                     kDatagramSize, receiver_addr,
+                                     bin::SocketBase::kAsync));
+        sent++;
+      }
+      bin::RawAddr from;
+      while (received < sent) {
+        intptr_t bytes_read =
+            bin::SocketBase::RecvFrom(receiver, buffer, kDatagramSize, &from,
+                                      bin::SocketBase::kAsync);
+        EXPECT(bytes_read > 0);
+        received++;
+      }
+    }
+    EXPECT_EQ(kDatagramsPerRound, received);
+  }
+  timer.Stop();
+
+  delete[] buffer;
+  delete[] data;
+  close(sender);
+  close(receiver);
+  return timer.TotalElapsedTime();
+}
+
+BENCHMARK(DatagramThroughputSingle) {
+  benchmark->set_score(DatagramThroughput(false));
+}
+
+BENCHMARK(DatagramThroughputMultiple) {
+  benchmark->set_score(DatagramThroughput(true));
+}
+
+#endif  // !defined(HOST_OS_WINDOWS) && !defined(HOST_OS_FUCHSIA)
+
+}  // namespace dart
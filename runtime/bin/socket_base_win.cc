@@ -10,6 +10,7 @@
 #include "bin/builtin.h"
 #include "bin/eventhandler.h"
 #include "bin/file.h"
+#include "bin/io_buffer.h"
 #include "bin/lockers.h"
 #include "bin/log.h"
 #include "bin/socket_base_win.h"
@@ -88,6 +89,27 @@ intptr_t SocketBase::RecvFrom(intptr_t fd,
   return handle->RecvFrom(buffer, num_bytes, &addr->addr, addr_len);
 }
 
+intptr_t SocketBase::RecvMultiple(intptr_t fd,
+                                  void* buffer,
+                                  intptr_t slot_size,
+                                  intptr_t count,
+                                  intptr_t* lengths,
+                                  SocketOpKind sync) {
+  // There is no batched receive, so receive the datagrams one at a time until
+  // no more are available.
+  uint8_t* slots = reinterpret_cast<uint8_t*>(buffer);
+  RawAddr addr;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t bytes_read =
+        RecvFrom(fd, slots + i * slot_size, slot_size, &addr, sync);
+    if (bytes_read <= 0) {
+      return ((i > 0) || (bytes_read == 0)) ? i : bytes_read;
+    }
+    lengths[i] = bytes_read;
+  }
+  return count;
+}
+
 intptr_t SocketBase::Write(intptr_t fd,
                            const void* buffer,
                            intptr_t num_bytes,
@@ -96,6 +118,49 @@ intptr_t SocketBase::Write(intptr_t fd,
   return handle->Write(buffer, num_bytes);
 }
 
+intptr_t SocketBase::WriteV(intptr_t fd,
+                            const void* const* buffers,
+                            const intptr_t* lengths,
+                            intptr_t count,
+                            SocketOpKind sync) {
+  // There is no vectored write, so write the buffers one at a time until one
+  // is not written completely.
+  intptr_t total = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = Write(fd, buffers[i], lengths[i], sync);
+    if (written_bytes < 0) {
+      return (total > 0) ? total : written_bytes;
+    }
+    total += written_bytes;
+    if (written_bytes < lengths[i]) {
+      break;
+    }
+  }
+  return total;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              File* file,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  // Read the file into a buffer and write that. Bytes that are not written
+  // are read again on the next call.
+  const intptr_t kBufferSize = IOBufferPool::kBufferSize;
+  if (!file->SetPosition(offset)) {
+    return -1;
+  }
+  uint8_t* buffer = IOBufferPool::Allocate();
+  intptr_t read_bytes = static_cast<intptr_t>(file->Read(
+      buffer, (num_bytes < kBufferSize) ? num_bytes : kBufferSize));
+  intptr_t written_bytes = read_bytes;
+  if (read_bytes > 0) {
+    written_bytes = Write(fd, buffer, read_bytes, sync);
+  }
+  IOBufferPool::Free(buffer);
+  return written_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -107,6 +172,28 @@ intptr_t SocketBase::SendTo(intptr_t fd,
                         SocketAddress::GetAddrLength(addr));
 }
 
+intptr_t SocketBase::SendToMultiple(intptr_t fd,
+                                    const void* buffer,
+                                    const intptr_t* lengths,
+                                    intptr_t count,
+                                    const RawAddr& addr,
+                                    SocketOpKind sync) {
+  // There is no batched send, so send the datagrams one at a time until one
+  // is not sent.
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer);
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t written_bytes = SendTo(fd, data, lengths[i], addr, sync);
+    if (written_bytes < 0) {
+      return (i > 0) ? i : written_bytes;
+    }
+    if (written_bytes < lengths[i]) {
+      return i;
+    }
+    data += lengths[i];
+  }
+  return count;
+}
+
 intptr_t SocketBase::GetPort(intptr_t fd) {
   ASSERT(reinterpret_cast<Handle*>(fd)->is_socket());
   SocketHandle* socket_handle = reinterpret_cast<SocketHandle*>(fd);
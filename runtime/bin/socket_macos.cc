@@ -20,6 +20,7 @@ Socket::Socket(intptr_t fd)
       fd_(fd),
       isolate_port_(Dart_GetMainPortId()),
       port_(ILLEGAL_PORT),
+      dispatch_port_(ILLEGAL_PORT),
       udp_receive_buffer_(NULL) {}
 
 void Socket::SetClosedFd() {
@@ -349,8 +349,20 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   // Handlers and receive port for socket events from the event handler.
   final List eventHandlers = new List(eventCount + 1);
   RawReceivePort eventPort;
+  int eventPortId;
   bool flagsSent = false;
 
+  // The request sending part of a file on the IO service, if any.
+  Future sendFileRequest;
+
+  // The connected sockets of this isolate by the id of their event port, and
+  // the port the event handler can post the events of several of them to in
+  // one message. The dispatch port is closed when no socket is connected, so
+  // it does not keep the isolate alive.
+  static final Map<int, _NativeSocket> _dispatchSockets =
+      new HashMap<int, _NativeSocket>();
+  static RawReceivePort _dispatchPort;
+
   // The type flags for this socket.
   final int typeFlags;
 
@@ -681,6 +693,26 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int readInto(Uint8List buffer, int offset, int count) {
+    RangeError.checkValidRange(offset, offset + count, buffer.length);
+    if (isClosing || isClosed) return 0;
+    count = min(available, count);
+    if (count == 0) return 0;
+    var result = nativeReadInto(buffer, offset, count);
+    if (result is OSError) {
+      reportError(result, "Read failed");
+      return 0;
+    }
+    available -= result;
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.totalRead += result;
+      resourceInfo.didRead();
+    }
+    return result;
+  }
+
   Datagram receive() {
     if (isClosing || isClosed) return null;
     var result = nativeRecvFrom();
@@ -752,6 +784,48 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  // Writes [buffers], starting at [offset] in the first of them, with a
+  // single native call. Returns the number of bytes written, which may end in
+  // the middle of any of the buffers.
+  int writeList(List<List<int>> buffers, int offset) {
+    if (buffers.length == 1) {
+      return write(buffers[0], offset, buffers[0].length - offset);
+    }
+    if (offset < 0 || offset > buffers[0].length) {
+      throw new RangeError.value(offset);
+    }
+    if (isClosing || isClosed) return 0;
+    var nativeBuffers = new List<List<int>>(buffers.length);
+    var offsets = new List<int>(buffers.length);
+    int bytes = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      var buffer = buffers[i];
+      int start = (i == 0) ? offset : 0;
+      _BufferAndStart bufferAndStart =
+          _ensureFastAndSerializableByteData(buffer, start, buffer.length);
+      nativeBuffers[i] = bufferAndStart.buffer;
+      offsets[i] = bufferAndStart.start;
+      bytes += buffer.length - start;
+    }
+    if (bytes == 0) return 0;
+    var result = nativeWriteListV(nativeBuffers, offsets);
+    if (result is OSError) {
+      OSError osError = result;
+      scheduleMicrotask(() => reportError(osError, "Write failed"));
+      result = 0;
+    }
+    // As for write, a negative result is a forced short write.
+    if (result >= 0 && result < bytes) {
+      writeAvailable = false;
+    }
+    if (result < 0) result = -result;
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.addWrite(result);
+    }
+    return result;
+  }
+
   int send(List<int> buffer, int offset, int bytes, InternetAddress address,
       int port) {
     _throwOnBadPort(port);
@@ -773,6 +847,86 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int sendMultiple(Uint8List buffer, Int32List ends, InternetAddress address,
+      int port) {
+    _throwOnBadPort(port);
+    if (isClosing || isClosed || ends.isEmpty) return 0;
+    var result = nativeSendToMultiple(
+        buffer, ends, (address as _InternetAddress)._in_addr, port);
+    if (result is OSError) {
+      OSError osError = result;
+      scheduleMicrotask(() => reportError(osError, "Send failed"));
+      return 0;
+    }
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null && result > 0) {
+      resourceInfo.addWrite(ends[result - 1]);
+    }
+    return result;
+  }
+
+  int receiveMultiple(Uint8List buffer, Int32List ends) {
+    if (isClosing || isClosed) return 0;
+    var result = nativeRecvMultiple(buffer, ends);
+    if (result is OSError) {
+      reportError(result, "Receive failed");
+      return 0;
+    }
+    if (result > 0) {
+      // As for receive, available is only for the next datagram.
+      available = nativeAvailable();
+      // TODO(ricow): Remove when we track internal and pipe uses.
+      assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+      if (resourceInfo != null) {
+        resourceInfo.totalRead += ends[result - 1];
+      }
+    }
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.didRead();
+    }
+    return result;
+  }
+
+  // Sends up to [count] bytes of [file] from [offset] on the IO service, so
+  // reading the file does not block this isolate. Completes with the number
+  // of bytes sent, or null if the file ended first.
+  Future<int> sendFile(RandomAccessFile file, int offset, int count) {
+    if (isClosing || isClosed) return new Future.value(0);
+    assert(sendFileRequest == null);
+    _RandomAccessFile randomAccessFile = file;
+    randomAccessFile._checkAvailable();
+    var request = [
+      nativeGetPointer(),
+      randomAccessFile._pointer(),
+      offset,
+      count
+    ];
+    sendFileRequest = _IOService._dispatch(_IOService.socketSendFile, request);
+    return sendFileRequest.then((response) {
+      sendFileRequest = null;
+      if (isClosing && !isClosed) {
+        // close() waited for the request to send the close command.
+        connectToEventHandler();
+        int data = (typeFlags & typeTypeMask) | (1 << closeCommand);
+        _EventHandler._sendData(this, eventPort.sendPort, data);
+        return 0;
+      }
+      if (isErrorResponse(response)) {
+        reportError(response, "Send file failed");
+        return 0;
+      }
+      // TODO(ricow): Remove when we track internal and pipe uses.
+      assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+      if (resourceInfo != null && response != null) {
+        resourceInfo.addWrite(response);
+      }
+      return response;
+    });
+  }
+
   _NativeSocket accept() {
     // Don't issue accept if we're closing.
     if (isClosing || isClosed) return null;
@@ -870,11 +1024,34 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     }
   }
 
-  // Multiplexes socket events to the socket handlers.
+  // Multiplexes socket events to the socket handlers. Events not sent to the
+  // dispatch port, like those of listening sockets, arrive here as either a
+  // single event mask or a list of all the event masks the event handler
+  // collected for this socket while handling one batch of events.
   void multiplex(Object eventsObj) {
-    // TODO(paulberry): when issue #31305 is fixed, we should be able to simply
-    // declare `events` as a `covariant int` parameter.
-    int events = eventsObj;
+    if (eventsObj is int) {
+      multiplexEvents(eventsObj);
+      return;
+    }
+    List<int> eventsList = eventsObj;
+    for (int i = 0; i < eventsList.length; i++) {
+      // The socket is disconnected once it is destroyed.
+      if (eventPort == null) break;
+      multiplexEvents(eventsList[i]);
+    }
+  }
+
+  // Dispatches the (event port id, events) pairs the event handler collected
+  // for the sockets of this isolate while handling one batch of events.
+  static void _dispatch(List<int> pairs) {
+    for (int i = 0; i < pairs.length; i += 2) {
+      // Sockets are removed once they are destroyed.
+      _NativeSocket socket = _dispatchSockets[pairs[i]];
+      if (socket != null) socket.multiplexEvents(pairs[i + 1]);
+    }
+  }
+
+  void multiplexEvents(int events) {
     for (int i = firstEvent; i <= lastEvent; i++) {
       if (((events & (1 << i)) != 0)) {
         if ((i == closedEvent || i == readEvent) && isClosedRead) continue;
@@ -971,7 +1148,9 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   Future close() {
     if (!isClosing && !isClosed) {
-      sendToEventHandler(1 << closeCommand);
+      // A sendFile request uses the descriptor the close command closes, so
+      // the command is sent once the request is done.
+      if (sendFileRequest == null) sendToEventHandler(1 << closeCommand);
       isClosing = true;
     }
     return closeCompleter.future;
@@ -1028,6 +1207,12 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     assert(!isClosed);
     if (eventPort == null) {
       eventPort = new RawReceivePort(multiplex);
+      if (_dispatchPort == null) {
+        _dispatchPort = new RawReceivePort(_dispatch);
+      }
+      eventPortId =
+          nativeSetDispatchPort(_dispatchPort.sendPort, eventPort.sendPort);
+      _dispatchSockets[eventPortId] = this;
     }
     if (!connectedResourceHandler) {
       registerExtension(
@@ -1041,6 +1226,11 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   void disconnectFromEventHandler() {
     assert(eventPort != null);
+    _dispatchSockets.remove(eventPortId);
+    if (_dispatchSockets.isEmpty) {
+      _dispatchPort.close();
+      _dispatchPort = null;
+    }
     eventPort.close();
     eventPort = null;
     // Now that we don't track this Socket anymore, we can clear the owner
@@ -1162,11 +1352,19 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   void nativeSetSocketId(int id, int typeFlags) native "Socket_SetSocketId";
   nativeAvailable() native "Socket_Available";
   nativeRead(int len) native "Socket_Read";
+  nativeReadInto(Uint8List buffer, int offset, int len)
+      native "Socket_ReadInto";
   nativeRecvFrom() native "Socket_RecvFrom";
+  nativeRecvMultiple(Uint8List buffer, Int32List ends)
+      native "Socket_RecvMultiple";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeWriteListV(List<List<int>> buffers, List<int> offsets)
+      native "Socket_WriteListV";
   nativeSendTo(List<int> buffer, int offset, int bytes, List<int> address,
       int port) native "Socket_SendTo";
+  nativeSendToMultiple(Uint8List buffer, Int32List ends, List<int> address,
+      int port) native "Socket_SendToMultiple";
   nativeCreateConnect(List<int> addr, int port) native "Socket_CreateConnect";
   nativeCreateBindConnect(List<int> addr, int port, List<int> sourceAddr)
       native "Socket_CreateBindConnect";
@@ -1179,6 +1377,11 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   int nativeGetPort() native "Socket_GetPort";
   List nativeGetRemotePeer() native "Socket_GetRemotePeer";
   int nativeGetSocketId() native "Socket_GetSocketId";
+  // Increments the reference count of the native socket, which the IO service
+  // request it is passed to decrements.
+  int nativeGetPointer() native "Socket_GetPointer";
+  int nativeSetDispatchPort(SendPort dispatchPort, SendPort eventPort)
+      native "Socket_SetDispatchPort";
   OSError nativeGetError() native "Socket_GetError";
   nativeGetOption(int option, int protocol) native "Socket_GetOption";
   OSError nativeGetRawOption(int level, int option, Uint8List data)
@@ -1382,9 +1585,32 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
     }
   }
 
+  int readInto(Uint8List buffer, [int offset = 0, int count]) {
+    if (offset == null) offset = 0;
+    if (count == null) count = buffer.length - offset;
+    if (_isMacOSTerminalInput) {
+      var available = this.available();
+      if (available == 0) return 0;
+      var bytes = _socket.readInto(buffer, offset, count);
+      if (bytes < min(available, count)) {
+        // Reading less than available from a Mac OS terminal indicate Ctrl-D.
+        // This is interpreted as read closed.
+        scheduleMicrotask(() => _controller.add(RawSocketEvent.readClosed));
+      }
+      return bytes;
+    }
+    return _socket.readInto(buffer, offset, count);
+  }
+
   int write(List<int> buffer, [int offset, int count]) =>
       _socket.write(buffer, offset, count);
 
+  int _writeList(List<List<int>> buffers, int offset) =>
+      _socket.writeList(buffers, offset);
+
+  Future<int> _sendFile(RandomAccessFile file, int offset, int count) =>
+      _socket.sendFile(file, offset, count);
+
   Future<RawSocket> close() => _socket.close().then<RawSocket>((_) => this);
 
   void shutdown(SocketDirection direction) => _socket.shutdown(direction);
@@ -1514,26 +1740,51 @@ class Socket {
 }
 
 class _SocketStreamConsumer extends StreamConsumer<List<int>> {
+  // While the socket does not accept more data, up to this many buffers or
+  // bytes are queued before the stream is paused. The queued buffers are
+  // written together once the socket is writable again.
+  static const int maxQueuedBuffers = 16;
+  static const int maxQueuedBytes = 64 * 1024;
+
   StreamSubscription subscription;
   final _Socket socket;
-  int offset;
-  List<int> buffer;
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int queuedBytes = 0;
+  bool waitingForWrite = false;
+  bool streamDone = false;
   bool paused = false;
   Completer streamCompleter;
+  // The file being sent by Socket.sendFile, the end of its range, and
+  // whether a part of it is being sent.
+  _SendFileStream file;
+  int fileEnd;
+  bool sendingFile = false;
 
   _SocketStreamConsumer(this.socket);
 
   Future<Socket> addStream(Stream<List<int>> stream) {
     socket._ensureRawSocketSubscription();
     streamCompleter = new Completer<Socket>();
-    if (socket._raw != null) {
+    if (stream is _SendFileStream && socket._raw is _RawSocket) {
+      _SendFileStream source = stream;
+      source.end().then((end) {
+        if (streamCompleter == null) return;
+        file = source;
+        fileEnd = end;
+        write();
+      }, onError: done);
+    } else if (socket._raw != null) {
       subscription = stream.listen((data) {
         assert(!paused);
-        assert(buffer == null);
-        buffer = data;
-        offset = 0;
+        buffers.add(data);
+        queuedBytes += data.length;
         try {
-          write();
+          if (waitingForWrite) {
+            pauseIfFull();
+          } else {
+            write();
+          }
         } catch (e) {
           socket.destroy();
           stop();
@@ -1543,7 +1794,12 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
         socket.destroy();
         done(error, stackTrace);
       }, onDone: () {
-        done();
+        // The stream is done once the queued buffers are written.
+        if (buffers.isEmpty) {
+          done();
+        } else {
+          streamDone = true;
+        }
       }, cancelOnError: true);
     }
     return streamCompleter.future;
@@ -1555,25 +1811,85 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void write() {
-    if (subscription == null) return;
-    assert(buffer != null);
+    if (file != null) {
+      writeFile();
+      return;
+    }
+    if (subscription == null || buffers.isEmpty) return;
     // Write as much as possible.
-    offset += socket._write(buffer, offset, buffer.length - offset);
-    if (offset < buffer.length) {
-      if (!paused) {
-        paused = true;
-        subscription.pause();
-      }
+    int written = socket._writeList(buffers, offset);
+    queuedBytes -= written;
+    int completed = 0;
+    while (completed < buffers.length &&
+        written >= buffers[completed].length - offset) {
+      written -= buffers[completed].length - offset;
+      offset = 0;
+      completed++;
+    }
+    buffers.removeRange(0, completed);
+    offset += written;
+    if (buffers.isNotEmpty) {
+      waitingForWrite = true;
+      pauseIfFull();
       socket._enableWriteEvent();
     } else {
-      buffer = null;
-      if (paused) {
+      waitingForWrite = false;
+      if (streamDone) {
+        streamDone = false;
+        done();
+      } else if (paused) {
         paused = false;
         subscription.resume();
       }
     }
   }
 
+  void writeFile() {
+    if (sendingFile) return;
+    // Send as much of the file as possible on the IO service.
+    _SendFileStream source = file;
+    Future<int> request;
+    try {
+      request = socket._sendFile(
+          file.file, file.position, min(fileEnd - file.position, 1 << 30));
+    } catch (e, stackTrace) {
+      socket.destroy();
+      stop();
+      done(e, stackTrace);
+      return;
+    }
+    sendingFile = true;
+    request.then((sent) {
+      sendingFile = false;
+      if (!identical(file, source)) {
+        // The consumer was stopped while the request was running, and may
+        // have been given another file since.
+        if (file != null) writeFile();
+        return;
+      }
+      if (sent == null) {
+        // The file is shorter than the range being sent.
+        fileEnd = file.position;
+      } else if (sent > 0) {
+        file.sent(sent);
+      }
+      if (file.position < fileEnd) {
+        socket._enableWriteEvent();
+      } else {
+        file = null;
+        done();
+      }
+    });
+  }
+
+  void pauseIfFull() {
+    if (!paused &&
+        (buffers.length >= maxQueuedBuffers || queuedBytes >= maxQueuedBytes)) {
+      paused = true;
+      subscription.pause();
+    }
+  }
+
   void done([error, stackTrace]) {
     if (streamCompleter != null) {
       if (error != null) {
@@ -1586,14 +1902,64 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (file != null) {
+      // Sending a file does not use the subscription.
+      file = null;
+      socket._disableWriteEvent();
+    }
     if (subscription == null) return;
     subscription.cancel();
     subscription = null;
     paused = false;
+    waitingForWrite = false;
+    streamDone = false;
     socket._disableWriteEvent();
   }
 }
 
+/// The range of a file sent by [Socket.sendFile].
+///
+/// Sockets send the range directly from the file when they can. Otherwise it
+/// is read in chunks, like any other stream added to the socket.
+class _SendFileStream extends Stream<List<int>> {
+  static const int chunkSize = 64 * 1024;
+
+  final RandomAccessFile file;
+  final int offset;
+  final int length;
+  final StreamController<int> progress = new StreamController<int>();
+  int position;
+
+  _SendFileStream(this.file, this.offset, this.length) : position = offset;
+
+  Future<int> end() {
+    if (length != null) return new Future.value(offset + length);
+    return file.length();
+  }
+
+  void sent(int bytes) {
+    position += bytes;
+    progress.add(position - offset);
+  }
+
+  StreamSubscription<List<int>> listen(void onData(List<int> event),
+      {Function onError, void onDone(), bool cancelOnError}) {
+    return _read().listen(onData,
+        onError: onError, onDone: onDone, cancelOnError: cancelOnError);
+  }
+
+  Stream<List<int>> _read() async* {
+    int end = await this.end();
+    while (position < end) {
+      await file.setPosition(position);
+      var data = await file.read(min(chunkSize, end - position));
+      if (data.isEmpty) break;
+      yield data;
+      sent(data.length);
+    }
+  }
+}
+
 class _Socket extends Stream<List<int>> implements Socket {
   RawSocket _raw; // Set to null when the raw socket is closed.
   bool _closed = false; // Set to true when the raw socket is closed.
@@ -1667,6 +2033,18 @@ class _Socket extends Stream<List<int>> implements Socket {
 
   Future flush() => _sink.flush();
 
+  Stream<int> sendFile(RandomAccessFile file, [int offset = 0, int length]) {
+    RangeError.checkNotNegative(offset, "offset");
+    if (length != null) RangeError.checkNotNegative(length, "length");
+    var source = new _SendFileStream(file, offset, length);
+    _sink.addStream(source).then((_) => source.progress.close(),
+        onError: (error, stackTrace) {
+      source.progress.addError(error, stackTrace);
+      source.progress.close();
+    });
+    return source.progress.stream;
+  }
+
   Future close() => _sink.close();
 
   Future get done => _sink.done;
@@ -1722,7 +2100,7 @@ class _Socket extends Stream<List<int>> implements Socket {
     _detachReady = new Completer();
     _sink.close();
     return _detachReady.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -1800,8 +2178,23 @@ class _Socket extends Stream<List<int>> implements Socket {
     _consumer.done(error, stackTrace);
   }
 
-  int _write(List<int> data, int offset, int length) =>
-      _raw.write(data, offset, length);
+  Future<int> _sendFile(RandomAccessFile file, int offset, int count) =>
+      (_raw as _RawSocket)._sendFile(file, offset, count);
+
+  int _writeList(List<List<int>> buffers, int offset) {
+    var raw = _raw;
+    if (raw is _RawSocket) return raw._writeList(buffers, offset);
+    // Secure sockets take one buffer at a time.
+    int written = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      var buffer = buffers[i];
+      int start = (i == 0) ? offset : 0;
+      int bytes = raw.write(buffer, start, buffer.length - start);
+      written += bytes;
+      if (bytes < buffer.length - start) break;
+    }
+    return written;
+  }
 
   void _enableWriteEvent() {
     _raw.writeEventsEnabled = true;
@@ -1897,6 +2290,25 @@ class _RawDatagramSocket extends Stream<RawSocketEvent>
     return _socket.receive();
   }
 
+  int sendMultiple(
+      Uint8List buffer, Int32List ends, InternetAddress address, int port) {
+    int start = 0;
+    for (int i = 0; i < ends.length; i++) {
+      RangeError.checkValueInInterval(ends[i], start, buffer.length, "ends");
+      start = ends[i];
+    }
+    return _socket.sendMultiple(buffer, ends, address, port);
+  }
+
+  int receiveMultiple(Uint8List buffer, Int32List ends) {
+    if (ends.isEmpty || buffer.length < ends.length) {
+      throw new ArgumentError(
+          "Buffer of length ${buffer.length} has no room for "
+          "${ends.length} datagrams");
+    }
+    return _socket.receiveMultiple(buffer, ends);
+  }
+
   void joinMulticast(InternetAddress group, [NetworkInterface interface]) {
     _socket.joinMulticast(group, interface);
   }
@@ -126,8 +126,32 @@ abstract class _HashBase implements _HashVMBase {
 }
 
 class _OperatorEqualsAndHashCode {
-  int _hashCode(e) => e.hashCode;
-  bool _equals(e1, e2) => e1 == e2;
+  // Smi and one-byte string keys are dispatched at their own call sites. The
+  // calls on them stay monomorphic, and are inlined, even when a program uses
+  // maps and sets with many other key classes.
+  int _hashCode(e) {
+    final int cid = internal.ClassID.getID(e);
+    if (cid == internal.ClassID.cidSmi) {
+      return internal.unsafeCast<int>(e); // _Smi.hashCode is the value.
+    }
+    if (cid == internal.ClassID.cidOneByteString) {
+      return internal.unsafeCast<String>(e).hashCode;
+    }
+    return e.hashCode;
+  }
+
+  bool _equals(e1, e2) {
+    final int cid = internal.ClassID.getID(e1);
+    if (cid == internal.ClassID.cidSmi) {
+      // An integer equal to a Smi is the same Smi. Integral doubles are equal
+      // to integers too.
+      return identical(e1, e2) || (e2 is double && e1 == e2);
+    }
+    if (cid == internal.ClassID.cidOneByteString) {
+      return identical(e1, e2) || internal.unsafeCast<String>(e1) == e2;
+    }
+    return e1 == e2;
+  }
 }
 
 class _IdenticalAndIdentityHashCode {
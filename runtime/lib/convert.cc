@@ -0,0 +1,925 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/bootstrap_natives.h"
+
+#include "vm/dart_entry.h"
+#include "vm/double_conversion.h"
+#include "vm/exceptions.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/symbols.h"
+#include "vm/unicode.h"
+
+namespace dart {
+
+// Resolves a Uint8List (internal, external or a view) to the typed data
+// object holding its bytes and the offset of the list's first byte in it.
+// Returns false for any other implementation of Uint8List, e.g.
+// UnmodifiableUint8ListView or a user-defined class. The natives return null
+// for those and leave them to the Dart code.
+static bool GetUint8ListBacking(const Instance& list,
+                                Instance* backing,
+                                intptr_t* offset_in_bytes,
+                                intptr_t* length) {
+  switch (list.GetClassId()) {
+    case kTypedDataUint8ArrayCid:
+    case kExternalTypedDataUint8ArrayCid:
+      *backing = list.raw();
+      *offset_in_bytes = 0;
+      *length = list.IsTypedData() ? TypedData::Cast(list).Length()
+                                   : ExternalTypedData::Cast(list).Length();
+      return true;
+    case kTypedDataUint8ArrayViewCid:
+      *backing = TypedDataView::Data(list);
+      *offset_in_bytes = Smi::Value(TypedDataView::OffsetInBytes(list));
+      *length = Smi::Value(TypedDataView::Length(list));
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The returned pointer is only valid until the next safepoint because
+// internal typed data can be moved by the GC.
+static const uint8_t* Uint8ListData(const Instance& backing,
+                                    intptr_t offset_in_bytes) {
+  const uint8_t* data =
+      backing.IsTypedData()
+          ? reinterpret_cast<const uint8_t*>(
+                TypedData::Cast(backing).DataAddr(0))
+          : reinterpret_cast<const uint8_t*>(
+                ExternalTypedData::Cast(backing).DataAddr(0));
+  return data + offset_in_bytes;
+}
+
+// Returns the number of leading bytes in [data] which are below 0x80.
+// Examines a word at a time.
+static intptr_t CountAsciiPrefix(const uint8_t* data, intptr_t length) {
+  const uintptr_t kHighBits = static_cast<uintptr_t>(0x8080808080808080ULL);
+  intptr_t i = 0;
+  for (; i + kWordSize <= length; i += kWordSize) {
+    uintptr_t word;
+    memmove(&word, data + i, kWordSize);
+    if ((word & kHighBits) != 0) {
+      break;
+    }
+  }
+  while ((i < length) && (data[i] < 0x80)) {
+    i++;
+  }
+  return i;
+}
+
+static void ThrowIfInvalidRange(intptr_t start,
+                                intptr_t end,
+                                intptr_t length) {
+  if ((start < 0) || (start > end) || (end > length)) {
+    Exceptions::ThrowRangeError("start", Integer::Handle(Integer::New(start)),
+                                0, length);
+  }
+}
+
+// Returns the number of bytes in the Uint8List [units] starting at [from]
+// which are below 0x80, or null if [units] is not handled natively.
+DEFINE_NATIVE_ENTRY(Utf8_scanOneByteCharacters, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, units, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, from, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end, arguments->NativeArgAt(2));
+  Instance& backing = Instance::Handle(zone);
+  intptr_t offset_in_bytes = 0;
+  intptr_t length = 0;
+  if (!GetUint8ListBacking(units, &backing, &offset_in_bytes, &length)) {
+    return Object::null();
+  }
+  ThrowIfInvalidRange(from.Value(), end.Value(), length);
+  NoSafepointScope no_safepoint;
+  const uint8_t* data = Uint8ListData(backing, offset_in_bytes);
+  return Smi::New(
+      CountAsciiPrefix(data + from.Value(), end.Value() - from.Value()));
+}
+
+// Decodes the UTF-8 bytes [start, end) of a Uint8List into a new string.
+// Strings with only Latin-1 characters are created as one-byte strings.
+// Returns null if the bytes are not valid UTF-8 so that the caller can
+// report the error or substitute replacement characters, and if [units] is
+// not handled natively.
+DEFINE_NATIVE_ENTRY(Utf8_decode, 0, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, units, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, strip_bom, arguments->NativeArgAt(3));
+  Instance& backing = Instance::Handle(zone);
+  intptr_t offset_in_bytes = 0;
+  intptr_t list_length = 0;
+  if (!GetUint8ListBacking(units, &backing, &offset_in_bytes, &list_length)) {
+    return String::null();
+  }
+  ThrowIfInvalidRange(start_obj.Value(), end_obj.Value(), list_length);
+  offset_in_bytes += start_obj.Value();
+  intptr_t length = end_obj.Value() - start_obj.Value();
+
+  intptr_t ascii_length = 0;
+  intptr_t code_units = 0;
+  Utf8::Type type = Utf8::kLatin1;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = Uint8ListData(backing, offset_in_bytes);
+    if (strip_bom.value() && (length >= 3) && (data[0] == 0xEF) &&
+        (data[1] == 0xBB) && (data[2] == 0xBF)) {
+      data += 3;
+      offset_in_bytes += 3;
+      length -= 3;
+    }
+    ascii_length = CountAsciiPrefix(data, length);
+    code_units = ascii_length;
+    if (ascii_length < length) {
+      if (!Utf8::IsValid(data + ascii_length, length - ascii_length)) {
+        return String::null();
+      }
+      code_units += Utf8::CodeUnitCount(data + ascii_length,
+                                        length - ascii_length, &type);
+    }
+  }
+
+  if (type == Utf8::kLatin1) {
+    const String& result =
+        String::Handle(zone, OneByteString::New(code_units, Heap::kNew));
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = Uint8ListData(backing, offset_in_bytes);
+    uint8_t* dst = OneByteString::DataStart(result);
+    memmove(dst, data, ascii_length);
+    if (ascii_length < length) {
+      const bool ok = Utf8::DecodeToLatin1(
+          data + ascii_length, length - ascii_length, dst + ascii_length,
+          code_units - ascii_length);
+      ASSERT(ok);
+    }
+    return result.raw();
+  }
+
+  const String& result =
+      String::Handle(zone, TwoByteString::New(code_units, Heap::kNew));
+  NoSafepointScope no_safepoint;
+  const uint8_t* data = Uint8ListData(backing, offset_in_bytes);
+  uint16_t* dst = TwoByteString::DataStart(result);
+  for (intptr_t i = 0; i < ascii_length; i++) {
+    dst[i] = data[i];
+  }
+  const bool ok =
+      Utf8::DecodeToUTF16(data + ascii_length, length - ascii_length,
+                          dst + ascii_length, code_units - ascii_length);
+  ASSERT(ok);
+  return result.raw();
+}
+
+// Encodes the characters [start, end) of a one-byte string as UTF-8.
+DEFINE_NATIVE_ENTRY(Utf8_encodeOneByteString, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, string, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  ASSERT(string.IsOneByteString());
+  ThrowIfInvalidRange(start_obj.Value(), end_obj.Value(), string.Length());
+  const intptr_t start = start_obj.Value();
+  const intptr_t length = end_obj.Value() - start;
+
+  // Latin-1 characters above 0x7F take two bytes.
+  intptr_t ascii_length = 0;
+  intptr_t utf8_length = length;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* src = OneByteString::DataStart(string) + start;
+    ascii_length = CountAsciiPrefix(src, length);
+    for (intptr_t i = ascii_length; i < length; i++) {
+      utf8_length += src[i] >> 7;
+    }
+  }
+
+  const TypedData& result = TypedData::Handle(
+      zone, TypedData::New(kTypedDataUint8ArrayCid, utf8_length));
+  NoSafepointScope no_safepoint;
+  const uint8_t* src = OneByteString::DataStart(string) + start;
+  uint8_t* dst = reinterpret_cast<uint8_t*>(result.DataAddr(0));
+  memmove(dst, src, ascii_length);
+  intptr_t j = ascii_length;
+  for (intptr_t i = ascii_length; i < length; i++) {
+    const uint8_t c = src[i];
+    if (c < 0x80) {
+      dst[j++] = c;
+    } else {
+      dst[j++] = 0xC0 | (c >> 6);
+      dst[j++] = 0x80 | (c & 0x3F);
+    }
+  }
+  ASSERT(j == utf8_length);
+  return result.raw();
+}
+
+// Nesting depth above which the native JSON parser and encoder give up and
+// leave the input to the Dart implementation, which does not recurse.
+static const intptr_t kMaxJsonDepth = 512;
+
+// Integer literals with more digits may not fit into 64 bits. The Dart parser
+// turns those into doubles.
+static const intptr_t kMaxJsonIntegerDigits = 18;
+
+// Parses a complete JSON text into the same objects as the Dart
+// _BuildJsonListener: _GrowableList for arrays and _InternalLinkedHashMap
+// with <String, dynamic> type arguments for objects.
+//
+// [CharType] is uint8_t for Latin-1 and UTF-8 input and uint16_t for UTF-16
+// input. The input is owned by the parser so that it does not move when the
+// GC runs. Any input which is malformed or which the parser does not handle
+// makes Parse return false. The caller then falls back to the Dart parser,
+// which reports errors with the expected messages and offsets.
+template <typename CharType, bool kIsUtf8>
+class JsonParser : public ValueObject {
+ public:
+  JsonParser(Thread* thread, const CharType* data, intptr_t length)
+      : thread_(thread),
+        zone_(thread->zone()),
+        data_(data),
+        length_(length),
+        position_(0),
+        maps_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+        map_type_arguments_(TypeArguments::Handle(
+            zone_,
+            thread->isolate()->object_store()->type_argument_string_dynamic())),
+        chars_(zone_, 0) {}
+
+  bool Parse(Object* result) {
+    SkipWhitespace();
+    if (!ParseValue(0, result)) {
+      return false;
+    }
+    SkipWhitespace();
+    if (position_ != length_) {
+      return false;
+    }
+    RehashMaps();
+    return true;
+  }
+
+ private:
+  bool AtEnd() const { return position_ >= length_; }
+  uint32_t Peek() const { return data_[position_]; }
+
+  void SkipWhitespace() {
+    while (!AtEnd()) {
+      const uint32_t c = Peek();
+      if ((c != ' ') && (c != '\t') && (c != '\n') && (c != '\r')) {
+        return;
+      }
+      position_++;
+    }
+  }
+
+  bool ParseValue(intptr_t depth, Object* result) {
+    if (AtEnd() || (depth > kMaxJsonDepth)) {
+      return false;
+    }
+    switch (Peek()) {
+      case '{':
+        return ParseObject(depth, result);
+      case '[':
+        return ParseArray(depth, result);
+      case '"':
+        return ParseString(result);
+      case 't':
+        *result = Bool::True().raw();
+        return ParseKeyword("true");
+      case 'f':
+        *result = Bool::False().raw();
+        return ParseKeyword("false");
+      case 'n':
+        *result = Object::null();
+        return ParseKeyword("null");
+      default:
+        return ParseNumber(result);
+    }
+  }
+
+  bool ParseKeyword(const char* keyword) {
+    for (; *keyword != '\0'; keyword++, position_++) {
+      if (AtEnd() || (Peek() != static_cast<uint8_t>(*keyword))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseArray(intptr_t depth, Object* result) {
+    HANDLESCOPE(thread_);
+    ASSERT(Peek() == '[');
+    position_++;
+    const GrowableObjectArray& list =
+        GrowableObjectArray::Handle(zone_, GrowableObjectArray::New());
+    Object& element = Object::Handle(zone_);
+    SkipWhitespace();
+    if (!AtEnd() && (Peek() == ']')) {
+      position_++;
+      *result = list.raw();
+      return true;
+    }
+    while (true) {
+      SkipWhitespace();
+      if (!ParseValue(depth + 1, &element)) {
+        return false;
+      }
+      list.Add(element);
+      SkipWhitespace();
+      if (AtEnd()) {
+        return false;
+      }
+      const uint32_t c = Peek();
+      position_++;
+      if (c == ']') {
+        break;
+      }
+      if (c != ',') {
+        return false;
+      }
+    }
+    *result = list.raw();
+    return true;
+  }
+
+  bool ParseObject(intptr_t depth, Object* result) {
+    HANDLESCOPE(thread_);
+    ASSERT(Peek() == '{');
+    position_++;
+    // Keys and values are collected in order and copied into the data array
+    // of the map, whose index is built by RehashMaps.
+    const GrowableObjectArray& pairs =
+        GrowableObjectArray::Handle(zone_, GrowableObjectArray::New());
+    Object& object = Object::Handle(zone_);
+    SkipWhitespace();
+    if (!AtEnd() && (Peek() == '}')) {
+      position_++;
+      *result = MakeMap(pairs);
+      return true;
+    }
+    while (true) {
+      SkipWhitespace();
+      if (AtEnd() || (Peek() != '"') || !ParseString(&object)) {
+        return false;
+      }
+      pairs.Add(object);
+      SkipWhitespace();
+      if (AtEnd() || (Peek() != ':')) {
+        return false;
+      }
+      position_++;
+      SkipWhitespace();
+      if (!ParseValue(depth + 1, &object)) {
+        return false;
+      }
+      pairs.Add(object);
+      SkipWhitespace();
+      if (AtEnd()) {
+        return false;
+      }
+      const uint32_t c = Peek();
+      position_++;
+      if (c == '}') {
+        break;
+      }
+      if (c != ',') {
+        return false;
+      }
+    }
+    *result = MakeMap(pairs);
+    return true;
+  }
+
+  RawLinkedHashMap* MakeMap(const GrowableObjectArray& pairs) {
+    const intptr_t used_data = pairs.Length();
+    const intptr_t data_size = Utils::Maximum(
+        Utils::RoundUpToPowerOfTwo(used_data),
+        static_cast<uintptr_t>(LinkedHashMap::kInitialIndexSize));
+    const Array& data = Array::Handle(zone_, Array::New(data_size));
+    Object& object = Object::Handle(zone_);
+    for (intptr_t i = 0; i < used_data; i++) {
+      object = pairs.At(i);
+      data.SetAt(i, object);
+    }
+    // Like maps read from snapshots, the index is regenerated by Dart code
+    // once the whole input has been parsed.
+    const LinkedHashMap& map = LinkedHashMap::Handle(
+        zone_, LinkedHashMap::New(data, TypedData::Handle(zone_), 0, used_data,
+                                  0));
+    map.SetTypeArguments(map_type_arguments_);
+    maps_.Add(map);
+    return map.raw();
+  }
+
+  void RehashMaps() {
+    if (maps_.Length() == 0) {
+      return;
+    }
+    const Library& collection_lib =
+        Library::Handle(zone_, Library::CollectionLibrary());
+    const Function& rehashing_function = Function::Handle(
+        zone_,
+        collection_lib.LookupFunctionAllowPrivate(Symbols::_rehashObjects()));
+    ASSERT(!rehashing_function.IsNull());
+    const Array& arguments = Array::Handle(zone_, Array::New(1));
+    arguments.SetAt(0, maps_);
+    const Object& result = Object::Handle(
+        zone_, DartEntry::InvokeFunction(rehashing_function, arguments));
+    if (result.IsError()) {
+      Exceptions::PropagateError(Error::Cast(result));
+    }
+  }
+
+  static bool IsPlainCharacter(uint32_t c) {
+    return (c >= 0x20) && (c != '"') && (c != '\\') && (!kIsUtf8 || c < 0x80);
+  }
+
+  bool ParseString(Object* result) {
+    ASSERT(Peek() == '"');
+    position_++;
+    const intptr_t start = position_;
+    while (!AtEnd() && IsPlainCharacter(Peek())) {
+      position_++;
+    }
+    if (AtEnd()) {
+      return false;
+    }
+    if (Peek() == '"') {
+      // No escapes and no multi-byte sequences: the characters can be copied
+      // as they are.
+      const CharType* chars = data_ + start;
+      const intptr_t length = position_ - start;
+      position_++;
+      if (sizeof(CharType) == 1) {
+        *result = String::FromLatin1(reinterpret_cast<const uint8_t*>(chars),
+                                     length);
+      } else {
+        *result = String::FromUTF16(reinterpret_cast<const uint16_t*>(chars),
+                                    length);
+      }
+      return true;
+    }
+    chars_.Clear();
+    for (intptr_t i = start; i < position_; i++) {
+      chars_.Add(data_[i]);
+    }
+    return ParseStringWithEscapes(result);
+  }
+
+  bool ParseStringWithEscapes(Object* result) {
+    while (!AtEnd()) {
+      const uint32_t c = Peek();
+      if (c == '"') {
+        position_++;
+        *result = String::FromUTF16(chars_.data(), chars_.length());
+        return true;
+      }
+      if (c < 0x20) {
+        return false;
+      }
+      if (c == '\\') {
+        position_++;
+        if (!ParseEscape()) {
+          return false;
+        }
+      } else if (kIsUtf8 && (c >= 0x80)) {
+        if (!DecodeUtf8Character()) {
+          return false;
+        }
+      } else {
+        chars_.Add(c);
+        position_++;
+      }
+    }
+    return false;
+  }
+
+  bool ParseEscape() {
+    if (AtEnd()) {
+      return false;
+    }
+    const uint32_t c = Peek();
+    position_++;
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        chars_.Add(c);
+        return true;
+      case 'b':
+        chars_.Add('\b');
+        return true;
+      case 'f':
+        chars_.Add('\f');
+        return true;
+      case 'n':
+        chars_.Add('\n');
+        return true;
+      case 'r':
+        chars_.Add('\r');
+        return true;
+      case 't':
+        chars_.Add('\t');
+        return true;
+      case 'u': {
+        // Surrogates are not paired up or checked, as in the Dart parser.
+        uint32_t value = 0;
+        for (intptr_t i = 0; i < 4; i++, position_++) {
+          if (AtEnd()) {
+            return false;
+          }
+          const uint32_t digit = Peek();
+          if ((digit >= '0') && (digit <= '9')) {
+            value = (value << 4) | (digit - '0');
+          } else if (((digit | 0x20) >= 'a') && ((digit | 0x20) <= 'f')) {
+            value = (value << 4) | ((digit | 0x20) - 'a' + 10);
+          } else {
+            return false;
+          }
+        }
+        chars_.Add(value);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool DecodeUtf8Character() {
+    int32_t ch = -1;
+    const intptr_t consumed = Utf8::Decode(
+        reinterpret_cast<const uint8_t*>(data_ + position_),
+        length_ - position_, &ch);
+    // Encoded surrogates are left to the Dart decoder.
+    if ((ch < 0) || Utf16::IsSurrogate(ch)) {
+      return false;
+    }
+    position_ += consumed;
+    if (Utf::IsSupplementary(ch)) {
+      uint16_t pair[2];
+      Utf16::Encode(ch, pair);
+      chars_.Add(pair[0]);
+      chars_.Add(pair[1]);
+    } else {
+      chars_.Add(ch);
+    }
+    return true;
+  }
+
+  static bool IsDigit(uint32_t c) { return (c >= '0') && (c <= '9'); }
+
+  bool ParseNumber(Object* result) {
+    // '-'?('0'|[1-9][0-9]*)('.'[0-9]+)?([eE][+-]?[0-9]+)?
+    const intptr_t start = position_;
+    bool negative = false;
+    if (Peek() == '-') {
+      negative = true;
+      position_++;
+    }
+    if (AtEnd() || !IsDigit(Peek())) {
+      return false;
+    }
+    int64_t value = 0;
+    intptr_t digits = 0;
+    if (Peek() == '0') {
+      position_++;
+      digits = 1;
+      if (!AtEnd() && IsDigit(Peek())) {
+        return false;
+      }
+    } else {
+      while (!AtEnd() && IsDigit(Peek())) {
+        value = value * 10 + (Peek() - '0');
+        digits++;
+        position_++;
+      }
+    }
+    bool is_double = false;
+    if (!AtEnd() && (Peek() == '.')) {
+      is_double = true;
+      position_++;
+      if (AtEnd() || !IsDigit(Peek())) {
+        return false;
+      }
+      while (!AtEnd() && IsDigit(Peek())) {
+        position_++;
+      }
+    }
+    if (!AtEnd() && ((Peek() | 0x20) == 'e')) {
+      is_double = true;
+      position_++;
+      if (!AtEnd() && ((Peek() == '+') || (Peek() == '-'))) {
+        position_++;
+      }
+      if (AtEnd() || !IsDigit(Peek())) {
+        return false;
+      }
+      while (!AtEnd() && IsDigit(Peek())) {
+        position_++;
+      }
+    }
+    if (!is_double) {
+      if (digits > kMaxJsonIntegerDigits) {
+        return false;
+      }
+      *result = Integer::New(negative ? -value : value);
+      return true;
+    }
+    // Number literals are ASCII, so they can be narrowed for the double
+    // parser. Overly long literals are left to the Dart parser.
+    const intptr_t kBufferSize = 64;
+    const intptr_t length = position_ - start;
+    if (length >= kBufferSize) {
+      return false;
+    }
+    char buffer[kBufferSize];
+    for (intptr_t i = 0; i < length; i++) {
+      buffer[i] = static_cast<char>(data_[start + i]);
+    }
+    buffer[length] = '\0';
+    double double_value = 0.0;
+    if (!CStringToDouble(buffer, length, &double_value)) {
+      return false;
+    }
+    *result = Double::New(double_value);
+    return true;
+  }
+
+  Thread* thread_;
+  Zone* zone_;
+  const CharType* data_;
+  const intptr_t length_;
+  intptr_t position_;
+  const GrowableObjectArray& maps_;
+  const TypeArguments& map_type_arguments_;
+  GrowableArray<uint16_t> chars_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonParser);
+};
+
+template <typename CharType, bool kIsUtf8>
+static RawObject* ParseJson(Thread* thread,
+                            const CharType* data,
+                            intptr_t length) {
+  JsonParser<CharType, kIsUtf8> parser(thread, data, length);
+  Object& result = Object::Handle(thread->zone());
+  if (!parser.Parse(&result)) {
+    return Object::null();
+  }
+  return result.raw();
+}
+
+// Parses the JSON text [source]. Returns null if the text is malformed or not
+// handled natively, including when it is the literal null. External strings
+// are not handled.
+DEFINE_NATIVE_ENTRY(Json_parseString, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, source, arguments->NativeArgAt(0));
+  const intptr_t length = source.Length();
+  if (source.IsOneByteString()) {
+    uint8_t* data = zone->Alloc<uint8_t>(length);
+    {
+      NoSafepointScope no_safepoint;
+      memmove(data, OneByteString::DataStart(source), length);
+    }
+    return ParseJson<uint8_t, false>(thread, data, length);
+  }
+  if (source.IsTwoByteString()) {
+    uint16_t* data = zone->Alloc<uint16_t>(length);
+    {
+      NoSafepointScope no_safepoint;
+      memmove(data, TwoByteString::DataStart(source),
+              length * sizeof(uint16_t));
+    }
+    return ParseJson<uint16_t, false>(thread, data, length);
+  }
+  return Object::null();
+}
+
+// Parses the UTF-8 encoded JSON text in the bytes [start, end) of a
+// Uint8List. A leading byte order mark is skipped. Returns null if the text
+// is malformed or not handled natively.
+DEFINE_NATIVE_ENTRY(Json_parseUtf8, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, units, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  Instance& backing = Instance::Handle(zone);
+  intptr_t offset_in_bytes = 0;
+  intptr_t list_length = 0;
+  if (!GetUint8ListBacking(units, &backing, &offset_in_bytes, &list_length)) {
+    return Object::null();
+  }
+  ThrowIfInvalidRange(start_obj.Value(), end_obj.Value(), list_length);
+  intptr_t length = end_obj.Value() - start_obj.Value();
+  uint8_t* data = zone->Alloc<uint8_t>(length);
+  {
+    NoSafepointScope no_safepoint;
+    memmove(data, Uint8ListData(backing, offset_in_bytes + start_obj.Value()),
+            length);
+  }
+  if ((length >= 3) && (data[0] == 0xEF) && (data[1] == 0xBB) &&
+      (data[2] == 0xBF)) {
+    data += 3;
+    length -= 3;
+  }
+  return ParseJson<uint8_t, true>(thread, data, length);
+}
+
+// Writes the JSON encoding of the values handled by the Dart
+// _JsonStringifier.writeJsonValue without calling into Dart: null, booleans,
+// finite numbers, strings, lists and maps with string keys implemented by
+// the core library. Any other object makes Write return false so that the
+// caller falls back to the Dart encoder, which calls toEncodable and detects
+// cycles.
+class JsonWriter : public ValueObject {
+ public:
+  explicit JsonWriter(Zone* zone) : zone_(zone), buffer_(zone, 256) {}
+
+  bool Write(const Object& object, intptr_t depth) {
+    if (depth > kMaxJsonDepth) {
+      return false;
+    }
+    switch (object.GetClassId()) {
+      case kNullCid:
+        WriteAscii("null");
+        return true;
+      case kBoolCid:
+        WriteAscii(Bool::Cast(object).value() ? "true" : "false");
+        return true;
+      case kSmiCid:
+      case kMintCid:
+        WriteAscii(Integer::Cast(object).ToCString());
+        return true;
+      case kDoubleCid: {
+        const double value = Double::Cast(object).value();
+        if (isnan(value) || isinf(value)) {
+          return false;
+        }
+        WriteAscii(Double::Cast(object).ToCString());
+        return true;
+      }
+      case kOneByteStringCid:
+      case kTwoByteStringCid:
+      case kExternalOneByteStringCid:
+      case kExternalTwoByteStringCid:
+        WriteString(String::Cast(object));
+        return true;
+      case kArrayCid:
+      case kImmutableArrayCid:
+        return WriteArray(Array::Cast(object), Array::Cast(object).Length(),
+                          depth);
+      case kGrowableObjectArrayCid: {
+        const GrowableObjectArray& list = GrowableObjectArray::Cast(object);
+        return WriteArray(Array::Handle(zone_, list.data()), list.Length(),
+                          depth);
+      }
+      case kLinkedHashMapCid:
+        return WriteMap(LinkedHashMap::Cast(object), depth);
+      default:
+        return false;
+    }
+  }
+
+  RawString* ToString() const {
+    return String::FromUTF16(buffer_.data(), buffer_.length());
+  }
+
+ private:
+  void WriteAscii(const char* chars) {
+    for (; *chars != '\0'; chars++) {
+      buffer_.Add(*chars);
+    }
+  }
+
+  void WriteString(const String& string) {
+    NoSafepointScope no_safepoint;
+    switch (string.GetClassId()) {
+      case kOneByteStringCid:
+        WriteStringContent(OneByteString::DataStart(string), string.Length());
+        break;
+      case kTwoByteStringCid:
+        WriteStringContent(TwoByteString::DataStart(string), string.Length());
+        break;
+      default: {
+        // External strings are rare in JSON output and are read a character
+        // at a time.
+        const intptr_t length = string.Length();
+        uint16_t* chars = zone_->Alloc<uint16_t>(length);
+        for (intptr_t i = 0; i < length; i++) {
+          chars[i] = string.CharAt(i);
+        }
+        WriteStringContent(chars, length);
+        break;
+      }
+    }
+  }
+
+  template <typename CharType>
+  void WriteStringContent(const CharType* chars, intptr_t length) {
+    static const char kHexDigits[] = "0123456789abcdef";
+    buffer_.Add('"');
+    for (intptr_t i = 0; i < length; i++) {
+      const uint16_t c = chars[i];
+      if (c > '\\') {
+        buffer_.Add(c);
+      } else if (c < 0x20) {
+        buffer_.Add('\\');
+        switch (c) {
+          case '\b':
+            buffer_.Add('b');
+            break;
+          case '\t':
+            buffer_.Add('t');
+            break;
+          case '\n':
+            buffer_.Add('n');
+            break;
+          case '\f':
+            buffer_.Add('f');
+            break;
+          case '\r':
+            buffer_.Add('r');
+            break;
+          default:
+            buffer_.Add('u');
+            buffer_.Add('0');
+            buffer_.Add('0');
+            buffer_.Add(kHexDigits[c >> 4]);
+            buffer_.Add(kHexDigits[c & 0xF]);
+            break;
+        }
+      } else {
+        if ((c == '"') || (c == '\\')) {
+          buffer_.Add('\\');
+        }
+        buffer_.Add(c);
+      }
+    }
+    buffer_.Add('"');
+  }
+
+  bool WriteArray(const Array& elements, intptr_t length, intptr_t depth) {
+    HANDLESCOPE(Thread::Current());
+    Object& element = Object::Handle(zone_);
+    buffer_.Add('[');
+    for (intptr_t i = 0; i < length; i++) {
+      if (i > 0) {
+        buffer_.Add(',');
+      }
+      element = elements.At(i);
+      if (!Write(element, depth + 1)) {
+        return false;
+      }
+    }
+    buffer_.Add(']');
+    return true;
+  }
+
+  bool WriteMap(const LinkedHashMap& map, intptr_t depth) {
+    HANDLESCOPE(Thread::Current());
+    Object& key = Object::Handle(zone_);
+    Object& value = Object::Handle(zone_);
+    LinkedHashMap::Iterator iterator(map);
+    bool first = true;
+    buffer_.Add('{');
+    while (iterator.MoveNext()) {
+      key = iterator.CurrentKey();
+      if (!key.IsString()) {
+        return false;
+      }
+      if (!first) {
+        buffer_.Add(',');
+      }
+      first = false;
+      WriteString(String::Cast(key));
+      buffer_.Add(':');
+      value = iterator.CurrentValue();
+      if (!Write(value, depth + 1)) {
+        return false;
+      }
+    }
+    buffer_.Add('}');
+    return true;
+  }
+
+  Zone* zone_;
+  GrowableArray<uint16_t> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonWriter);
+};
+
+// Returns the JSON encoding of [object] without indentation, or null if the
+// object graph contains values which are left to the Dart encoder.
+DEFINE_NATIVE_ENTRY(Json_encode, 0, 1) {
+  GET_NATIVE_ARGUMENT(Instance, object, arguments->NativeArgAt(0));
+  JsonWriter writer(zone);
+  if (!writer.Write(object, 0)) {
+    return String::null();
+  }
+  return writer.ToString();
+}
+
+}  // namespace dart
@@ -17,6 +17,12 @@ import "dart:typed_data" show Uint8List, Uint16List;
 
 @patch
 _parseJson(String source, reviver(key, value)) {
+  if (reviver == null && source != null) {
+    // Text which the runtime does not handle is parsed below, which also
+    // reports any errors.
+    final result = _parseJsonString(source);
+    if (result != null) return result;
+  }
   _BuildJsonListener listener;
   if (reviver == null) {
     listener = new _BuildJsonListener();
@@ -31,6 +37,25 @@ _parseJson(String source, reviver(key, value)) {
   return listener.result;
 }
 
+@patch
+class JsonEncoder {
+  // Allow intercepting of single-line JSON encoding.
+  @patch
+  static String _convertIntercepted(Object object) => _encodeJson(object);
+}
+
+// Returns the parsed JSON [source], or null if [source] is malformed, is the
+// literal null, or is not handled by the runtime.
+_parseJsonString(String source) native "Json_parseString";
+
+// Like [_parseJsonString] for the UTF-8 encoded bytes of [source] from
+// [start] to [end].
+_parseJsonUtf8(Uint8List source, int start, int end) native "Json_parseUtf8";
+
+// Returns the JSON encoding of [object], or null if it contains values that
+// are left to [_JsonStringStringifier].
+String _encodeJson(Object object) native "Json_encode";
+
 @patch
 class Utf8Decoder {
   @patch
@@ -48,10 +73,44 @@ class Utf8Decoder {
   @patch
   static String _convertIntercepted(
       bool allowMalformed, List<int> codeUnits, int start, int end) {
+    if (codeUnits is Uint8List) {
+      end = RangeError.checkValidRange(start, end, codeUnits.length);
+      // Malformed input and lists the runtime can't read directly are left
+      // to the Dart decoder, which reports errors or substitutes replacement
+      // characters.
+      return _decodeUtf8(codeUnits, start, end, true);
+    }
+    return null; // This call was not intercepted.
+  }
+}
+
+@patch
+class Utf8Encoder {
+  // Allow intercepting of UTF-8 encoding of one-byte strings.
+  @patch
+  static List<int> _convertIntercepted(String string, int start, int end) {
+    if (ClassID.getID(string) == ClassID.cidOneByteString) {
+      return _encodeOneByteStringAsUtf8(string, start, end);
+    }
     return null; // This call was not intercepted.
   }
 }
 
+// Decodes the UTF-8 bytes of [codeUnits] from [start] to [end], skipping a
+// leading byte order mark if [stripBom] is true. Returns null if the bytes are
+// not valid UTF-8 or [codeUnits] is not a Uint8List the runtime can read
+// directly, e.g. an UnmodifiableUint8ListView.
+String _decodeUtf8(Uint8List codeUnits, int start, int end, bool stripBom)
+    native "Utf8_decode";
+
+Uint8List _encodeOneByteStringAsUtf8(String string, int start, int end)
+    native "Utf8_encodeOneByteString";
+
+// Returns the number of leading bytes below 0x80 in [units] from [from] to
+// [end], or null if [units] is not a Uint8List the runtime can read directly.
+int _scanOneByteCharactersInUint8List(Uint8List units, int from, int end)
+    native "Utf8_scanOneByteCharacters";
+
 class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   final _Reviver _reviver;
   final bool _allowMalformed;
@@ -59,6 +118,10 @@ class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   _JsonUtf8Decoder(this._reviver, this._allowMalformed);
 
   Object convert(List<int> input) {
+    if (_reviver == null && input is Uint8List) {
+      final result = _parseJsonUtf8(input, 0, input.length);
+      if (result != null) return result;
+    }
     var parser = _JsonUtf8DecoderSink._createParser(_reviver, _allowMalformed);
     parser.chunk = input;
     parser.chunkEnd = input.length;
@@ -1769,6 +1832,11 @@ class _JsonUtf8Parser extends _ChunkedJsonParser<List<int>> {
     if (bits <= maxAsciiChar) {
       return new String.fromCharCodes(chunk, start, end);
     }
+    final chunk = this.chunk;
+    if (chunk is Uint8List) {
+      final result = _decodeUtf8(chunk, start, end, false);
+      if (result != null) return result;
+    }
     beginString();
     if (start < end) addSliceToString(start, end);
     String result = endString();
@@ -1852,10 +1920,19 @@ class _JsonUtf8DecoderSink extends ByteConversionSinkBase {
   }
 }
 
+// Ranges of at least this many bytes of a Uint8List are scanned by the
+// runtime, which examines a word at a time.
+const int _nativeScanThreshold = 32;
+
 @patch
 int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   final to = endIndex;
 
+  if ((units is Uint8List) && (to - from >= _nativeScanThreshold)) {
+    final count = _scanOneByteCharactersInUint8List(units, from, to);
+    if (count != null) return count;
+  }
+
   // Special case for _Uint8ArrayView.
   final cid = ClassID.getID(units);
   if (identical(cid, ClassID.cidUint8ArrayView)) {
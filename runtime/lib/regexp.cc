@@ -9,6 +9,7 @@
 #include "vm/object.h"
 #include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
+#include "vm/regexp_linear.h"
 #include "vm/regexp_parser.h"
 #include "vm/thread.h"
 
@@ -77,6 +78,11 @@ static RawObject* ExecuteMatch(Zone* zone,
   GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
 
+  if (regexp.is_linear()) {
+    return LinearRegExp::Execute(regexp, subject, start_index,
+                                 /*sticky=*/sticky, zone);
+  }
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (!FLAG_interpret_irregexp) {
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
@@ -97,4 +103,133 @@ DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchSticky, 0, 3) {
   return ExecuteMatch(zone, arguments, /*sticky=*/true);
 }
 
+static bool IsLineTerminator(uint16_t c) {
+  return (c == '\n') || (c == '\r') || (c == 0x2028) || (c == 0x2029);
+}
+
+template <typename SubjectChar, typename LiteralChar>
+static intptr_t IndexOfLiteral(const SubjectChar* subject,
+                               intptr_t length,
+                               const LiteralChar* literal,
+                               intptr_t literal_length,
+                               intptr_t start) {
+  const LiteralChar first = literal[0];
+  const intptr_t limit = length - literal_length;
+  for (intptr_t i = start; i <= limit; i++) {
+    if (subject[i] != first) {
+      continue;
+    }
+    intptr_t j = 1;
+    while ((j < literal_length) && (subject[i + j] == literal[j])) {
+      j++;
+    }
+    if (j == literal_length) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// One-byte subjects are scanned with memchr and memcmp, which the C library
+// vectorizes.
+template <>
+intptr_t IndexOfLiteral(const uint8_t* subject,
+                        intptr_t length,
+                        const uint8_t* literal,
+                        intptr_t literal_length,
+                        intptr_t start) {
+  if (literal_length > (length - start)) {
+    return -1;
+  }
+  const uint8_t* limit = subject + (length - literal_length + 1);
+  const uint8_t* cursor = subject + start;
+  while (cursor < limit) {
+    cursor = reinterpret_cast<const uint8_t*>(
+        memchr(cursor, literal[0], limit - cursor));
+    if (cursor == NULL) {
+      return -1;
+    }
+    if (memcmp(cursor + 1, literal + 1, literal_length - 1) == 0) {
+      return cursor - subject;
+    }
+    cursor++;
+  }
+  return -1;
+}
+
+// Returns the index of the first occurrence of the non-empty literal in the
+// subject at or after start, or -1.
+static intptr_t IndexOfLiteral(const String& subject,
+                               const String& literal,
+                               intptr_t start) {
+  ASSERT(literal.Length() > 0);
+  NoSafepointScope no_safepoint;
+  if (literal.IsOneByteString()) {
+    if (subject.IsOneByteString()) {
+      return IndexOfLiteral(OneByteString::DataStart(subject), subject.Length(),
+                            OneByteString::DataStart(literal),
+                            literal.Length(), start);
+    }
+    if (subject.IsTwoByteString()) {
+      return IndexOfLiteral(TwoByteString::DataStart(subject), subject.Length(),
+                            OneByteString::DataStart(literal),
+                            literal.Length(), start);
+    }
+  } else if (literal.IsTwoByteString()) {
+    if (subject.IsOneByteString()) {
+      // Some character of the literal does not fit in one byte.
+      return -1;
+    }
+    if (subject.IsTwoByteString()) {
+      return IndexOfLiteral(TwoByteString::DataStart(subject), subject.Length(),
+                            TwoByteString::DataStart(literal),
+                            literal.Length(), start);
+    }
+  }
+  // External subjects.
+  const intptr_t limit = subject.Length() - literal.Length();
+  for (intptr_t i = start; i <= limit; i++) {
+    intptr_t j = 0;
+    while ((j < literal.Length()) &&
+           (subject.CharAt(i + j) == literal.CharAt(j))) {
+      j++;
+    }
+    if (j == literal.Length()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Returns the first index at or after start_index at which a match can
+// start, judging from a literal every match contains, or -1 if there can be
+// no match.
+DEFINE_NATIVE_ENTRY(RegExp_findCandidate, 0, 3) {
+  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+
+  const String& literal =
+      String::Handle(zone, RegExpEngine::RequiredLiteral(regexp, zone));
+  if (literal.Length() == 0) {
+    return start_index.raw();
+  }
+  const intptr_t start = start_index.Value();
+  intptr_t index = IndexOfLiteral(subject, literal, start);
+  if (index < 0) {
+    return Smi::New(-1);
+  }
+  if (regexp.literal_is_prefix()) {
+    return Smi::New(index);
+  }
+  if (regexp.literal_in_line()) {
+    while ((index > start) && !IsLineTerminator(subject.CharAt(index - 1))) {
+      index--;
+    }
+    return Smi::New(index);
+  }
+  return start_index.raw();
+}
+
 }  // namespace dart
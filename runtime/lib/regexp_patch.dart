@@ -190,7 +190,7 @@ class _RegExp implements RegExp {
 
   Match firstMatch(String str) {
     if (str is! String) throw new ArgumentError(str);
-    List match = _ExecuteMatch(str, 0);
+    List match = _execute(str, 0);
     if (match == null) {
       return null;
     }
@@ -219,13 +219,13 @@ class _RegExp implements RegExp {
 
   bool hasMatch(String str) {
     if (str is! String) throw new ArgumentError(str);
-    List match = _ExecuteMatch(str, 0);
+    List match = _execute(str, 0);
     return (match == null) ? false : true;
   }
 
   String stringMatch(String str) {
     if (str is! String) throw new ArgumentError(str);
-    List match = _ExecuteMatch(str, 0);
+    List match = _execute(str, 0);
     if (match == null) {
       return null;
     }
@@ -285,6 +285,20 @@ class _RegExp implements RegExp {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   ];
 
+  // Subjects at least this long are first searched for a literal every match
+  // contains, which skips the positions no match can start at.
+  static const int _minPrefilterLength = 256;
+
+  List _execute(String str, int start_index) {
+    if (str.length - start_index >= _minPrefilterLength) {
+      start_index = _findCandidate(str, start_index);
+      if (start_index < 0) return null;
+    }
+    return _ExecuteMatch(str, start_index);
+  }
+
+  int _findCandidate(String str, int start_index) native "RegExp_findCandidate";
+
   List _ExecuteMatch(String str, int start_index) native "RegExp_ExecuteMatch";
 
   List _ExecuteMatchSticky(String str, int start_index)
@@ -314,7 +328,7 @@ class _AllMatchesIterator implements Iterator<Match> {
   bool moveNext() {
     if (_re == null) return false; // Cleared after a failed match.
     if (_nextIndex <= _str.length) {
-      var match = _re._ExecuteMatch(_str, _nextIndex);
+      var match = _re._execute(_str, _nextIndex);
       if (match != null) {
         _current = new _RegExpMatch(_re, _str, match);
         _nextIndex = _current.end;
@@ -286,6 +286,147 @@ DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 0, 2) {
   return result.raw();
 }
 
+// Returns the index of the first occurrence of [pattern] in [data] at or
+// after [start], or -1. Candidate positions are found with memchr and
+// verified with memcmp, both of which are vectorized by the C library.
+static intptr_t OneByteIndexOf(const uint8_t* data,
+                               intptr_t length,
+                               const uint8_t* pattern,
+                               intptr_t pattern_length,
+                               intptr_t start) {
+  if (pattern_length == 0) {
+    return start;
+  }
+  if (pattern_length > (length - start)) {
+    return -1;
+  }
+  const uint8_t first = pattern[0];
+  const uint8_t* limit = data + (length - pattern_length + 1);
+  const uint8_t* cursor = data + start;
+  while (cursor < limit) {
+    cursor = reinterpret_cast<const uint8_t*>(
+        memchr(cursor, first, limit - cursor));
+    if (cursor == NULL) {
+      return -1;
+    }
+    if (memcmp(cursor + 1, pattern + 1, pattern_length - 1) == 0) {
+      return cursor - data;
+    }
+    cursor++;
+  }
+  return -1;
+}
+
+// This is high-performance code.
+DEFINE_NATIVE_ENTRY(OneByteString_indexOf, 0, 3) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(receiver.IsOneByteString());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(2));
+  ASSERT(pattern.IsOneByteString());
+  const intptr_t length = receiver.Length();
+  const intptr_t start = start_obj.Value();
+  ASSERT((0 <= start) && (start <= length));
+  NoSafepointScope no_safepoint;
+  return Smi::New(OneByteIndexOf(OneByteString::DataStart(receiver), length,
+                                 OneByteString::DataStart(pattern),
+                                 pattern.Length(), start));
+}
+
+// Latin-1 characters which have a single Latin-1 lower-case counterpart
+// at +0x20: A-Z and U+00C0..U+00DE except U+00D7.
+static inline bool IsLatin1UpperCase(uint8_t c) {
+  return (static_cast<uint8_t>(c - 'A') < 26) ||
+         ((static_cast<uint8_t>(c - 0xC0) < 0x1F) && (c != 0xD7));
+}
+
+// Latin-1 characters which have a single Latin-1 upper-case counterpart
+// at -0x20: a-z and U+00E0..U+00FE except U+00F7.
+static inline bool IsLatin1LowerCase(uint8_t c) {
+  return (static_cast<uint8_t>(c - 'a') < 26) ||
+         ((static_cast<uint8_t>(c - 0xE0) < 0x1F) && (c != 0xF7));
+}
+
+// Latin-1 lower-case characters whose upper-case form is not Latin-1:
+// U+00B5 (micro sign), U+00DF (sharp s) and U+00FF (y with diaeresis).
+static inline bool HasNonLatin1UpperCase(uint8_t c) {
+  return (c == 0xB5) || (c == 0xDF) || (c == 0xFF);
+}
+
+// Copies [src] into a new one-byte string, adding [delta] to every character
+// for which [needs_change] returns true. The conversion loop is branch-free
+// so that the C++ compiler can vectorize it.
+template <bool (*needs_change)(uint8_t)>
+static RawString* OneByteChangeCase(Zone* zone,
+                                    const String& receiver,
+                                    intptr_t first,
+                                    int delta) {
+  const intptr_t length = receiver.Length();
+  const String& result =
+      String::Handle(zone, OneByteString::New(length, Heap::kNew));
+  NoSafepointScope no_safepoint;
+  const uint8_t* src = OneByteString::DataStart(receiver);
+  uint8_t* dst = OneByteString::DataStart(result);
+  memmove(dst, src, first);
+  for (intptr_t i = first; i < length; i++) {
+    const uint8_t c = src[i];
+    dst[i] = static_cast<uint8_t>(c + (needs_change(c) ? delta : 0));
+  }
+  return result.raw();
+}
+
+DEFINE_NATIVE_ENTRY(OneByteString_toLowerCase, 0, 1) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(receiver.IsOneByteString());
+  const intptr_t length = receiver.Length();
+  intptr_t first = 0;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = OneByteString::DataStart(receiver);
+    while ((first < length) && !IsLatin1UpperCase(data[first])) {
+      first++;
+    }
+  }
+  if (first == length) {
+    return receiver.raw();
+  }
+  return OneByteChangeCase<IsLatin1UpperCase>(zone, receiver, first, 0x20);
+}
+
+DEFINE_NATIVE_ENTRY(OneByteString_toUpperCase, 0, 1) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(receiver.IsOneByteString());
+  const intptr_t length = receiver.Length();
+  intptr_t first = 0;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* data = OneByteString::DataStart(receiver);
+    while ((first < length) && !IsLatin1LowerCase(data[first])) {
+      if (HasNonLatin1UpperCase(data[first])) {
+        break;
+      }
+      first++;
+    }
+    for (intptr_t i = first; i < length; i++) {
+      if (HasNonLatin1UpperCase(data[i])) {
+        first = -1;
+        break;
+      }
+    }
+  }
+  if (first == -1) {
+    // The result does not fit into a one-byte string.
+    return String::ToUpperCase(receiver);
+  }
+  if (first == length) {
+    return receiver.raw();
+  }
+  return OneByteChangeCase<IsLatin1LowerCase>(zone, receiver, first, -0x20);
+}
+
 DEFINE_NATIVE_ENTRY(OneByteString_allocate, 0, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, length_obj, arguments->NativeArgAt(0));
   return OneByteString::New(length_obj.Value(), Heap::kNew);
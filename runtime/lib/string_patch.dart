@@ -1000,14 +1000,27 @@ class _OneByteString extends _StringBase {
     return res;
   }
 
+  // Searches and case conversions of at least this many characters are done
+  // by the runtime, where they are vectorized.
+  static const int _nativeThreshold = 64;
+
+  int _indexOfOneByte(_OneByteString pattern, int start)
+      native "OneByteString_indexOf";
+
   int indexOf(Pattern pattern, [int start = 0]) {
-    // Specialize for single character pattern.
     final pCid = ClassID.getID(pattern);
+    final len = this.length;
+    if ((pCid == ClassID.cidOneByteString) &&
+        (start >= 0) &&
+        (start <= len) &&
+        (len - start >= _nativeThreshold)) {
+      return _indexOfOneByte(pattern, start);
+    }
+    // Specialize for single character pattern.
     if ((pCid == ClassID.cidOneByteString) ||
         (pCid == ClassID.cidTwoByteString) ||
         (pCid == ClassID.cidExternalOneByteString)) {
       final String patternAsString = pattern;
-      final len = this.length;
       if ((patternAsString.length == 1) && (start >= 0) && (start < len)) {
         final patternCu0 = patternAsString.codeUnitAt(0);
         if (patternCu0 > 0xFF) {
@@ -1026,11 +1039,17 @@ class _OneByteString extends _StringBase {
 
   bool contains(Pattern pattern, [int start = 0]) {
     final pCid = ClassID.getID(pattern);
+    final len = this.length;
+    if ((pCid == ClassID.cidOneByteString) &&
+        (start >= 0) &&
+        (start <= len) &&
+        (len - start >= _nativeThreshold)) {
+      return _indexOfOneByte(pattern, start) >= 0;
+    }
     if ((pCid == ClassID.cidOneByteString) ||
         (pCid == ClassID.cidTwoByteString) ||
         (pCid == ClassID.cidExternalOneByteString)) {
       final String patternAsString = pattern;
-      final len = this.length;
       if ((patternAsString.length == 1) && (start >= 0) && (start < len)) {
         final patternCu0 = patternAsString.codeUnitAt(0);
         if (patternCu0 > 0xFF) {
@@ -1170,7 +1189,11 @@ class _OneByteString extends _StringBase {
       "\xc0\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8\xc9\xca\xcb\xcc\xcd\xce\xcf"
       "\xd0\xd1\xd2\xd3\xd4\xd5\xd6\xf7\xd8\xd9\xda\xdb\xdc\xdd\xde\x00";
 
+  String _toLowerCase() native "OneByteString_toLowerCase";
+  String _toUpperCase() native "OneByteString_toUpperCase";
+
   String toLowerCase() {
+    if (this.length >= _nativeThreshold) return _toLowerCase();
     for (int i = 0; i < this.length; i++) {
       final c = this.codeUnitAt(i);
       if (c == _LC_TABLE.codeUnitAt(c)) continue;
@@ -1188,6 +1211,7 @@ class _OneByteString extends _StringBase {
   }
 
   String toUpperCase() {
+    if (this.length >= _nativeThreshold) return _toUpperCase();
     for (int i = 0; i < this.length; i++) {
       final c = this.codeUnitAt(i);
       // Continue loop if character is unchanged by upper-case conversion.
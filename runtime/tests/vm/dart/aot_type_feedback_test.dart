@@ -0,0 +1,137 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// This test is ensuring that type feedback recorded in a JIT training run and
+// given to gen_snapshot with --load_type_feedback turns a polymorphic
+// interface call without static type information into class checks of the
+// receivers seen in training.
+
+import "dart:async";
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+main(List<String> args) async {
+  if (!Platform.executable.endsWith("dart_precompiled_runtime")) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and dart_bootstrap not available on the test device.
+  }
+
+  final buildDir = path.dirname(Platform.executable);
+  final platformDill = path.join(buildDir, 'vm_platform_strong.dill');
+  final genSnapshot = path.join(buildDir, 'gen_snapshot');
+  final dart = path.join(buildDir, 'dart');
+  final aotRuntime = path.join(buildDir, 'dart_precompiled_runtime');
+
+  await withTempDir((String tempDir) async {
+    final script = path.join(tempDir, 'shapes.dart');
+    final scriptDill = path.join(tempDir, 'shapes.dill');
+    final feedback = path.join(tempDir, 'shapes.feedback');
+    await new File(script).writeAsString(shapesProgram);
+
+    await run('pkg/vm/tool/gen_kernel', <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      script,
+    ]);
+
+    // Train in the JIT.
+    final training = await run(dart, <String>[
+      '--save_type_feedback=$feedback',
+      scriptDill,
+    ]);
+    Expect.equals('3750000.0', training.trim());
+
+    // Only the run with feedback specializes the call in total().
+    final usedFeedback = RegExp(r'Using training feedback for .*total');
+    for (bool withFeedback in [false, true]) {
+      final snapshot = path.join(tempDir, 'shapes$withFeedback.snapshot');
+      final options = <String>['--trace_precompiler'];
+      if (withFeedback) {
+        options.add('--load_type_feedback=$feedback');
+      }
+      options.addAll(<String>[
+        '--snapshot-kind=app-aot-blobs',
+        '--blobs_container_filename=$snapshot',
+        scriptDill,
+      ]);
+      final output = await run(genSnapshot, options);
+      Expect.equals(withFeedback, output.contains(usedFeedback));
+      Expect.equals(
+          '3750000.0', (await run(aotRuntime, <String>[snapshot])).trim());
+    }
+  });
+}
+
+const shapesProgram = '''
+abstract class Shape {
+  double area();
+}
+
+class Square implements Shape {
+  final double side;
+  Square(this.side);
+  double area() => side * side;
+}
+
+class Rectangle implements Shape {
+  final double width;
+  final double height;
+  Rectangle(this.width, this.height);
+  double area() => width * height;
+}
+
+@pragma('vm:never-inline')
+double total(List<Shape> shapes) {
+  double sum = 0.0;
+  for (int i = 0; i < shapes.length; i++) {
+    sum += shapes[i].area();
+  }
+  return sum;
+}
+
+main() {
+  final shapes = <Shape>[];
+  for (int i = 0; i < 100; i++) {
+    shapes.add(i.isEven ? Square(3.0) : Rectangle(2.0, 3.0));
+  }
+  double sum = 0.0;
+  for (int i = 0; i < 5000; i++) {
+    sum += total(shapes);
+  }
+  print(sum);
+}
+''';
+
+Future<String> run(String executable, List<String> args) async {
+  print('Running $executable ${args.join(' ')}');
+
+  final result = await Process.run(executable, args);
+  final String stdout = result.stdout;
+  final String stderr = result.stderr;
+  if (stderr.isNotEmpty) {
+    print('stderr:');
+    print(stderr);
+  }
+
+  if (result.exitCode != 0) {
+    throw 'Command failed with non-zero exit code (was ${result.exitCode})';
+  }
+  return stdout;
+}
+
+withTempDir(Future fun(String dir)) async {
+  final tempDir = Directory.systemTemp.createTempSync('aot-type-feedback');
+  try {
+    await fun(tempDir.path);
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}
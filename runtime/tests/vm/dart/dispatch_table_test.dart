@@ -0,0 +1,90 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// In AOT mode switchable calls whose selector has a row in the global
+// dispatch table load their target from the table. This test mixes receivers
+// that have a target in the row with ones that do not (Smi, null and classes
+// relying on noSuchMethod) and argument shapes only some targets accept.
+
+import "package:expect/expect.dart";
+
+abstract class Shape {
+  String name();
+  int sides([int extra = 0]);
+  int scale({int factor});
+}
+
+class Triangle extends Shape {
+  String name() => "triangle";
+  int sides([int extra = 0]) => 3 + extra;
+  int scale({int factor: 1}) => 3 * factor;
+}
+
+class Square extends Shape {
+  String name() => "square";
+  int sides([int extra = 0]) => 4 + extra;
+  int scale({int factor: 1}) => 4 * factor;
+}
+
+class Rectangle extends Square {
+  // Inherits sides and scale from Square.
+  String name() => "rectangle";
+}
+
+class Pentagon extends Shape {
+  String name() => "pentagon";
+  int sides([int extra = 0]) => 5 + extra;
+  int scale({int factor: 1, int offset: 0}) => 5 * factor + offset;
+}
+
+class Ghost {
+  noSuchMethod(Invocation invocation) => invocation.memberName;
+}
+
+@pragma('vm:never-inline')
+dynamic callName(dynamic receiver) => receiver.name();
+
+@pragma('vm:never-inline')
+dynamic callSides(dynamic receiver) => receiver.sides();
+
+@pragma('vm:never-inline')
+dynamic callSidesWithExtra(dynamic receiver) => receiver.sides(10);
+
+@pragma('vm:never-inline')
+dynamic callScaleWithOffset(dynamic receiver) =>
+    receiver.scale(factor: 2, offset: 1);
+
+@pragma('vm:never-inline')
+dynamic callToString(dynamic receiver) => receiver.toString();
+
+main() {
+  final shapes = <dynamic>[
+    new Triangle(),
+    new Square(),
+    new Rectangle(),
+    new Pentagon()
+  ];
+  for (int i = 0; i < 20; i++) {
+    Expect.listEquals(["triangle", "square", "rectangle", "pentagon"],
+        shapes.map(callName).toList());
+    Expect.listEquals([3, 4, 4, 5], shapes.map(callSides).toList());
+    Expect.listEquals(
+        [13, 14, 14, 15], shapes.map(callSidesWithExtra).toList());
+
+    // Only Pentagon.scale accepts an offset.
+    Expect.equals(11, callScaleWithOffset(shapes[3]));
+    Expect.throws(() => callScaleWithOffset(shapes[0]),
+        (e) => e is NoSuchMethodError);
+
+    // Receivers without a target for the selector.
+    Expect.equals(#name, callName(new Ghost()));
+    Expect.equals(#sides, callSides(new Ghost()));
+    Expect.throws(() => callName(i), (e) => e is NoSuchMethodError);
+    Expect.throws(() => callSides(null), (e) => e is NoSuchMethodError);
+
+    // Object members are implemented by every class, including Smi and Null.
+    Expect.equals("$i", callToString(i));
+    Expect.equals("null", callToString(null));
+  }
+}
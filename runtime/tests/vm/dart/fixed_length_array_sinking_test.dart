@@ -0,0 +1,51 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that non-escaping fixed-length arrays which are accessed with
+// constant indices compute the same results when their allocations are
+// eliminated.
+//
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+
+import 'package:expect/expect.dart';
+
+int sumOfPair(int a, int b) {
+  final pair = new List(2);
+  pair[0] = a;
+  pair[1] = b;
+  return pair[0] + pair[1];
+}
+
+int unwrittenElement(int a) {
+  final list = new List(3);
+  list[0] = a;
+  return list[2] == null ? list[0] : -1;
+}
+
+int conditionalStore(int a, bool flag) {
+  final list = new List(2);
+  list[0] = a;
+  if (flag) {
+    list[0] = a * 2;
+    list[1] = a;
+  }
+  return list[0] + (list[1] ?? 0);
+}
+
+int closureCapture(int a) {
+  final list = new List(1);
+  list[0] = a;
+  final f = () => list[0] + 1;
+  return f();
+}
+
+void main() {
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(2 * i + 1, sumOfPair(i, i + 1));
+    Expect.equals(i, unwrittenElement(i));
+    Expect.equals(i, conditionalStore(i, false));
+    Expect.equals(3 * i, conditionalStore(i, true));
+    Expect.equals(i + 1, closureCapture(i));
+  }
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies JSON decoding and single-line encoding, which are handled by the
+// runtime when no reviver, indentation or toEncodable call is involved.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+final utf8Json = utf8.decoder.fuse(json.decoder);
+
+Object decodeBytes(String source) =>
+    utf8Json.convert(new Uint8List.fromList(utf8.encode(source)));
+
+void testDecode(Object decode(String source)) {
+  final map = decode(' {"a": [1, -2, 3.5, -0.25e1, 1E2, true, false, null], '
+      '"b": {"c": {}, "d": []}, "e": "x\\"\\\\\\/\\b\\f\\n\\r\\t\\u00e6"} ');
+  Expect.isTrue(map is Map<String, dynamic>);
+  Expect.listEquals(['a', 'b', 'e'], map.keys.toList());
+  Expect.listEquals([1, -2, 3.5, -2.5, 100.0, true, false, null], map['a']);
+  Expect.isTrue(map['a'][4] is double);
+  Expect.isTrue(map['a'] is List<dynamic>);
+  (map['a'] as List).add(0);
+  Expect.equals(0, map['b']['c'].length);
+  Expect.equals('x"\\/\b\f\n\r\tæ', map['e']);
+
+  // The last value of a duplicate key wins, at the first key's position.
+  final duplicates = decode('{"a": 1, "b": 2, "a": 3}');
+  Expect.listEquals(['a', 'b'], duplicates.keys.toList());
+  Expect.equals(3, duplicates['a']);
+
+  // Maps built by the runtime can be used like any other.
+  final entries = new List.generate(100, (i) => '"k$i": $i').join(',');
+  final big = decode('{$entries}') as Map<String, dynamic>;
+  Expect.equals(100, big.length);
+  Expect.equals(42, big['k42']);
+  big['k100'] = 100;
+  big.remove('k0');
+  Expect.equals(100, big.length);
+
+  Expect.equals('æøå €\u{1F600}', decode('"æøå €\u{1F600}"'));
+  Expect.equals('\ud800', decode('"\\ud800"'));
+  Expect.equals(0, decode('-0'));
+  Expect.equals(-0.0, decode('-0.0'));
+  Expect.isTrue((decode('-0.0') as double).isNegative);
+  Expect.equals(double.infinity, decode('1e400'));
+  Expect.equals(9223372036854775807, decode('9223372036854775807'));
+  Expect.equals(9223372036854775808.0, decode('9223372036854775808'));
+  Expect.equals(-9223372036854775808, decode('-9223372036854775808'));
+  Expect.isNull(decode('null'));
+
+  // Deeply nested input is left to the Dart parser.
+  Expect.equals(1, decode('[' * 1000 + '1' + ']' * 1000).length);
+
+  for (final malformed in [
+    '',
+    '{',
+    '[1,]',
+    '{"a" 1}',
+    '{1: 2}',
+    '01',
+    '1.',
+    '1e',
+    '-',
+    'tru',
+    '"\\x"',
+    '"\\u12"',
+    '"\t"',
+    '[1] 2',
+  ]) {
+    Expect.throwsFormatException(() => decode(malformed), malformed);
+  }
+}
+
+void testDecodeUtf8() {
+  Expect.equals(
+      'a',
+      utf8Json.convert(
+          new Uint8List.fromList([0xEF, 0xBB, 0xBF, 0x22, 0x61, 0x22])));
+  Expect.throwsFormatException(
+      () => utf8Json.convert(new Uint8List.fromList([0x22, 0xC3, 0x28, 0x22])));
+
+  // A view on a larger buffer.
+  final bytes = utf8.encode('--[1,"b"]--');
+  final view = new Uint8List.view(
+      new Uint8List.fromList(bytes).buffer, 2, bytes.length - 4);
+  Expect.listEquals([1, 'b'], utf8Json.convert(view));
+
+  // Lists the runtime can't read directly are parsed by the Dart decoder.
+  Expect.listEquals(
+      [1, 'b'],
+      utf8Json.convert(new UnmodifiableUint8ListView(
+          new Uint8List.fromList(utf8.encode('[1,"b"]')))));
+  Expect.throwsFormatException(() => utf8Json.convert(
+      new UnmodifiableUint8ListView(new Uint8List.fromList(bytes))));
+}
+
+void testReviver() {
+  final result = json.decode('{"a": 1, "b": [2]}',
+      reviver: (key, value) => value is int ? value * 10 : value);
+  Expect.equals(10, result['a']);
+  Expect.equals(20, result['b'][0]);
+}
+
+class Custom {
+  final int value;
+  Custom(this.value);
+  toJson() => {'custom': value};
+}
+
+void testEncode() {
+  Expect.equals('null', json.encode(null));
+  Expect.equals('[1,-2,3.5,1e+21,-0.0,true,false,null]',
+      json.encode([1, -2, 3.5, 1e21, -0.0, true, false, null]));
+  Expect.equals('{"a":{"b":[]},"c":{}}',
+      json.encode({'a': {'b': []}, 'c': {}}));
+  Expect.equals('"x\\"\\\\/\\b\\f\\n\\r\\t\\u0001\\u001fæ€"',
+      json.encode('x"\\/\b\f\n\r\t\x01\x1fæ€'));
+  Expect.equals('[1,2]', json.encode(const [1, 2]));
+  Expect.equals('[1,2]', json.encode(new List<int>(2)..[0] = 1..[1] = 2));
+
+  // Values which are not directly encodable go through toJson or
+  // toEncodable.
+  Expect.equals('[{"custom":1}]', json.encode([new Custom(1)]));
+  Expect.equals('"1"', json.encode({1: 2}, toEncodable: (o) => '1'));
+  Expect.throws(() => json.encode(double.nan),
+      (e) => e is JsonUnsupportedObjectError);
+
+  final cyclic = [];
+  cyclic.add(cyclic);
+  Expect.throws(() => json.encode(cyclic), (e) => e is JsonCyclicError);
+
+  Expect.equals('[\n  1\n]', new JsonEncoder.withIndent('  ').convert([1]));
+
+  final value = {
+    'list': [1, 2.5, 'three', null],
+    'map': {'nested': true},
+  };
+  final encoded = json.encode(value);
+  Expect.equals(encoded, json.encode(json.decode(encoded)));
+}
+
+void main() {
+  testDecode(json.decode);
+  testDecode(decodeBytes);
+  testDecodeUtf8();
+  testReviver();
+  testEncode();
+}
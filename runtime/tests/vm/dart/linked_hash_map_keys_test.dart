@@ -0,0 +1,84 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies lookups in default maps and sets whose keys are mixed with the
+// Smi and one-byte string keys that have dedicated hashing and equality paths.
+//
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+
+import 'package:expect/expect.dart';
+
+class Key {
+  final int id;
+  Key(this.id);
+  int get hashCode => id;
+  bool operator ==(other) => other is Key && other.id == id;
+}
+
+void testMap() {
+  final map = {};
+  map[1] = 'int';
+  map['a'] = 'string';
+  map[new Key(2)] = 'key';
+  map[0x7fffffffffffffff] = 'mint';
+  map[double.nan] = 'nan';
+
+  Expect.equals('int', map[1]);
+  Expect.equals('int', map[1.0]);
+  Expect.isNull(map[2]);
+  Expect.equals('key', map[new Key(2)]);
+  Expect.equals('mint', map[0x7fffffffffffffff]);
+  Expect.isNull(map[double.nan]);
+
+  // Equal strings which are not identical, possibly of other string classes.
+  final twoByte = 'a\u{100}'.substring(0, 1);
+  Expect.equals('string', map[twoByte]);
+  Expect.equals('string', map[new String.fromCharCodes([0x61])]);
+  Expect.isNull(map['b']);
+
+  // Integral doubles find integer keys, and integers find double keys.
+  map[2.0] = 'double';
+  Expect.equals('double', map[2]);
+  map[3] = 'three';
+  Expect.equals('three', map[3.0]);
+
+  Expect.equals('int', map.remove(1));
+  Expect.isFalse(map.containsKey(1));
+  Expect.equals('string', map.remove(twoByte));
+  Expect.isFalse(map.containsKey('a'));
+}
+
+void testSet() {
+  final set = new Set();
+  Expect.isTrue(set.add(1));
+  Expect.isFalse(set.add(1.0));
+  Expect.isTrue(set.add('x'));
+  Expect.isFalse(set.add('xy'.substring(0, 1)));
+  Expect.isTrue(set.add(new Key(1)));
+  Expect.isFalse(set.add(new Key(1)));
+  Expect.equals(3, set.length);
+  Expect.isTrue(set.contains(1.0));
+  Expect.isTrue(set.contains('x\u{100}'.substring(0, 1)));
+}
+
+void testGrowth() {
+  final map = <Object, int>{};
+  for (int i = 0; i < 10000; i++) {
+    map[i] = i;
+    map['$i'] = -i;
+  }
+  Expect.equals(20000, map.length);
+  for (int i = 0; i < 10000; i++) {
+    Expect.equals(i, map[i]);
+    Expect.equals(-i, map['$i']);
+  }
+}
+
+void main() {
+  for (int i = 0; i < 20; i++) {
+    testMap();
+    testSet();
+  }
+  testGrowth();
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies code compiled by the mid-tier optimizing pipeline, both for warm
+// functions which tier up to the full pipeline and for huge functions which
+// are only ever compiled by the mid tier.
+//
+// VMOptions=--mid_tier_counter_threshold=5 --optimization_counter_threshold=100 --no-background-compilation
+// VMOptions=--mid_tier_counter_threshold=5 --optimization_counter_threshold=100 --huge_method_cutoff_in_tokens=20 --no-background-compilation
+
+import 'package:expect/expect.dart';
+
+class Point {
+  double x;
+  double y;
+  Point(this.x, this.y);
+}
+
+class Shape {
+  int get sides => 0;
+}
+
+class Square extends Shape {
+  int get sides => 4;
+}
+
+double length(List<Point> points) {
+  double result = 0.0;
+  for (int i = 1; i < points.length; i++) {
+    final dx = points[i].x - points[i - 1].x;
+    final dy = points[i].y - points[i - 1].y;
+    result += dx * dx + dy * dy;
+  }
+  return result;
+}
+
+sum(a, b) => a + b;
+
+int countSides(List<Shape> shapes) {
+  int result = 0;
+  for (final shape in shapes) {
+    result += shape.sides;
+  }
+  return result;
+}
+
+void main() {
+  final points = <Point>[new Point(0.0, 0.0), new Point(3.0, 4.0)];
+  for (int i = 0; i < 300; i++) {
+    Expect.equals(25.0, length(points));
+    Expect.equals(3, sum(1, 2));
+    Expect.equals(4, countSides([new Square()]));
+  }
+  // Deoptimize on types the type feedback has not seen.
+  Expect.equals(3.5, sum(1.5, 2));
+  Expect.equals(4, countSides([new Square(), new Shape()]));
+  for (int i = 0; i < 300; i++) {
+    Expect.equals('ab', sum('a', 'b'));
+    points[1].x = i.toDouble();
+    Expect.equals(i * i + 16.0, length(points));
+  }
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies searches and case conversions of one-byte strings which are long
+// enough to be handled by the runtime.
+
+import 'package:expect/expect.dart';
+
+String pad(String s, int length) {
+  final sb = new StringBuffer();
+  while (sb.length < length) sb.write('-');
+  sb.write(s);
+  return sb.toString();
+}
+
+void testIndexOf() {
+  final s = pad('abcabd', 100);
+  Expect.equals(100, s.indexOf('a'));
+  Expect.equals(103, s.indexOf('abd'));
+  Expect.equals(103, s.indexOf('a', 101));
+  Expect.equals(-1, s.indexOf('abe'));
+  Expect.equals(-1, s.indexOf('dx'));
+  Expect.equals(10, s.indexOf('', 10));
+  Expect.equals(s.length, s.indexOf('', s.length));
+  Expect.isTrue(s.contains('cab'));
+  Expect.isTrue(s.contains('---a'));
+  Expect.isFalse(s.contains('cab', 103));
+  Expect.isFalse(s.contains('Ā'));
+  Expect.throws(() => s.indexOf('a', s.length + 1));
+}
+
+void testCaseConversion() {
+  final lower = pad('abc xyz àö÷þ', 100);
+  final upper = pad('ABC XYZ ÀÖ÷Þ', 100);
+  Expect.equals(upper, lower.toUpperCase());
+  Expect.equals(lower, upper.toLowerCase());
+  Expect.equals(pad('×', 100), pad('×', 100).toLowerCase());
+
+  // Upper-case forms of these characters are not Latin-1.
+  Expect.equals(pad('Ÿ', 100), pad('ÿ', 100).toUpperCase());
+  Expect.equals(pad('Μ', 100), pad('µ', 100).toUpperCase());
+
+  // Unchanged strings are returned as is.
+  final unchanged = pad('123', 100);
+  Expect.identical(unchanged, unchanged.toLowerCase());
+  Expect.identical(unchanged, unchanged.toUpperCase());
+}
+
+void main() {
+  testIndexOf();
+  testCaseConversion();
+}
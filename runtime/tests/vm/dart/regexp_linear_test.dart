@@ -0,0 +1,111 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies regexps with nested repetitions, which are matched in linear time,
+// and, when forced, all regexps without backreferences or lookarounds.
+//
+// VMOptions=
+// VMOptions=--force_linear_regexp
+// VMOptions=--interpret_irregexp
+
+import 'package:expect/expect.dart';
+
+void expectMatch(String pattern, String subject, List<String> groups,
+    {bool multiLine: false, bool caseSensitive: true, int start: 0}) {
+  final regexp =
+      new RegExp(pattern, multiLine: multiLine, caseSensitive: caseSensitive);
+  final match = regexp.allMatches(subject, start).first;
+  Expect.equals(groups.length - 1, regexp.groupCount, pattern);
+  for (int i = 0; i < groups.length; i++) {
+    Expect.equals(groups[i], match.group(i), '$pattern group $i');
+  }
+}
+
+void expectNoMatch(String pattern, String subject,
+    {bool multiLine: false, bool caseSensitive: true}) {
+  final regexp =
+      new RegExp(pattern, multiLine: multiLine, caseSensitive: caseSensitive);
+  Expect.isNull(regexp.firstMatch(subject), pattern);
+}
+
+void testPathological() {
+  final a = 'a' * 10000;
+  expectNoMatch(r'(a+)+b', a);
+  expectNoMatch(r'(a|aa)*b', a);
+  expectNoMatch(r'(a*)*b', a);
+  expectNoMatch(r'^(\w+\s?)*$', a + '!');
+  expectMatch(r'(a+)+$', a, [a, a]);
+}
+
+void testCaptures() {
+  expectMatch(r'(a+)+b', 'xaaab', ['aaab', 'aaa']);
+  expectMatch(r'(a|ab)(c|bcd)(d*)', 'abcd', ['abcd', 'a', 'bcd', '']);
+  expectMatch(r'((a)|b)+', 'ab', ['ab', 'b', null]);
+  expectMatch(r'(z)((a+)?(b+)?(c))*', 'zaacbbbcac',
+      ['zaacbbbcac', 'z', 'ac', 'a', null, 'c']);
+  expectMatch(r'(a*)*', 'b', ['', null]);
+  expectMatch(r'(a*)+', 'b', ['', '']);
+  expectMatch(r'(?:(a)|b)*c', 'abc', ['abc', null]);
+  expectMatch(r'(a)|(b)', 'b', ['b', null, 'b']);
+}
+
+void testGreediness() {
+  expectMatch(r'(a+?)(a*)', 'aaa', ['aaa', 'a', 'aa']);
+  expectMatch(r'(a*?)(a*)$', 'aaa', ['aaa', '', 'aaa']);
+  expectMatch(r'<(.+)>', '<a><b>', ['<a><b>', 'a><b']);
+  expectMatch(r'<(.+?)>', '<a><b>', ['<a>', 'a']);
+  expectMatch(r'(ab){2,3}', 'abababab', ['ababab', 'ab']);
+  expectMatch(r'(ab){2,3}?', 'abababab', ['abab', 'ab']);
+  expectMatch(r'x{0}y', 'y', ['y']);
+}
+
+void testAssertions() {
+  expectMatch(r'^(a|b)+$', 'abba', ['abba', 'a']);
+  expectNoMatch(r'^(a|b)+$', 'abca');
+  expectMatch(r'^(\w+)$', 'a\nbc', ['bc', 'bc'], multiLine: true, start: 1);
+  expectNoMatch(r'^(\w+)$', 'a\nbc');
+  expectMatch(r'\b(\w+)*\b', ' foo ', ['foo', 'foo']);
+  expectMatch(r'\B(o+)', 'foo', ['oo', 'oo']);
+}
+
+void testCharacterClasses() {
+  expectMatch(r'([a-c]+)+', 'xxcab', ['cab', 'cab']);
+  expectMatch(r'([^a-c]+)+', 'abcxyz', ['xyz', 'xyz']);
+  expectMatch(r'(\d|\s)+', 'a1 2b', ['1 2', '2']);
+  expectMatch(r'(.)+', 'a\nb', ['a', 'a']);
+  expectMatch(r'([^])+', '\u0000\n', ['\u0000\n', '\n']);
+  expectMatch(r'(Ā|ā)+', 'xĀā', ['Āā', 'ā']);
+  expectMatch(r'(ab)+', 'xAbaB', ['AbaB', 'aB'], caseSensitive: false);
+  expectMatch(r'([a-c])+', 'xABC', ['ABC', 'C'], caseSensitive: false);
+  expectMatch(r'(æ)+', 'Æ', ['Æ', 'Æ'], caseSensitive: false);
+}
+
+void testIteration() {
+  final regexp = new RegExp(r'(a|b)+');
+  Expect.listEquals(['ab', 'ba', 'a'],
+      regexp.allMatches('ab-ba-a').map((m) => m.group(0)).toList());
+  Expect.equals('x-x-x', 'ab-ba-a'.replaceAll(regexp, 'x'));
+  Expect.isNull(regexp.matchAsPrefix('-ab'));
+  Expect.equals('ab', regexp.matchAsPrefix('-ab', 1).group(0));
+  Expect.listEquals(['', 'a', ''],
+      new RegExp(r'(a*)*').allMatches('ba').map((m) => m[0]).toList());
+  Expect.isTrue(new RegExp(r'(x+x+)+y').hasMatch('xxxxy'));
+}
+
+void testUnsupported() {
+  // Backreferences and lookarounds are matched by backtracking.
+  expectMatch(r'(a+)+\1', 'aa', ['aa', 'a']);
+  expectMatch(r'(a+)+(?=b)', 'aab', ['aa', 'aa']);
+  expectMatch(r'(?!b)(a+)+', 'baa', ['aa', 'aa']);
+}
+
+void main() {
+  testPathological();
+  testCaptures();
+  testGreediness();
+  testAssertions();
+  testCharacterClasses();
+  testIteration();
+  testUnsupported();
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies matching in subjects long enough to be searched for a literal
+// every match contains before the regexp is run.
+
+import 'package:expect/expect.dart';
+
+final String filler = '-' * 300;
+
+List<String> all(String pattern, String subject,
+        {bool multiLine: false, bool caseSensitive: true}) =>
+    new RegExp(pattern, multiLine: multiLine, caseSensitive: caseSensitive)
+        .allMatches(subject)
+        .map((m) => m[0])
+        .toList();
+
+void testPrefix() {
+  final subject = '${filler}foo1 foo${filler}foo22\n${filler}fo3';
+  Expect.listEquals(['foo1', 'foo22'], all(r'foo\d+', subject));
+  Expect.equals('${filler}<1> foo${filler}<22>\n${filler}fo3',
+      subject.replaceAllMapped(new RegExp(r'foo(\d+)'), (m) => '<${m[1]}>'));
+  Expect.listEquals(['foo'], all(r'\bfoo\b', '${filler}afoo foo'));
+  Expect.listEquals([], all(r'^foo', '${filler}foo'));
+  Expect.listEquals(['foo'], all(r'^foo', '${filler}\nfoo', multiLine: true));
+  Expect.listEquals(['(foo)'], all(r'\(foo\)', '$filler(foo)'));
+  Expect.isNull(new RegExp(r'bar\d').firstMatch('${filler}bar'));
+  Expect.isFalse(new RegExp(r'ba+r').hasMatch(filler));
+  Expect.equals('foo', new RegExp(r'(foo)(?=!)').stringMatch('${filler}foo!'));
+}
+
+void testInLine() {
+  final log = [
+    'INFO starting',
+    'ERROR first failure',
+    filler,
+    'WARN something',
+    'ERROR second failure',
+    filler,
+  ].join('\n');
+  Expect.listEquals(['ERROR first failure', 'ERROR second failure'],
+      all(r'.*ERROR.*', log));
+  Expect.listEquals(
+      ['first failure', 'second failure'], all(r'[a-z]* failure', log));
+  Expect.listEquals(['\n  ERROR x'], all(r'\s*ERROR x', '$filler\n  ERROR x'));
+  Expect.listEquals([], all(r'.*ERROR', filler));
+}
+
+void testAnywhere() {
+  Expect.listEquals(['$filler\nX'], all(r'[^]*X', '$filler\nX'));
+  Expect.listEquals(['a\nbX'], all(r'a\sbX', '${filler}a\nbX'));
+  Expect.listEquals(['1X'], all(r'(?:\d|y)X', '${filler}1X'));
+  Expect.listEquals([], all(r'\d+X', filler));
+}
+
+void testStrings() {
+  // Two-byte subjects and literals.
+  Expect.listEquals(['\u{100}1'], all(r'Ā\d', '$filler\u{100}1'));
+  Expect.listEquals(['foo1'], all(r'foo\d', '$filler\u{100}foo1'));
+  Expect.listEquals([], all(r'Ā\d', '${filler}1'));
+  // Case-insensitive regexps are not prefiltered.
+  Expect.listEquals(
+      ['FOO1'], all(r'foo\d', '${filler}FOO1', caseSensitive: false));
+}
+
+void main() {
+  testPrefix();
+  testInLine();
+  testAnywhere();
+  testStrings();
+}
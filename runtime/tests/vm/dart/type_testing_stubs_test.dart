@@ -0,0 +1,150 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies casts to implemented generic interfaces, to generic types with
+// generic type arguments and to function types in optimized code, which are
+// checked by specialized type testing stubs.
+//
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+
+import 'dart:collection';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+abstract class Pair<A, B> {
+  A get first;
+  B get second;
+}
+
+class Ordered<A, B> implements Pair<A, B> {
+  final A first;
+  final B second;
+  Ordered(this.first, this.second);
+}
+
+class Swapped<X, Y> implements Pair<Y, X> {
+  final X _x;
+  final Y _y;
+  Swapped(this._x, this._y);
+  Y get first => _y;
+  X get second => _x;
+}
+
+class IntStringPair implements Pair<int, String> {
+  int get first => 1;
+  String get second => 'one';
+}
+
+class MyList<E> extends ListBase<E> {
+  final List<E> _list = <E>[];
+  int get length => _list.length;
+  void set length(int value) => _list.length = value;
+  E operator [](int index) => _list[index];
+  void operator []=(int index, E value) => _list[index] = value;
+}
+
+List<Map<String, dynamic>> asListOfMaps(Object o) =>
+    o as List<Map<String, dynamic>>;
+List<int> asListOfInt(Object o) => o as List<int>;
+Map<String, List<int>> asMapOfLists(Object o) => o as Map<String, List<int>>;
+Pair<int, String> asIntStringPair(Object o) => o as Pair<int, String>;
+List<T> asListOf<T>(Object o) => o as List<T>;
+int Function(int) asIntToInt(Object o) => o as int Function(int);
+List<int Function(int)> asListOfIntToInt(Object o) =>
+    o as List<int Function(int)>;
+
+void expectCastError(void Function() f) {
+  Expect.throws(f, (e) => e is CastError);
+}
+
+int increment(int x) => x + 1;
+String describe(int x) => '$x';
+T identity<T>(T x) => x;
+
+void testLists() {
+  final maps = <Map<String, dynamic>>[
+    {'a': 1}
+  ];
+  final fixed = new List<Map<String, dynamic>>(1);
+  const constant = const <Map<String, dynamic>>[];
+  final mine = new MyList<Map<String, dynamic>>();
+  Expect.identical(maps, asListOfMaps(maps));
+  Expect.identical(fixed, asListOfMaps(fixed));
+  Expect.identical(constant, asListOfMaps(constant));
+  Expect.identical(mine, asListOfMaps(mine));
+  Expect.isNull(asListOfMaps(null));
+  // Subtypes of the type argument are not identical to it, but are still
+  // accepted.
+  final linked = <LinkedHashMap<String, dynamic>>[];
+  Expect.identical(linked, asListOfMaps(linked));
+  expectCastError(() => asListOfMaps(<Map<String, int>>[]));
+  expectCastError(() => asListOfMaps(<Map<int, dynamic>>[]));
+  expectCastError(() => asListOfMaps(<Object>[]));
+  expectCastError(() => asListOfMaps(new MyList<Object>()));
+  expectCastError(() => asListOfMaps({}));
+
+  final bytes = new Uint8List(1);
+  Expect.identical(bytes, asListOfInt(bytes));
+  Expect.identical(maps, asListOf<Map<String, dynamic>>(maps));
+  Expect.identical(bytes, asListOf<int>(bytes));
+  expectCastError(() => asListOf<String>(bytes));
+  expectCastError(() => asListOfInt(new Float64List(1)));
+  expectCastError(() => asListOfInt(<num>[]));
+}
+
+void testMaps() {
+  final lists = <String, List<int>>{
+    'a': [1]
+  };
+  final hashMap = new HashMap<String, List<int>>();
+  final splay = new SplayTreeMap<String, List<int>>();
+  Expect.identical(lists, asMapOfLists(lists));
+  Expect.identical(hashMap, asMapOfLists(hashMap));
+  Expect.identical(splay, asMapOfLists(splay));
+  expectCastError(() => asMapOfLists(<String, List<num>>{}));
+  expectCastError(() => asMapOfLists(<Object, List<int>>{}));
+  expectCastError(() => asMapOfLists(<String, Iterable<int>>{}));
+}
+
+void testPairs() {
+  final ordered = new Ordered<int, String>(1, 'one');
+  final swapped = new Swapped<String, int>('one', 1);
+  final fixed = new IntStringPair();
+  Expect.identical(ordered, asIntStringPair(ordered));
+  Expect.identical(swapped, asIntStringPair(swapped));
+  Expect.identical(fixed, asIntStringPair(fixed));
+  expectCastError(() => asIntStringPair(new Ordered<String, int>('one', 1)));
+  expectCastError(() => asIntStringPair(new Swapped<int, String>(1, 'one')));
+  expectCastError(() => asIntStringPair(new Ordered<int, Object>(1, 'one')));
+}
+
+void testFunctions() {
+  final tearOff = increment;
+  final closure = (int x) => x * 2;
+  int Function(int) instantiated = identity;
+  int Function(int) local(int y) => (int x) => x + y;
+  Expect.identical(tearOff, asIntToInt(tearOff));
+  Expect.identical(closure, asIntToInt(closure));
+  Expect.identical(instantiated, asIntToInt(instantiated));
+  Expect.equals(5, asIntToInt(local(2))(3));
+  Expect.isNull(asIntToInt(null));
+  Expect.equals(2, asIntToInt((num x) => 2)(1));
+  expectCastError(() => asIntToInt(describe));
+  expectCastError(() => asIntToInt((String x) => 1));
+  expectCastError(() => asIntToInt(1));
+
+  final functions = <int Function(int)>[increment];
+  Expect.identical(functions, asListOfIntToInt(functions));
+  expectCastError(() => asListOfIntToInt(<String Function(int)>[describe]));
+}
+
+void main() {
+  for (int i = 0; i < 50; i++) {
+    testLists();
+    testMaps();
+    testPairs();
+    testFunctions();
+  }
+}
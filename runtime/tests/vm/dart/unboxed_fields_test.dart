@@ -0,0 +1,94 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that double fields which are stored unboxed (in a mutable box)
+// never leak the box: values read from such fields must not change when the
+// field is updated afterwards. Also covers the first store into a field
+// whose mutable box has not been allocated yet, both from a constructor body
+// and from a setter called long after construction.
+//
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+class Point {
+  double x = 0.0;
+  double y;
+
+  Point(this.y);
+
+  void move(double dx, double dy) {
+    x += dx;
+    y += dy;
+  }
+}
+
+class Lazy {
+  double value;
+
+  Lazy() {
+    value = 1.0;
+  }
+}
+
+// None of these fields is stored before the object escapes to set().
+class Unset {
+  double d;
+  Float32x4 f;
+  Float64x2 g;
+
+  void set(int i) {
+    d = i.toDouble();
+    f = new Float32x4.splat(d);
+    g = new Float64x2.splat(d);
+  }
+}
+
+void main() {
+  final values = <double>[];
+  final p = new Point(1.0);
+  for (int i = 0; i < 100; i++) {
+    values.add(p.x);
+    values.add(p.y);
+    p.move(1.0, 2.0);
+  }
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(i.toDouble(), values[2 * i]);
+    Expect.equals(1.0 + 2.0 * i, values[2 * i + 1]);
+  }
+
+  // Share a single double between two fields through the implicit setters.
+  final shared = values[10];
+  final q = new Point(0.0);
+  final r = new Point(0.0);
+  for (int i = 0; i < 100; i++) {
+    q.x = shared;
+    r.x = shared;
+    q.move(1.0, 1.0);
+    Expect.equals(shared, r.x);
+    Expect.equals(shared + 1.0, q.x);
+  }
+
+  for (int i = 0; i < 100; i++) {
+    final l = new Lazy();
+    l.value += i;
+    Expect.equals(1.0 + i, l.value);
+  }
+
+  // Allocate fresh objects on every iteration so that the first store into
+  // each field always finds an empty box, before and after optimization.
+  for (int i = 0; i < 100; i++) {
+    final u = new Unset();
+    u.set(i);
+    Expect.equals(i.toDouble(), u.d);
+    Expect.equals(i.toDouble(), u.f.w);
+    Expect.equals(i.toDouble(), u.g.y);
+    u.set(i + 1);
+    Expect.equals(i + 1.0, u.d);
+    Expect.equals(i + 1.0, u.f.x);
+    Expect.equals(i + 1.0, u.g.x);
+  }
+}
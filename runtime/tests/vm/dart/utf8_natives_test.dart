@@ -0,0 +1,121 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies UTF-8 conversions of typed data and one-byte strings, which are
+// handled by the runtime.
+
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+Uint8List bytes(List<int> list) => new Uint8List.fromList(list);
+
+// A Uint8List the runtime can't read directly.
+class CustomUint8List extends ListBase<int> implements Uint8List {
+  final Uint8List _bytes;
+
+  CustomUint8List(List<int> list) : _bytes = bytes(list);
+
+  int get length => _bytes.length;
+  set length(int value) => throw new UnsupportedError('length');
+  int operator [](int index) => _bytes[index];
+  void operator []=(int index, int value) {
+    _bytes[index] = value;
+  }
+
+  noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+void testDecode() {
+  final ascii = 'The quick brown fox jumps over the lazy dog';
+  Expect.equals(ascii, utf8.decode(bytes(ascii.codeUnits)));
+  Expect.equals('', utf8.decode(bytes([])));
+
+  // Latin-1, BMP and supplementary characters after an ASCII prefix.
+  for (final s in [ascii + 'æøå', ascii + '€', ascii + '\u{1F600}']) {
+    final encoded = bytes(utf8.encode(s));
+    Expect.equals(s, utf8.decode(encoded));
+    Expect.equals(s.substring(4), utf8.decoder.convert(encoded, 4));
+    // Views on a larger buffer.
+    final padded = new Uint8List(encoded.length + 8)
+      ..setRange(4, 4 + encoded.length, encoded);
+    Expect.equals(
+        s, utf8.decode(new Uint8List.view(padded.buffer, 4, encoded.length)));
+  }
+
+  // A leading byte order mark is dropped.
+  Expect.equals(
+      'abc', utf8.decode(bytes([0xEF, 0xBB, 0xBF, 0x61, 0x62, 0x63])));
+
+  // Malformed input is reported or replaced by the Dart decoder.
+  final malformed = bytes([0x61, 0xC3, 0x28, 0x62]);
+  Expect.throwsFormatException(() => utf8.decode(malformed));
+  Expect.equals('a�(b',
+      const Utf8Decoder(allowMalformed: true).convert(malformed));
+  Expect.throwsFormatException(() => utf8.decode(bytes([0xC0, 0x80])));
+  Expect.throwsFormatException(
+      () => utf8.decode(bytes([0xF4, 0x90, 0x80, 0x80])));
+  Expect.throwsFormatException(() => utf8.decode(bytes([0xE2, 0x82])));
+}
+
+void testEncode() {
+  Expect.listEquals([0x61, 0x62], utf8.encode('ab'));
+  Expect.listEquals([0x61, 0xC3, 0xA6, 0xC3, 0xBF], utf8.encode('aæÿ'));
+  Expect.listEquals([0xC3, 0xA6], utf8.encode('aæÿ', 1, 2));
+  Expect.listEquals([0xE2, 0x82, 0xAC], utf8.encode('€'));
+}
+
+void testScan() {
+  // Long ASCII runs in chunked decoding.
+  final s = 'x' * 100 + 'é' + 'y' * 100;
+  final encoded = bytes(utf8.encode(s));
+  final sink = new StringBuffer();
+  final conversion = utf8.decoder
+      .startChunkedConversion(new StringConversionSink.fromStringSink(sink));
+  conversion.addSlice(encoded, 0, 101, false);
+  conversion.addSlice(encoded, 101, encoded.length, true);
+  Expect.equals(s, sink.toString());
+}
+
+void testOtherUint8Lists() {
+  // Long enough for the ASCII prefix to be scanned natively.
+  final s = 'x' * 100 + 'æøå €' + 'y' * 100;
+  final encoded = utf8.encode(s);
+  final lists = <Uint8List>[
+    new UnmodifiableUint8ListView(bytes(encoded)),
+    new CustomUint8List(encoded),
+  ];
+  for (final list in lists) {
+    Expect.equals(s, utf8.decode(list));
+    Expect.equals(s.substring(4), utf8.decoder.convert(list, 4));
+
+    final sink = new StringBuffer();
+    final conversion = utf8.decoder
+        .startChunkedConversion(new StringConversionSink.fromStringSink(sink));
+    conversion.addSlice(list, 0, 101, false);
+    conversion.addSlice(list, 101, list.length, true);
+    Expect.equals(s, sink.toString());
+  }
+  Expect.throwsFormatException(() => utf8.decode(
+      new UnmodifiableUint8ListView(bytes([0x61, 0xC3, 0x28, 0x62]))));
+}
+
+void testJson() {
+  final decoder = utf8.decoder.fuse(json.decoder);
+  final map = decoder.convert(bytes(utf8.encode('{"a":"æøå €","b":["x"]}')));
+  Expect.equals('æøå €', map['a']);
+  Expect.equals('x', map['b'][0]);
+  Expect.throwsFormatException(
+      () => decoder.convert(bytes([0x22, 0xC3, 0x28, 0x22])));
+}
+
+void main() {
+  testDecode();
+  testEncode();
+  testScan();
+  testOtherUint8Lists();
+  testJson();
+}
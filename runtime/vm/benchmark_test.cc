@@ -376,6 +376,162 @@ BENCHMARK(DartStringAccess) {
   benchmark->set_score(elapsed_time);
 }
 
+//
+// Measure one-byte string operations over lengths from 8 bytes to 1 MB.
+// Every length processes the same total number of characters.
+//
+static const char* kStringBenchmarkScript =
+    "String makeString(int length) {\n"
+    "  return new String.fromCharCodes(\n"
+    "      new List<int>.generate(length, (i) => 0x61 + i %% 26));\n"
+    "}\n"
+    "\n"
+    "int benchmark() {\n"
+    "  int result = 0;\n"
+    "  for (int length = 8; length <= 1024 * 1024; length *= 2) {\n"
+    "    final a = makeString(length);\n"
+    "    final b = makeString(length);\n"
+    "    final iterations = (16 * 1024 * 1024) ~/ length;\n"
+    "    for (int i = 0; i < iterations; i++) {\n"
+    "      %s\n"
+    "    }\n"
+    "  }\n"
+    "  return result;\n"
+    "}\n";
+
+// Runs the top-level function "benchmark" of [script] once to warm up, then
+// scores a second run.
+static void RunScriptBenchmark(Benchmark* benchmark,
+                               const char* name,
+                               const char* script) {
+  Dart_Handle lib = TestCase::LoadTestScript(script, NULL);
+  EXPECT_VALID(lib);
+
+  // Warmup first to avoid compilation jitters.
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 0, NULL);
+  EXPECT_VALID(result);
+
+  Timer timer(true, name);
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 0, NULL);
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+static void RunStringBenchmark(Benchmark* benchmark,
+                               const char* name,
+                               const char* operation) {
+  char* script = OS::SCreate(NULL, kStringBenchmarkScript, operation);
+  RunScriptBenchmark(benchmark, name, script);
+  free(script);
+}
+
+BENCHMARK(OneByteStringEquality) {
+  RunStringBenchmark(benchmark, "OneByteStringEquality benchmark",
+                     "if (a == b) result++;");
+}
+
+BENCHMARK(OneByteStringIndexOfChar) {
+  RunStringBenchmark(benchmark, "OneByteStringIndexOfChar benchmark",
+                     "result += a.indexOf('#');");
+}
+
+BENCHMARK(OneByteStringIndexOfString) {
+  RunStringBenchmark(benchmark, "OneByteStringIndexOfString benchmark",
+                     "result += a.indexOf('zab#');");
+}
+
+BENCHMARK(OneByteStringToUpperCase) {
+  RunStringBenchmark(benchmark, "OneByteStringToUpperCase benchmark",
+                     "result += a.toUpperCase().length;");
+}
+
+// Looks up keys of maps with [min_size] up to [max_size] entries, growing
+// tenfold each step.
+static const char* kMapBenchmarkScript =
+    "int benchmark() {\n"
+    "  int result = 0;\n"
+    "  for (int size = %" Pd "; size <= %" Pd "; size *= 10) {\n"
+    "    final keys = new List.generate(size, (i) => %s);\n"
+    "    final map = {};\n"
+    "    for (int i = 0; i < size; i++) {\n"
+    "      map[keys[i]] = i;\n"
+    "    }\n"
+    "    for (int i = 0, j = 0; i < 1000 * 1000; i++, j++) {\n"
+    "      if (j == size) j = 0;\n"
+    "      result += map[keys[j]];\n"
+    "    }\n"
+    "  }\n"
+    "  return result;\n"
+    "}\n";
+
+static void RunMapBenchmark(Benchmark* benchmark,
+                            const char* name,
+                            intptr_t min_size,
+                            intptr_t max_size,
+                            const char* key) {
+  char* script =
+      OS::SCreate(NULL, kMapBenchmarkScript, min_size, max_size, key);
+  RunScriptBenchmark(benchmark, name, script);
+  free(script);
+}
+
+BENCHMARK(LinkedHashMapSmiKeys) {
+  RunMapBenchmark(benchmark, "LinkedHashMapSmiKeys benchmark", 1000,
+                  100 * 1000, "i * 7");
+}
+
+BENCHMARK(LinkedHashMapOneByteStringKeys) {
+  RunMapBenchmark(benchmark, "LinkedHashMapOneByteStringKeys benchmark", 1000,
+                  100 * 1000, "'key$i'");
+}
+
+// A single map of 10^7 Smi keys, whose index and data arrays no longer fit
+// in the caches. String keys are left out to bound the memory used.
+BENCHMARK(LinkedHashMapSmiKeysLarge) {
+  RunMapBenchmark(benchmark, "LinkedHashMapSmiKeysLarge benchmark",
+                  10 * 1000 * 1000, 10 * 1000 * 1000, "i * 7");
+}
+
+// Multiplies matrices in loops nested three deep which keep more values live
+// than there are registers, so that spills and reloads placed inside the
+// inner loops show up in the score.
+BENCHMARK(NestedLoopMatrixMultiply) {
+  const char* kScriptChars =
+      "import 'dart:typed_data';\n"
+      "double benchmark() {\n"
+      "  const n = 64;\n"
+      "  final a = new Float64List(n * n);\n"
+      "  final b = new Float64List(n * n);\n"
+      "  final c = new Float64List(n * n);\n"
+      "  for (int i = 0; i < n * n; i++) {\n"
+      "    a[i] = i * 0.5;\n"
+      "    b[i] = i * 0.25;\n"
+      "  }\n"
+      "  double result = 0.0;\n"
+      "  for (int r = 0; r < 100; r++) {\n"
+      "    for (int i = 0; i < n; i++) {\n"
+      "      for (int j = 0; j < n; j++) {\n"
+      "        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;\n"
+      "        for (int k = 0; k < n; k += 4) {\n"
+      "          s0 += a[i * n + k] * b[k * n + j];\n"
+      "          s1 += a[i * n + k + 1] * b[(k + 1) * n + j];\n"
+      "          s2 += a[i * n + k + 2] * b[(k + 2) * n + j];\n"
+      "          s3 += a[i * n + k + 3] * b[(k + 3) * n + j];\n"
+      "        }\n"
+      "        c[i * n + j] = s0 + s1 + s2 + s3;\n"
+      "      }\n"
+      "    }\n"
+      "    result += c[r];\n"
+      "  }\n"
+      "  return result;\n"
+      "}\n";
+  RunScriptBenchmark(benchmark, "NestedLoopMatrixMultiply benchmark",
+                     kScriptChars);
+}
+
 BENCHMARK(Dart2JSCompileAll) {
   bin::Builtin::SetNativeResolver(bin::Builtin::kBuiltinLibrary);
   bin::Builtin::SetNativeResolver(bin::Builtin::kIOLibrary);
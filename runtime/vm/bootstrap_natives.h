@@ -105,6 +105,7 @@ namespace dart {
   V(RegExp_getGroupCount, 1)                                                   \
   V(RegExp_ExecuteMatch, 3)                                                    \
   V(RegExp_ExecuteMatchSticky, 3)                                              \
+  V(RegExp_findCandidate, 3)                                                   \
   V(List_new, 2)                                                               \
   V(List_allocate, 2)                                                          \
   V(List_getIndexed, 2)                                                        \
@@ -121,6 +122,9 @@ namespace dart {
   V(OneByteString_allocate, 1)                                                 \
   V(OneByteString_allocateFromOneByteList, 3)                                  \
   V(OneByteString_setAt, 3)                                                    \
+  V(OneByteString_indexOf, 3)                                                  \
+  V(OneByteString_toLowerCase, 1)                                              \
+  V(OneByteString_toUpperCase, 1)                                              \
   V(TwoByteString_allocateFromTwoByteList, 3)                                  \
   V(String_getHashCode, 1)                                                     \
   V(String_getLength, 1)                                                       \
@@ -131,6 +135,12 @@ namespace dart {
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
   V(String_concatRange, 3)                                                     \
+  V(Utf8_decode, 4)                                                            \
+  V(Utf8_encodeOneByteString, 3)                                               \
+  V(Utf8_scanOneByteCharacters, 3)                                             \
+  V(Json_encode, 1)                                                            \
+  V(Json_parseString, 1)                                                       \
+  V(Json_parseUtf8, 3)                                                         \
   V(Math_sqrt, 1)                                                              \
   V(Math_sin, 1)                                                               \
   V(Math_cos, 1)                                                               \
@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "vm/bootstrap.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/backend/code_statistics.h"
 #include "vm/compiler/relocation.h"
 #include "vm/dart.h"
@@ -4564,6 +4565,15 @@ void Serializer::Serialize() {
         static_cast<CodeSerializationCluster*>(clusters_by_cid_[kCodeCid])
             ->discovered_objects();
 
+    if (!vm_) {
+      const auto& feedback = GrowableObjectArray::Handle(
+          zone_,
+          Isolate::Current()->object_store()->precompiler_type_feedback());
+      if (!feedback.IsNull()) {
+        TypeFeedbackLoader::OrderCodeByUsage(feedback, code_objects);
+      }
+    }
+
     GrowableArray<ImageWriterCommand> writer_commands;
     RelocateCodeObjects(vm_, code_objects, &writer_commands);
     image_writer_->PrepareForSerialization(&writer_commands);
@@ -5695,7 +5705,8 @@ RawApiError* FullSnapshotReader::ReadIsolateSnapshot() {
     // object and store instead (ic_data, entrypoint) in the object pool.
     //
     // Since the actual [entrypoint] is only known at AOT runtime we switch all
-    // existing UnlinkedCall entries in the object pool to be it's entrypoint.
+    // existing UnlinkedCall and DispatchTableCall entries in the object pool
+    // to be their entrypoints.
     auto zone = thread_->zone();
     const auto& pool = ObjectPool::Handle(
         zone, ObjectPool::RawCast(object_store->global_object_pool()));
@@ -5710,6 +5721,12 @@ RawApiError* FullSnapshotReader::ReadIsolateSnapshot() {
           pool.SetTypeAt(i, ObjectPool::EntryType::kImmediate,
                          ObjectPool::Patchability::kPatchable);
           pool.SetObjectAt(i, smi);
+        } else if (entry.raw() == StubCode::DispatchTableCall().raw()) {
+          smi = Smi::FromAlignedAddress(
+              StubCode::DispatchTableCall().MonomorphicEntryPoint());
+          pool.SetTypeAt(i, ObjectPool::EntryType::kImmediate,
+                         ObjectPool::Patchability::kPatchable);
+          pool.SetObjectAt(i, smi);
         }
       }
     }
@@ -6,6 +6,7 @@
 
 #include "vm/compiler/jit/compiler.h"
 #include "vm/globals.h"
+#include "vm/hash_map.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
@@ -483,6 +484,10 @@ TypeFeedbackLoader::TypeFeedbackLoader(Thread* thread)
       args_desc_(Array::Handle(zone_)),
       functions_to_compile_(
           GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+      precompiler_feedback_(
+          GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+      call_sites_feedback_(GrowableObjectArray::Handle(zone_)),
+      call_site_feedback_(GrowableObjectArray::Handle(zone_)),
       error_(Error::Handle(zone_)) {}
 
 RawObject* TypeFeedbackLoader::LoadFeedback(ReadStream* stream) {
@@ -510,6 +515,11 @@ RawObject* TypeFeedbackLoader::LoadFeedback(ReadStream* stream) {
     }
   }
 
+  if (FLAG_precompiled_mode) {
+    thread_->isolate()->object_store()->set_precompiler_type_feedback(
+        precompiler_feedback_);
+  }
+
   while (functions_to_compile_.Length() > 0) {
     func_ ^= functions_to_compile_.RemoveLast();
 
@@ -559,14 +569,21 @@ RawObject* TypeFeedbackLoader::CheckHeader() {
   }
   stream_->Advance(version_len);
 
-  char* expected_features = CompilerFlags();
-  ASSERT(expected_features != NULL);
-  const intptr_t expected_len = strlen(expected_features);
-
   const char* features =
       reinterpret_cast<const char*>(stream_->AddressOfCurrentPosition());
   ASSERT(features != NULL);
   intptr_t buffer_len = Utils::StrNLen(features, stream_->PendingBytes());
+  if (FLAG_precompiled_mode) {
+    // The precompiler only uses the feedback as a hint and validates every
+    // entry against the program it compiles, so JIT-specific flags of the
+    // training run do not need to match.
+    stream_->Advance(buffer_len + 1);
+    return Error::null();
+  }
+
+  char* expected_features = CompilerFlags();
+  ASSERT(expected_features != NULL);
+  const intptr_t expected_len = strlen(expected_features);
   if ((buffer_len != expected_len) ||
       strncmp(features, expected_features, expected_len)) {
     const String& msg = String::Handle(String::NewFormatted(
@@ -703,7 +720,13 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
     }
   }
 
-  if (!skip) {
+  // The precompiler compiles all functions itself, so in precompiled mode the
+  // feedback is only recorded for it.
+  const bool record_only = FLAG_precompiled_mode;
+  if (record_only) {
+    call_sites_feedback_ = GrowableObjectArray::New();
+  }
+  if (!skip && !record_only) {
     error_ = Compiler::CompileFunction(thread_, func_);
     if (error_.IsError()) {
       return error_.raw();
@@ -729,6 +752,42 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
     intptr_t num_checked_arguments = ReadInt();
     intptr_t num_entries = ReadInt();
 
+    if (record_only) {
+      // Only the receiver classes of instance calls are of interest to the
+      // precompiler. Classes are recorded instead of class ids because the
+      // precompiler renumbers classes before compiling.
+      const bool record_call_site = !skip &&
+                                    (rebind_rule == ICData::kInstance) &&
+                                    (num_checked_arguments > 0);
+      call_site_feedback_ = GrowableObjectArray::New();
+      call_site_feedback_.Add(Smi::Handle(zone_, Smi::New(deopt_id)));
+      call_site_feedback_.Add(target_name_);
+      for (intptr_t entry_index = 0; entry_index < num_entries;
+           entry_index++) {
+        intptr_t entry_usage = ReadInt();
+        intptr_t receiver_cid = kIllegalCid;
+        for (intptr_t argument_index = 0;
+             argument_index < num_checked_arguments; argument_index++) {
+          intptr_t cid = cid_map_[ReadInt()];
+          if (argument_index == 0) {
+            receiver_cid = cid;
+          }
+        }
+        if (record_call_site && (receiver_cid != kIllegalCid) &&
+            (entry_usage > 0)) {
+          cls_ = thread_->isolate()->class_table()->At(receiver_cid);
+          call_site_feedback_.Add(cls_);
+          call_site_feedback_.Add(Smi::Handle(zone_, Smi::New(entry_usage)));
+        }
+      }
+      if (record_call_site &&
+          (call_site_feedback_.Length() > kCallSiteFirstReceiver)) {
+        call_sites_feedback_.Add(
+            Array::Handle(zone_, Array::MakeFixedLength(call_site_feedback_)));
+      }
+      continue;
+    }
+
     if (!skip) {
       call_site_ ^= call_sites_.At(i);
       if ((call_site_.deopt_id() != deopt_id) ||
@@ -784,7 +843,17 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
     }
   }
 
-  if (!skip) {
+  if (!skip && record_only) {
+    precompiler_feedback_.Add(func_);
+    precompiler_feedback_.Add(Smi::Handle(zone_, Smi::New(usage)));
+    if (call_sites_feedback_.Length() == 0) {
+      precompiler_feedback_.Add(Object::null_array());
+    } else {
+      precompiler_feedback_.Add(
+          Array::Handle(zone_, Array::MakeFixedLength(call_sites_feedback_)));
+    }
+    ASSERT((precompiler_feedback_.Length() % kFeedbackEntrySize) == 0);
+  } else if (!skip) {
     func_.set_usage_counter(usage);
     func_.set_inlining_depth(inlining_depth);
 
@@ -902,6 +971,73 @@ RawString* TypeFeedbackLoader::ReadString() {
   return Symbols::New(thread_, cstr, len);
 }
 
+struct CodeWithUsage {
+  RawCode* code;
+  intptr_t usage;
+  intptr_t index;
+
+  static int HottestFirst(const CodeWithUsage* a, const CodeWithUsage* b) {
+    if (a->usage != b->usage) {
+      return a->usage > b->usage ? -1 : 1;
+    }
+    return a->index < b->index ? -1 : 1;
+  }
+};
+
+void TypeFeedbackLoader::OrderCodeByUsage(
+    const GrowableObjectArray& feedback,
+    GrowableArray<RawCode*>* code_objects) {
+  Zone* zone = Thread::Current()->zone();
+  DirectChainedHashMap<RawPointerKeyValueTrait<RawFunction, intptr_t> >
+      usage_by_function(zone);
+  auto& function = Function::Handle(zone);
+  for (intptr_t i = 0; i < feedback.Length(); i += kFeedbackEntrySize) {
+    function ^= feedback.At(i + kFeedbackFunction);
+    const intptr_t usage =
+        Smi::Value(Smi::RawCast(feedback.At(i + kFeedbackUsage)));
+    if (usage > 0) {
+      usage_by_function.Insert({function.raw(), usage});
+    }
+  }
+  if (usage_by_function.IsEmpty()) {
+    return;
+  }
+
+  GrowableArray<RawCode*> stubs(zone, code_objects->length());
+  GrowableArray<CodeWithUsage> hot(zone, code_objects->length());
+  GrowableArray<RawCode*> cold(zone, code_objects->length());
+  auto& code = Code::Handle(zone);
+  auto& owner = Object::Handle(zone);
+  for (intptr_t i = 0; i < code_objects->length(); ++i) {
+    code = (*code_objects)[i];
+    owner = code.owner();
+    if (!owner.IsFunction()) {
+      stubs.Add(code.raw());
+      continue;
+    }
+    const intptr_t usage =
+        usage_by_function.LookupValue(Function::Cast(owner).raw());
+    if (usage > 0) {
+      hot.Add({code.raw(), usage, i});
+    } else {
+      cold.Add(code.raw());
+    }
+  }
+  hot.Sort(CodeWithUsage::HottestFirst);
+
+  intptr_t next = 0;
+  for (intptr_t i = 0; i < stubs.length(); ++i) {
+    (*code_objects)[next++] = stubs[i];
+  }
+  for (intptr_t i = 0; i < hot.length(); ++i) {
+    (*code_objects)[next++] = hot[i].code;
+  }
+  for (intptr_t i = 0; i < cold.length(); ++i) {
+    (*code_objects)[next++] = cold[i];
+  }
+  ASSERT(next == code_objects->length());
+}
+
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
 }  // namespace dart
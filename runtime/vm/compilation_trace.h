@@ -82,12 +82,50 @@ class TypeFeedbackSaver : public FunctionVisitor {
   ICData& call_site_;
 };
 
+// Loads feedback written by [TypeFeedbackSaver].
+//
+// In JIT mode the feedback is applied to the ICData of the functions which are
+// then compiled eagerly. In precompiled mode nothing is compiled; instead the
+// feedback is recorded in ObjectStore::precompiler_type_feedback for the
+// precompiler, as a flat list of entries laid out as below.
+//
+// The call sites of an entry are either null or an Array of Arrays, one per
+// instance call site, each holding the deopt id and the target name (without
+// private key) followed by (receiver Class, count) pairs.
 class TypeFeedbackLoader : public ValueObject {
  public:
+  enum {
+    kFeedbackFunction = 0,
+    kFeedbackUsage,
+    kFeedbackCallSites,
+    kFeedbackEntrySize,
+  };
+
+  enum {
+    kCallSiteDeoptId = 0,
+    kCallSiteTargetName,
+    kCallSiteFirstReceiver,
+  };
+
+  enum {
+    kCallSiteReceiverClass = 0,
+    kCallSiteReceiverCount,
+    kCallSiteReceiverEntrySize,
+  };
+
   explicit TypeFeedbackLoader(Thread* thread);
 
   RawObject* LoadFeedback(ReadStream* stream);
 
+  // Orders [code_objects] for the text section of an AOT snapshot using
+  // recorded [feedback]. Stubs, which are not owned by a function and are
+  // shared by all callers, come first. Code of functions which ran during
+  // training follows, hottest first, so that hot code shares cache lines and
+  // pages. Code which never ran forms a cold region at the end, in discovery
+  // order. Nothing is reordered if no function ran.
+  static void OrderCodeByUsage(const GrowableObjectArray& feedback,
+                               GrowableArray<RawCode*>* code_objects);
+
  private:
   RawObject* CheckHeader();
   RawObject* LoadClasses();
@@ -119,6 +157,9 @@ class TypeFeedbackLoader : public ValueObject {
   Function& target_;
   Array& args_desc_;
   GrowableObjectArray& functions_to_compile_;
+  GrowableObjectArray& precompiler_feedback_;
+  GrowableObjectArray& call_sites_feedback_;
+  GrowableObjectArray& call_site_feedback_;
   Object& error_;
 };
 
@@ -0,0 +1,93 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compilation_trace.h"
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/stub_code.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+static RawCode* LookupCode(Thread* thread,
+                           const Library& lib,
+                           const char* name) {
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, name))));
+  EXPECT(function.HasCode());
+  return function.CurrentCode();
+}
+
+static void AddFeedback(const GrowableObjectArray& feedback,
+                        const Code& code,
+                        intptr_t usage) {
+  const intptr_t start = feedback.Length();
+  for (intptr_t i = 0; i < TypeFeedbackLoader::kFeedbackEntrySize; i++) {
+    feedback.Add(Object::null_object());
+  }
+  feedback.SetAt(start + TypeFeedbackLoader::kFeedbackFunction,
+                 Object::Handle(code.owner()));
+  feedback.SetAt(start + TypeFeedbackLoader::kFeedbackUsage,
+                 Smi::Handle(Smi::New(usage)));
+}
+
+TEST_CASE(TypeFeedbackLoader_OrderCodeByUsage) {
+  const char* script_chars =
+      "class A {}\n"
+      "warm() => 1;\n"
+      "hot() => 2;\n"
+      "cold() => 3;\n"
+      "main() {\n"
+      "  new A();\n"
+      "  return warm() + hot() + cold();\n"
+      "}\n";
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  EXPECT_VALID(Dart_Invoke(script, NewString("main"), 0, NULL));
+
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+  const Code& warm = Code::Handle(LookupCode(thread, lib, "warm"));
+  const Code& hot = Code::Handle(LookupCode(thread, lib, "hot"));
+  const Code& cold = Code::Handle(LookupCode(thread, lib, "cold"));
+  const Class& cls = Class::Handle(
+      lib.LookupLocalClass(String::Handle(Symbols::New(thread, "A"))));
+  const Code& allocation_stub =
+      Code::Handle(StubCode::GetAllocationStubForClass(cls));
+  const Code& shared_stub = StubCode::AllocateArray();
+
+  GrowableArray<RawCode*> code_objects;
+  const GrowableObjectArray& feedback =
+      GrowableObjectArray::Handle(GrowableObjectArray::New());
+
+  // Without usage nothing is reordered.
+  code_objects.Add(cold.raw());
+  code_objects.Add(warm.raw());
+  code_objects.Add(shared_stub.raw());
+  code_objects.Add(hot.raw());
+  code_objects.Add(allocation_stub.raw());
+  AddFeedback(feedback, cold, 0);
+  TypeFeedbackLoader::OrderCodeByUsage(feedback, &code_objects);
+  EXPECT_EQ(cold.raw(), code_objects[0]);
+  EXPECT_EQ(allocation_stub.raw(), code_objects[4]);
+
+  // Stubs come first in discovery order, then the functions that ran,
+  // hottest first, then the rest.
+  AddFeedback(feedback, warm, 10);
+  AddFeedback(feedback, hot, 1000);
+  TypeFeedbackLoader::OrderCodeByUsage(feedback, &code_objects);
+  EXPECT_EQ(5, code_objects.length());
+  EXPECT_EQ(shared_stub.raw(), code_objects[0]);
+  EXPECT_EQ(allocation_stub.raw(), code_objects[1]);
+  EXPECT_EQ(hot.raw(), code_objects[2]);
+  EXPECT_EQ(warm.raw(), code_objects[3]);
+  EXPECT_EQ(cold.raw(), code_objects[4]);
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
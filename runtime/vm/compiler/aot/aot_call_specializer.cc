@@ -5,6 +5,7 @@
 #include "vm/compiler/aot/aot_call_specializer.h"
 
 #include "vm/bit_vector.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -37,6 +38,8 @@ DEFINE_FLAG(int,
             "If a call receiver is known to be of at most this many classes, "
             "generate exhaustive class tests instead of a megamorphic call");
 
+DECLARE_FLAG(bool, trace_precompiler);
+
 // Quick access to the current isolate and zone.
 #define I (isolate())
 #define Z (zone())
@@ -137,12 +140,99 @@ bool AotCallSpecializer::TryCreateICDataForUniqueTarget(
   return true;
 }
 
+bool AotCallSpecializer::TryCreateICDataFromFeedback(InstanceCallInstr* call) {
+  if ((precompiler_ == NULL) || (call->ic_data()->NumberOfUsedChecks() > 0)) {
+    return false;
+  }
+
+  // Feedback is keyed by the deopt ids of the function it was recorded for,
+  // so it cannot be applied to calls which were inlined from other functions.
+  if (call->inlining_id() > 0) {
+    return false;
+  }
+
+  const Array& call_site = Array::Handle(
+      Z, precompiler_->CallSiteFeedbackOf(flow_graph()->function(),
+                                          call->deopt_id()));
+  if (call_site.IsNull()) {
+    return false;
+  }
+  const intptr_t num_receivers =
+      (call_site.Length() - TypeFeedbackLoader::kCallSiteFirstReceiver) /
+      TypeFeedbackLoader::kCallSiteReceiverEntrySize;
+  if ((num_receivers == 0) || (num_receivers > FLAG_max_polymorphic_checks)) {
+    // Megamorphic in the training run: nothing to specialize for.
+    return false;
+  }
+
+  // The deopt ids of JIT and AOT compilations of a function are expected to
+  // match, but verify the selector to be safe.
+  String& name = String::Handle(Z, call->function_name().raw());
+  name = String::RemovePrivateKey(name);
+  const String& recorded_name = String::Cast(Object::Handle(
+      Z, call_site.At(TypeFeedbackLoader::kCallSiteTargetName)));
+  if (!name.Equals(recorded_name)) {
+    return false;
+  }
+
+  const ICData& ic_data =
+      ICData::ZoneHandle(Z, ICData::NewFrom(*call->ic_data(), 1));
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (intptr_t i = TypeFeedbackLoader::kCallSiteFirstReceiver;
+       i < call_site.Length();
+       i += TypeFeedbackLoader::kCallSiteReceiverEntrySize) {
+    cls ^= call_site.At(i + TypeFeedbackLoader::kCallSiteReceiverClass);
+    const intptr_t count = Smi::Value(Smi::RawCast(
+        call_site.At(i + TypeFeedbackLoader::kCallSiteReceiverCount)));
+    if (!cls.is_finalized() || (cls.id() == kIllegalCid)) {
+      continue;
+    }
+    // See VisitInstanceCall for why lazily injected dispatchers are not
+    // accepted as targets.
+    target = call->ResolveForReceiverClass(cls);
+    if (target.IsNull() || target.IsMethodExtractor() ||
+        target.IsInvokeFieldDispatcher()) {
+      continue;
+    }
+    bool found = false;
+    for (intptr_t j = 0; j < ic_data.NumberOfChecks(); j++) {
+      if (ic_data.GetReceiverClassIdAt(j) == cls.id()) {
+        ic_data.IncrementCountAt(j, count);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      ic_data.AddReceiverCheck(cls.id(), target, count);
+    }
+  }
+  if (ic_data.NumberOfUsedChecks() == 0) {
+    return false;
+  }
+
+  if (FLAG_trace_optimization || FLAG_trace_precompiler) {
+    THR_Print("Using training feedback for %s: %s\n",
+              flow_graph()->function().ToFullyQualifiedCString(),
+              ic_data.ToCString());
+  }
+  call->set_ic_data(&ic_data);
+  return true;
+}
+
 bool AotCallSpecializer::TryCreateICData(InstanceCallInstr* call) {
   if (TryCreateICDataForUniqueTarget(call)) {
     return true;
   }
 
-  return CallSpecializer::TryCreateICData(call);
+  if (CallSpecializer::TryCreateICData(call)) {
+    return true;
+  }
+
+  // Receiver classes observed in a training run let VisitInstanceCall emit
+  // class checks for the likely targets, which can be inlined, with a
+  // fallback to the regular instance call.
+  return TryCreateICDataFromFeedback(call);
 }
 
 bool AotCallSpecializer::RecognizeRuntimeTypeGetter(InstanceCallInstr* call) {
@@ -34,6 +34,10 @@ class AotCallSpecializer : public CallSpecializer {
 
   bool TryCreateICDataForUniqueTarget(InstanceCallInstr* call);
 
+  // Attempt to build ICData for call using type feedback recorded in a
+  // training run.
+  bool TryCreateICDataFromFeedback(InstanceCallInstr* call);
+
   bool RecognizeRuntimeTypeGetter(InstanceCallInstr* call);
   bool TryReplaceWithHaveSameRuntimeType(TemplateDartCall<0>* call);
 
@@ -0,0 +1,219 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+
+#include "vm/class_table.h"
+#include "vm/dart_entry.h"
+#include "vm/log.h"
+#include "vm/object.h"
+
+namespace dart {
+
+intptr_t RowDisplacementPacker::Place(const GrowableArray<intptr_t>& cids) {
+  ASSERT(!cids.is_empty());
+  const intptr_t min_cid = cids[0];
+
+  // The first entry of the row has to land on a free slot, so only offsets
+  // which map [min_cid] to a free slot are candidates.
+  intptr_t offset = first_free_ - min_cid;
+  while (used_offsets_.Lookup(offset) || !Fits(cids, offset)) {
+    offset++;
+  }
+  used_offsets_.Insert(offset, true);
+
+  for (intptr_t i = 0; i < cids.length(); i++) {
+    Occupy(offset + cids[i]);
+  }
+  while (first_free_ < occupied_.length() && occupied_[first_free_]) {
+    first_free_++;
+  }
+  return offset;
+}
+
+bool RowDisplacementPacker::Fits(const GrowableArray<intptr_t>& cids,
+                                 intptr_t offset) const {
+  for (intptr_t i = 0; i < cids.length(); i++) {
+    const intptr_t index = offset + cids[i];
+    if (index < 0) return false;
+    if (index < occupied_.length() && occupied_[index]) return false;
+  }
+  return true;
+}
+
+void RowDisplacementPacker::Occupy(intptr_t index) {
+  ASSERT(index >= 0);
+  occupied_.EnsureLength(index + 1, false);
+  ASSERT(!occupied_[index]);
+  occupied_[index] = true;
+}
+
+// The packer has no dependencies on the precompiler and is unit tested in
+// all configurations.
+#if defined(DART_PRECOMPILER)
+
+DispatchTableGenerator::DispatchTableGenerator(Zone* zone)
+    : zone_(zone),
+      rows_(zone, 1024),
+      rows_by_name_(zone),
+      num_entries_(0),
+      table_length_(0) {}
+
+void DispatchTableGenerator::Initialize(ClassTable* class_table) {
+  CollectRows(class_table);
+  ComputeSelectorOffsets();
+}
+
+SelectorRow* DispatchTableGenerator::GetOrCreateRow(const String& name) {
+  SelectorRow* row = rows_by_name_.LookupValue(&name);
+  if (row == NULL) {
+    row = new (zone_) SelectorRow(zone_, rows_.length(), name);
+    rows_.Add(row);
+    rows_by_name_.Insert(row);
+  }
+  return row;
+}
+
+void DispatchTableGenerator::CollectRows(ClassTable* class_table) {
+  Class& cls = Class::Handle(zone_);
+  Class& owner = Class::Handle(zone_);
+  Array& functions = Array::Handle(zone_);
+  Function& function = Function::Handle(zone_);
+  String& name = String::Handle(zone_);
+
+  const intptr_t num_cids = class_table->NumCids();
+  for (intptr_t cid = kIllegalCid + 1; cid < num_cids; cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    if (cls.IsTopLevel() || cls.is_abstract() || !cls.is_allocated()) {
+      continue;
+    }
+
+    // Walk up the superclass chain. The first member with a given name is
+    // the one the resolver finds for [cid], even if it has no code, so
+    // members further up are skipped.
+    for (owner = cls.raw(); !owner.IsNull(); owner = owner.SuperClass()) {
+      functions = owner.functions();
+      if (functions.IsNull()) continue;
+      for (intptr_t i = 0; i < functions.Length(); i++) {
+        function ^= functions.At(i);
+        if (!function.IsDynamicFunction()) {
+          continue;
+        }
+        name = function.name();
+        SelectorRow* row = GetOrCreateRow(name);
+        if (row->visited_cid() == cid) {
+          continue;
+        }
+        row->set_visited_cid(cid);
+        if (!function.HasCode()) {
+          continue;
+        }
+        row->Add(cid, Function::ZoneHandle(zone_, function.raw()));
+        num_entries_++;
+      }
+    }
+  }
+}
+
+static int CompareRows(SelectorRow* const* a, SelectorRow* const* b) {
+  // Larger rows first; among rows of equal size place the wider ones first
+  // since they are harder to fit.
+  if ((*a)->length() != (*b)->length()) {
+    return (*a)->length() > (*b)->length() ? -1 : 1;
+  }
+  if ((*a)->span() != (*b)->span()) {
+    return (*a)->span() > (*b)->span() ? -1 : 1;
+  }
+  return (*a)->selector_id() < (*b)->selector_id() ? -1 : 1;
+}
+
+void DispatchTableGenerator::ComputeSelectorOffsets() {
+  GrowableArray<SelectorRow*> sorted(zone_, rows_.length());
+  for (intptr_t i = 0; i < rows_.length(); i++) {
+    if (rows_[i]->length() > 0) {
+      sorted.Add(rows_[i]);
+    }
+  }
+  sorted.Sort(CompareRows);
+
+  RowDisplacementPacker packer(zone_);
+  GrowableArray<intptr_t> cids(zone_, 16);
+  for (intptr_t i = 0; i < sorted.length(); i++) {
+    SelectorRow* row = sorted[i];
+    cids.Clear();
+    for (intptr_t j = 0; j < row->length(); j++) {
+      cids.Add(row->CidAt(j));
+    }
+    row->set_offset(packer.Place(cids));
+  }
+  table_length_ = packer.table_length();
+}
+
+intptr_t DispatchTableGenerator::SelectorOffset(const String& selector) const {
+  SelectorRow* row = rows_by_name_.LookupValue(&selector);
+  if (row == NULL) {
+    return SelectorRow::kUnassignedOffset;
+  }
+  return row->offset();
+}
+
+intptr_t DispatchTableGenerator::CallSiteOffset(
+    const String& selector,
+    const ArgumentsDescriptor& args_desc) const {
+  SelectorRow* row = rows_by_name_.LookupValue(&selector);
+  if (row == NULL || row->length() == 0) {
+    return SelectorRow::kUnassignedOffset;
+  }
+  for (intptr_t i = 0; i < row->length(); i++) {
+    if (!row->TargetAt(i).AreValidArguments(args_desc, NULL)) {
+      return SelectorRow::kUnassignedOffset;
+    }
+  }
+  return row->offset();
+}
+
+RawArray* DispatchTableGenerator::BuildTable() const {
+  const Array& table =
+      Array::Handle(zone_, Array::New(2 * table_length_, Heap::kOld));
+  Smi& offset = Smi::Handle(zone_);
+  Code& code = Code::Handle(zone_);
+  for (intptr_t i = 0; i < rows_.length(); i++) {
+    SelectorRow* row = rows_[i];
+    if (row->length() == 0) continue;
+    offset = Smi::New(row->offset());
+    for (intptr_t j = 0; j < row->length(); j++) {
+      const intptr_t index = row->offset() + row->CidAt(j);
+      ASSERT(table.At(2 * index) == Object::null());
+      code = row->TargetAt(j).CurrentCode();
+      table.SetAt(2 * index, offset);
+      table.SetAt(2 * index + 1, code);
+    }
+  }
+  return table.raw();
+}
+
+void DispatchTableGenerator::PrintStatistics() const {
+  intptr_t max_row_length = 0;
+  intptr_t single_target_rows = 0;
+  for (intptr_t i = 0; i < rows_.length(); i++) {
+    SelectorRow* row = rows_[i];
+    max_row_length = Utils::Maximum(max_row_length, row->length());
+    if (row->length() == 1) {
+      single_target_rows++;
+    }
+  }
+  const intptr_t fill_percent =
+      (table_length_ == 0) ? 100 : (100 * num_entries_) / table_length_;
+  THR_Print("Dispatch table: %" Pd " selectors (%" Pd
+            " with a single target), %" Pd " entries, longest row %" Pd "\n",
+            rows_.length(), single_target_rows, num_entries_, max_row_length);
+  THR_Print("Dispatch table: %" Pd " slots, %" Pd "%% filled, %" Pd
+            " bytes\n",
+            table_length_, fill_percent, table_length_ * kWordSize);
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
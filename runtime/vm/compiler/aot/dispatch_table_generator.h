@@ -0,0 +1,179 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+#define RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class ArgumentsDescriptor;
+class ClassTable;
+
+// One row of the global dispatch table: for a single selector the list of
+// (cid, target) pairs for every concrete, allocated class that understands
+// the selector. Entries are kept sorted by cid.
+class SelectorRow : public ZoneAllocated {
+ public:
+  SelectorRow(Zone* zone, intptr_t selector_id, const String& name)
+      : selector_id_(selector_id),
+        name_(String::ZoneHandle(zone, name.raw())),
+        cids_(zone, 2),
+        targets_(zone, 2),
+        offset_(kUnassignedOffset),
+        visited_cid_(kIllegalCid) {}
+
+  static const intptr_t kUnassignedOffset = kMinInt32;
+
+  intptr_t selector_id() const { return selector_id_; }
+  const String& name() const { return name_; }
+
+  void Add(intptr_t cid, const Function& target) {
+    ASSERT(cids_.is_empty() || cids_.Last() < cid);
+    cids_.Add(cid);
+    targets_.Add(&target);
+  }
+
+  intptr_t length() const { return cids_.length(); }
+  intptr_t CidAt(intptr_t i) const { return cids_[i]; }
+  const Function& TargetAt(intptr_t i) const { return *targets_[i]; }
+
+  intptr_t min_cid() const { return cids_[0]; }
+  intptr_t max_cid() const { return cids_.Last(); }
+  intptr_t span() const { return max_cid() - min_cid() + 1; }
+
+  // Selector offset: the table index for receiver class [cid] is
+  // [offset + cid].
+  intptr_t offset() const { return offset_; }
+  void set_offset(intptr_t offset) { offset_ = offset; }
+
+  // The last class for which a member with this name was seen while walking
+  // up its superclass chain. Members further up the chain are overridden.
+  intptr_t visited_cid() const { return visited_cid_; }
+  void set_visited_cid(intptr_t cid) { visited_cid_ = cid; }
+
+ private:
+  const intptr_t selector_id_;
+  const String& name_;
+  GrowableArray<intptr_t> cids_;
+  GrowableArray<const Function*> targets_;
+  intptr_t offset_;
+  intptr_t visited_cid_;
+
+  DISALLOW_COPY_AND_ASSIGN(SelectorRow);
+};
+
+// Packs selector rows into a single one-dimensional table using row
+// displacement: every row is shifted by a selector specific offset such that
+// no two rows occupy the same table slot. Rows are placed first-fit in order
+// of decreasing size, which keeps the table dense for the typical
+// distribution (a few large rows for Object members, many tiny ones).
+//
+// No two rows share an offset, so a table slot can be checked against the
+// offset of the call site's selector to detect receivers without a target.
+class RowDisplacementPacker : public ValueObject {
+ public:
+  explicit RowDisplacementPacker(Zone* zone)
+      : occupied_(zone, 1024), used_offsets_(), first_free_(0) {}
+
+  // Returns the offset assigned to a row with the given (sorted) [cids].
+  intptr_t Place(const GrowableArray<intptr_t>& cids);
+
+  // Length of the table required to hold all rows placed so far.
+  intptr_t table_length() const { return occupied_.length(); }
+
+ private:
+  bool Fits(const GrowableArray<intptr_t>& cids, intptr_t offset) const;
+  void Occupy(intptr_t index);
+
+  GrowableArray<bool> occupied_;
+  IntMap<bool> used_offsets_;
+  // All slots below this index are occupied.
+  intptr_t first_free_;
+
+  DISALLOW_COPY_AND_ASSIGN(RowDisplacementPacker);
+};
+
+#if defined(DART_PRECOMPILER)
+
+// Builds the AOT global dispatch table from the classes and functions that
+// survived tree shaking.
+//
+// Every dynamic (instance) member name is a selector. For every concrete
+// allocated class the generator resolves the selector along the superclass
+// chain and records the compiled target in the selector's row. The rows are
+// then packed with [RowDisplacementPacker] so that an interface call
+// `o.m(...)` can be dispatched as a single indexed load of
+// `table[offset(m) + o.cid]` followed by a call.
+//
+// The table is emitted into the snapshot as an array of (selector offset,
+// target code) pairs, see [BuildTable]. Switchable call sites whose selector
+// has a row are linked to [StubCode::DispatchTableCall], which falls back to
+// the regular switchable call miss handling when the slot for the receiver
+// class belongs to another selector.
+class DispatchTableGenerator : public ValueObject {
+ public:
+  explicit DispatchTableGenerator(Zone* zone);
+
+  // Collects the selector rows from all classes in [class_table] and
+  // computes the selector offsets.
+  void Initialize(ClassTable* class_table);
+
+  // Returns the offset of [selector] or [SelectorRow::kUnassignedOffset] if
+  // no allocated class implements the selector.
+  intptr_t SelectorOffset(const String& selector) const;
+
+  // Returns the offset of [selector] if every target in its row accepts
+  // calls with [args_desc], [SelectorRow::kUnassignedOffset] otherwise.
+  intptr_t CallSiteOffset(const String& selector,
+                          const ArgumentsDescriptor& args_desc) const;
+
+  // Returns the table as an array with two elements per slot: the offset of
+  // the selector owning the slot as a Smi and the target Code. Unused slots
+  // are null.
+  RawArray* BuildTable() const;
+
+  intptr_t num_selectors() const { return rows_.length(); }
+  intptr_t num_entries() const { return num_entries_; }
+  intptr_t table_length() const { return table_length_; }
+
+  void PrintStatistics() const;
+
+ private:
+  class SelectorTrait {
+   public:
+    typedef const String* Key;
+    typedef SelectorRow* Value;
+    typedef SelectorRow* Pair;
+
+    static Key KeyOf(Pair kv) { return &kv->name(); }
+    static Value ValueOf(Pair kv) { return kv; }
+    static inline intptr_t Hashcode(Key key) { return key->Hash(); }
+    static inline bool IsKeyEqual(Pair kv, Key key) {
+      return kv->name().raw() == key->raw();
+    }
+  };
+
+  SelectorRow* GetOrCreateRow(const String& name);
+  void CollectRows(ClassTable* class_table);
+  void ComputeSelectorOffsets();
+
+  Zone* zone_;
+  GrowableArray<SelectorRow*> rows_;
+  DirectChainedHashMap<SelectorTrait> rows_by_name_;
+  intptr_t num_entries_;
+  intptr_t table_length_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTableGenerator);
+};
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
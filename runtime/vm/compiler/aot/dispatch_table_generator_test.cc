@@ -0,0 +1,56 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#define Z (thread->zone())
+
+static void AddCids(GrowableArray<intptr_t>* cids,
+                    intptr_t from,
+                    intptr_t to,
+                    intptr_t step) {
+  cids->Clear();
+  for (intptr_t cid = from; cid <= to; cid += step) {
+    cids->Add(cid);
+  }
+}
+
+TEST_CASE(RowDisplacementPacker) {
+  RowDisplacementPacker packer(Z);
+  GrowableArray<intptr_t> cids(Z, 16);
+
+  // A dense row starting at cid 10 is shifted down to the start of the table.
+  AddCids(&cids, 10, 19, 1);
+  EXPECT_EQ(-10, packer.Place(cids));
+  EXPECT_EQ(10, packer.table_length());
+
+  // A sparse row would fit at the same offset, but offsets are unique, so it
+  // is placed one slot further, right after the dense one.
+  AddCids(&cids, 20, 28, 2);
+  const intptr_t sparse_offset = packer.Place(cids);
+  EXPECT_EQ(-9, sparse_offset);
+  EXPECT_EQ(20, packer.table_length());
+
+  // A second sparse row interleaves with the holes of the first one.
+  AddCids(&cids, 20, 26, 2);
+  EXPECT_EQ(sparse_offset + 1, packer.Place(cids));
+  EXPECT_EQ(20, packer.table_length());
+
+  // A single entry row fills the hole left between the dense and the sparse
+  // rows.
+  AddCids(&cids, 5, 5, 1);
+  EXPECT_EQ(5, packer.Place(cids));
+  EXPECT_EQ(20, packer.table_length());
+
+  // The table has no holes left, so the next row is appended.
+  AddCids(&cids, 0, 0, 1);
+  EXPECT_EQ(20, packer.Place(cids));
+  EXPECT_EQ(21, packer.table_length());
+}
+
+}  // namespace dart
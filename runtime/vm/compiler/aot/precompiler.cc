@@ -6,7 +6,9 @@
 
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
 #include "vm/compiler/backend/block_scheduler.h"
@@ -61,6 +63,19 @@ namespace dart {
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynamic targets");
 DEFINE_FLAG(bool, print_gop, false, "Print global object pool");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(bool,
+            print_dispatch_table_stats,
+            false,
+            "Print the size of the global selector dispatch table.");
+DEFINE_FLAG(bool,
+            use_dispatch_table,
+            true,
+            "Load the targets of switchable calls from the global selector "
+            "dispatch table.");
+DEFINE_FLAG(bool,
+            use_effect_summaries,
+            true,
+            "Forward loads across calls to functions with known effects.");
 DEFINE_FLAG(
     int,
     max_speculative_inlining_attempts,
@@ -88,6 +103,35 @@ DECLARE_FLAG(bool, print_instruction_stats);
 
 Precompiler* Precompiler::singleton_ = nullptr;
 
+// The type feedback is also used by the inliner and AOT call specializer,
+// which are built with DART_PRECOMPILER on all architectures.
+#if defined(DART_PRECOMPILER)
+
+intptr_t Precompiler::FeedbackUsageOf(const Function& function) const {
+  const intptr_t index = feedback_by_function_.LookupValue(&function);
+  if (index < 0) {
+    return 0;
+  }
+  return Smi::Value(Smi::RawCast(
+      type_feedback_.At(index + TypeFeedbackLoader::kFeedbackUsage)));
+}
+
+bool Precompiler::IsHotInTrainingRun(const Function& function) const {
+  return FeedbackUsageOf(function) >= FLAG_optimization_counter_threshold;
+}
+
+RawArray* Precompiler::CallSiteFeedbackOf(const Function& function,
+                                          intptr_t deopt_id) const {
+  const intptr_t index = feedback_by_function_.LookupValue(&function);
+  if (index < 0) {
+    return Array::null();
+  }
+  const Array* call_site = call_site_feedback_.LookupValue({index, deopt_id});
+  return (call_site == NULL) ? Array::null() : call_site->raw();
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
 #if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
     !defined(TARGET_ARCH_IA32)
 
@@ -176,6 +220,11 @@ Precompiler::Precompiler(Thread* thread)
       typeargs_to_retain_(),
       types_to_retain_(),
       consts_to_retain_(),
+      feedback_by_function_(),
+      call_site_feedback_(),
+      type_feedback_(GrowableObjectArray::Handle(
+          I->object_store()->precompiler_type_feedback())),
+      effect_summaries_(NULL),
       error_(Error::Handle()),
       get_runtime_type_is_unique_(false) {
   ASSERT(Precompiler::singleton_ == NULL);
@@ -193,6 +242,7 @@ void Precompiler::DoCompileAll() {
   {
     StackZone stack_zone(T);
     zone_ = stack_zone.GetZone();
+    effect_summaries_ = new (zone_) EffectSummaryTable(zone_);
 
     if (FLAG_use_bare_instructions) {
       // Since we keep the object pool until the end of AOT compilation, it
@@ -212,6 +262,9 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // Index the type feedback of a training run, if any was loaded.
+      LoadTypeFeedback();
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -350,12 +403,16 @@ void Precompiler::DoCompileAll() {
     DropClasses();
     DropLibraries();
 
+    DispatchTableGenerator dispatch_table(Z);
+    ComputeDispatchTable(&dispatch_table);
+
     BindStaticCalls();
-    SwitchICCalls();
+    SwitchICCalls(dispatch_table);
     Obfuscate();
 
     ProgramVisitor::Dedup();
 
+    effect_summaries_ = NULL;
     zone_ = NULL;
   }
 
@@ -384,6 +441,56 @@ void Precompiler::DoCompileAll() {
   }
 }
 
+void Precompiler::LoadTypeFeedback() {
+  if (type_feedback_.IsNull()) {
+    return;
+  }
+  Array& call_sites = Array::Handle(Z);
+  for (intptr_t i = 0; i < type_feedback_.Length();
+       i += TypeFeedbackLoader::kFeedbackEntrySize) {
+    const Function& function = Function::ZoneHandle(
+        Z, Function::RawCast(type_feedback_.At(
+               i + TypeFeedbackLoader::kFeedbackFunction)));
+    feedback_by_function_.Insert(
+        FunctionFeedbackKeyValueTrait::Pair(&function, i));
+    call_sites = Array::RawCast(
+        type_feedback_.At(i + TypeFeedbackLoader::kFeedbackCallSites));
+    if (call_sites.IsNull()) {
+      continue;
+    }
+    for (intptr_t j = 0; j < call_sites.Length(); j++) {
+      const Array& call_site =
+          Array::ZoneHandle(Z, Array::RawCast(call_sites.At(j)));
+      const intptr_t deopt_id = Smi::Value(
+          Smi::RawCast(call_site.At(TypeFeedbackLoader::kCallSiteDeoptId)));
+      call_site_feedback_.Insert(
+          CallSiteFeedbackKeyValueTrait::Pair({i, deopt_id}, &call_site));
+    }
+  }
+  if (FLAG_trace_precompiler) {
+    THR_Print("Loaded type feedback for %" Pd " functions\n",
+              type_feedback_.Length() / TypeFeedbackLoader::kFeedbackEntrySize);
+  }
+}
+
+void Precompiler::RecordEffectSummary(const Function& function,
+                                      FlowGraph* flow_graph) {
+  if (!FLAG_use_effect_summaries) {
+    return;
+  }
+  // Summaries are kept for the whole compilation, so they are allocated in
+  // the precompiler's zone rather than in the zone of the current function.
+  const EffectSummary* summary = EffectSummary::Compute(zone_, flow_graph);
+  // Constructors are compiled again after PrecompileConstructors, so this
+  // may replace an earlier summary.
+  effect_summaries_->Record(function, summary);
+  if (FLAG_trace_precompiler && (summary != NULL)) {
+    THR_Print("Effects of %s: ", function.ToQualifiedCString());
+    summary->Print();
+    THR_Print("\n");
+  }
+}
+
 void Precompiler::PrecompileConstructors() {
   class ConstructorVisitor : public FunctionVisitor {
    public:
@@ -1921,6 +2028,22 @@ void Precompiler::DropLibraries() {
   libraries_ = retained_libraries.raw();
 }
 
+void Precompiler::ComputeDispatchTable(DispatchTableGenerator* generator) {
+  ASSERT(!I->compilation_allowed());
+  HANDLESCOPE(T);
+  // Lay out the selector rows of all retained classes with row displacement
+  // and emit the table into the snapshot. Switchable calls are linked to it
+  // in SwitchICCalls.
+  generator->Initialize(I->class_table());
+  I->object_store()->set_dispatch_table(
+      Array::Handle(Z, generator->BuildTable()));
+  if (FLAG_print_dispatch_table_stats) {
+    generator->PrintStatistics();
+    THR_Print("Dispatch table: %" Pd " dynamic selectors sent\n",
+              selector_count_);
+  }
+}
+
 void Precompiler::BindStaticCalls() {
   class BindAOTStaticCallsVisitor : public FunctionVisitor {
    public:
@@ -1998,7 +2121,17 @@ void Precompiler::BindStaticCalls() {
   }
 }
 
-void Precompiler::SwitchICCalls() {
+#if !defined(TARGET_ARCH_DBC)
+// Index of a switchable call's target in the object pool relative to the
+// index of its data, see FlowGraphCompiler::EmitSwitchableInstanceCall.
+#if defined(TARGET_ARCH_ARM64)
+static const intptr_t kSwitchableCallTargetIndexDelta = 1;
+#else
+static const intptr_t kSwitchableCallTargetIndexDelta = -1;
+#endif
+#endif  // !defined(TARGET_ARCH_DBC)
+
+void Precompiler::SwitchICCalls(const DispatchTableGenerator& dispatch_table) {
   ASSERT(!I->compilation_allowed());
 #if !defined(TARGET_ARCH_DBC)
   // Now that all functions have been compiled, we can switch to an instance
@@ -2007,16 +2140,21 @@ void Precompiler::SwitchICCalls() {
   // array. Iterate all the object pools and rewrite the ic data from
   // (cid, target function, count) to (cid, target code, entry point), and
   // replace the ICCallThroughFunction stub with ICCallThroughCode.
+  //
+  // Call sites whose selector has a row in the dispatch table start out
+  // calling the DispatchTableCall stub instead of the UnlinkedCall stub.
   class ICCallSwitcher {
    public:
-    explicit ICCallSwitcher(Zone* zone)
+    ICCallSwitcher(Zone* zone, const DispatchTableGenerator& dispatch_table)
         : zone_(zone),
+          dispatch_table_(dispatch_table),
           entry_(Object::Handle(zone)),
           ic_(ICData::Handle(zone)),
           target_name_(String::Handle(zone)),
           args_descriptor_(Array::Handle(zone)),
           unlinked_(UnlinkedCall::Handle(zone)),
           target_code_(Code::Handle(zone)),
+          offset_(Smi::Handle(zone)),
           canonical_unlinked_calls_() {}
 
     void SwitchPool(const ObjectPool& pool) {
@@ -2038,6 +2176,15 @@ void Precompiler::SwitchICCalls() {
           unlinked_.set_args_descriptor(args_descriptor_);
           unlinked_ = DedupUnlinkedCall(unlinked_);
           pool.SetObjectAt(i, unlinked_);
+          if (unlinked_.dispatch_table_offset() != Smi::null()) {
+            const intptr_t target_index = i + kSwitchableCallTargetIndexDelta;
+            ASSERT(pool.ObjectAt(target_index) ==
+                       StubCode::ICCallThroughFunction().raw() ||
+                   pool.ObjectAt(target_index) ==
+                       StubCode::UnlinkedCall().raw());
+            target_code_ = StubCode::DispatchTableCall().raw();
+            pool.SetObjectAt(target_index, target_code_);
+          }
         } else if (entry_.raw() == StubCode::ICCallThroughFunction().raw()) {
           target_code_ = StubCode::UnlinkedCall().raw();
           pool.SetObjectAt(i, target_code_);
@@ -2049,6 +2196,7 @@ void Precompiler::SwitchICCalls() {
       const UnlinkedCall* canonical_unlinked =
           canonical_unlinked_calls_.LookupValue(&unlinked);
       if (canonical_unlinked == NULL) {
+        SetDispatchTableOffset(unlinked);
         canonical_unlinked_calls_.Insert(
             &UnlinkedCall::ZoneHandle(zone_, unlinked.raw()));
         return unlinked.raw();
@@ -2058,13 +2206,30 @@ void Precompiler::SwitchICCalls() {
     }
 
    private:
+    void SetDispatchTableOffset(const UnlinkedCall& unlinked) {
+      if (!FLAG_use_dispatch_table) {
+        return;
+      }
+      target_name_ = unlinked.target_name();
+      args_descriptor_ = unlinked.args_descriptor();
+      ArgumentsDescriptor args_desc(args_descriptor_);
+      const intptr_t offset =
+          dispatch_table_.CallSiteOffset(target_name_, args_desc);
+      if (offset != SelectorRow::kUnassignedOffset) {
+        offset_ = Smi::New(offset);
+        unlinked.set_dispatch_table_offset(offset_);
+      }
+    }
+
     Zone* zone_;
+    const DispatchTableGenerator& dispatch_table_;
     Object& entry_;
     ICData& ic_;
     String& target_name_;
     Array& args_descriptor_;
     UnlinkedCall& unlinked_;
     Code& target_code_;
+    Smi& offset_;
     UnlinkedCallSet canonical_unlinked_calls_;
   };
 
@@ -2090,7 +2255,7 @@ void Precompiler::SwitchICCalls() {
     ObjectPool& pool_;
   };
 
-  ICCallSwitcher switcher(Z);
+  ICCallSwitcher switcher(Z, dispatch_table);
   auto& gop = ObjectPool::Handle(I->object_store()->global_object_pool());
   ASSERT(gop.IsNull() != FLAG_use_bare_instructions);
   if (FLAG_use_bare_instructions) {
@@ -2299,6 +2464,9 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
       ZoneGrowableArray<const ICData*>* ic_data_array = nullptr;
 
       CompilerState compiler_state(thread());
+      if (precompiler_ != NULL) {
+        compiler_state.set_effect_summaries(precompiler_->effect_summaries());
+      }
 
       {
         ic_data_array = new (zone) ZoneGrowableArray<const ICData*>();
@@ -2347,6 +2515,10 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         pass_state.call_specializer = &call_specializer;
 
         CompilerPass::RunPipeline(CompilerPass::kAOT, &pass_state);
+
+        if (precompiler_ != NULL) {
+          precompiler_->RecordEffectSummary(function, flow_graph);
+        }
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
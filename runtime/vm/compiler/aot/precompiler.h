@@ -16,6 +16,8 @@ namespace dart {
 
 // Forward declarations.
 class Class;
+class DispatchTableGenerator;
+class EffectSummaryTable;
 class Error;
 class Field;
 class Function;
@@ -231,6 +233,72 @@ class InstanceKeyValueTrait {
 
 typedef DirectChainedHashMap<InstanceKeyValueTrait> InstanceSet;
 
+// Maps a function to the index of its entry in the type feedback recorded by
+// a training run (see TypeFeedbackLoader).
+class FunctionFeedbackKeyValueTrait {
+ public:
+  typedef const Function* Key;
+  typedef intptr_t Value;
+
+  struct Pair {
+    Key key;
+    Value value;
+    Pair() : key(NULL), value(-1) {}
+    Pair(const Key key, const Value& value) : key(key), value(value) {}
+    Pair(const Pair& other) : key(other.key), value(other.value) {}
+  };
+
+  static Key KeyOf(Pair kv) { return kv.key; }
+
+  static Value ValueOf(Pair kv) { return kv.value; }
+
+  static inline intptr_t Hashcode(Key key) {
+    return FunctionKeyValueTrait::Hashcode(key);
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return pair.key->raw() == key->raw();
+  }
+};
+
+typedef DirectChainedHashMap<FunctionFeedbackKeyValueTrait>
+    FunctionFeedbackMap;
+
+// Maps an instance call site, identified by the index of the feedback entry
+// of its function and its deopt id, to its recorded receivers.
+class CallSiteFeedbackKeyValueTrait {
+ public:
+  struct Key {
+    intptr_t function_index;
+    intptr_t deopt_id;
+  };
+  typedef const Array* Value;
+
+  struct Pair {
+    Key key;
+    Value value;
+    Pair() : key({-1, -1}), value(NULL) {}
+    Pair(const Key key, const Value& value) : key(key), value(value) {}
+    Pair(const Pair& other) : key(other.key), value(other.value) {}
+  };
+
+  static Key KeyOf(Pair kv) { return kv.key; }
+
+  static Value ValueOf(Pair kv) { return kv.value; }
+
+  static inline intptr_t Hashcode(Key key) {
+    return key.function_index * 31 + key.deopt_id;
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return (pair.key.function_index == key.function_index) &&
+           (pair.key.deopt_id == key.deopt_id);
+  }
+};
+
+typedef DirectChainedHashMap<CallSiteFeedbackKeyValueTrait>
+    CallSiteFeedbackMap;
+
 class Precompiler : public ValueObject {
  public:
   static RawError* CompileAll();
@@ -254,6 +322,28 @@ class Precompiler : public ValueObject {
 
   static Precompiler* Instance() { return singleton_; }
 
+  // Returns the usage count of [function] in the training run whose type
+  // feedback was loaded before precompilation, or 0.
+  intptr_t FeedbackUsageOf(const Function& function) const;
+
+  // Returns true if [function] ran often enough in the training run to have
+  // been optimized by the JIT.
+  bool IsHotInTrainingRun(const Function& function) const;
+
+  // Returns the recorded receiver classes of the instance call [deopt_id] in
+  // [function] (see TypeFeedbackLoader), or null.
+  RawArray* CallSiteFeedbackOf(const Function& function,
+                               intptr_t deopt_id) const;
+
+  // Records the memory effects of the optimized [flow_graph] of [function].
+  void RecordEffectSummary(const Function& function, FlowGraph* flow_graph);
+
+  // Summaries of the functions compiled so far, or NULL outside of
+  // CompileAll.
+  const EffectSummaryTable* effect_summaries() const {
+    return effect_summaries_;
+  }
+
  private:
   static Precompiler* singleton_;
 
@@ -261,6 +351,7 @@ class Precompiler : public ValueObject {
   ~Precompiler();
 
   void DoCompileAll();
+  void LoadTypeFeedback();
   void AddRoots();
   void AddAnnotatedRoots();
   void Iterate();
@@ -298,8 +389,9 @@ class Precompiler : public ValueObject {
   void DropClasses();
   void DropLibraries();
 
+  void ComputeDispatchTable(DispatchTableGenerator* generator);
   void BindStaticCalls();
-  void SwitchICCalls();
+  void SwitchICCalls(const DispatchTableGenerator& dispatch_table);
 
   void Obfuscate();
 
@@ -341,6 +433,10 @@ class Precompiler : public ValueObject {
   TypeArgumentsSet typeargs_to_retain_;
   AbstractTypeSet types_to_retain_;
   InstanceSet consts_to_retain_;
+  FunctionFeedbackMap feedback_by_function_;
+  CallSiteFeedbackMap call_site_feedback_;
+  GrowableObjectArray& type_feedback_;
+  EffectSummaryTable* effect_summaries_;
   Error& error_;
 
   bool get_runtime_type_is_unique_;
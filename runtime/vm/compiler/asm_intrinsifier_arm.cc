@@ -2200,6 +2200,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ ldr(R0, FieldAddress(R1, target::RegExp::function_offset(kOneByteStringCid,
                                                               sticky)));
 
+  // Regexps matched by the linear engine have no specialized functions.
+  __ CompareClassId(R0, kFunctionCid, R1);
+  __ b(normal_ir_body, NE);
+
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R9.
   __ eor(R9, R9, Operand(R9));
@@ -2207,6 +2211,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ ldr(CODE_REG, FieldAddress(R0, target::Function::code_offset()));
   __ Branch(FieldAddress(R0, target::Function::entry_point_offset()));
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+0).
@@ -2167,7 +2167,7 @@ void AsmIntrinsifier::OneByteString_allocate(Assembler* assembler,
 static void StringEquality(Assembler* assembler,
                            Label* normal_ir_body,
                            intptr_t string_cid) {
-  Label is_true, is_false, loop;
+  Label is_true, is_false, word_loop, byte_loop;
   __ ldr(R0, Address(SP, 1 * target::kWordSize));  // This.
   __ ldr(R1, Address(SP, 0 * target::kWordSize));  // Other.
 
@@ -2186,8 +2186,8 @@ static void StringEquality(Assembler* assembler,
   __ cmp(R2, Operand(R3));
   __ b(&is_false, NE);
 
-  // Check contents, no fall-through possible.
-  // TODO(zra): try out other sequences.
+  // Check contents, no fall-through possible. Compare eight bytes at a time
+  // and then the remaining bytes one at a time.
   ASSERT((string_cid == kOneByteStringCid) ||
          (string_cid == kTwoByteStringCid));
   const intptr_t offset = (string_cid == kOneByteStringCid)
@@ -2196,26 +2196,32 @@ static void StringEquality(Assembler* assembler,
   __ AddImmediate(R0, offset - kHeapObjectTag);
   __ AddImmediate(R1, offset - kHeapObjectTag);
   __ SmiUntag(R2);
-  __ Bind(&loop);
+  if (string_cid == kTwoByteStringCid) {
+    __ add(R2, R2, Operand(R2));  // Length in bytes.
+  }
+  __ Bind(&word_loop);
+  __ CompareImmediate(R2, target::kWordSize);
+  __ b(&byte_loop, LT);
+  __ ldr(R3, Address(R0));
+  __ ldr(R4, Address(R1));
+  __ AddImmediate(R0, target::kWordSize);
+  __ AddImmediate(R1, target::kWordSize);
+  __ AddImmediate(R2, -target::kWordSize);
+  __ cmp(R3, Operand(R4));
+  __ b(&is_false, NE);
+  __ b(&word_loop);
+
+  __ Bind(&byte_loop);
   __ AddImmediate(R2, -1);
   __ CompareRegisters(R2, ZR);
   __ b(&is_true, LT);
-  if (string_cid == kOneByteStringCid) {
-    __ ldr(R3, Address(R0), kUnsignedByte);
-    __ ldr(R4, Address(R1), kUnsignedByte);
-    __ AddImmediate(R0, 1);
-    __ AddImmediate(R1, 1);
-  } else if (string_cid == kTwoByteStringCid) {
-    __ ldr(R3, Address(R0), kUnsignedHalfword);
-    __ ldr(R4, Address(R1), kUnsignedHalfword);
-    __ AddImmediate(R0, 2);
-    __ AddImmediate(R1, 2);
-  } else {
-    UNIMPLEMENTED();
-  }
+  __ ldr(R3, Address(R0), kUnsignedByte);
+  __ ldr(R4, Address(R1), kUnsignedByte);
+  __ AddImmediate(R0, 1);
+  __ AddImmediate(R1, 1);
   __ cmp(R3, Operand(R4));
   __ b(&is_false, NE);
-  __ b(&loop);
+  __ b(&byte_loop);
 
   __ Bind(&is_true);
   __ LoadObject(R0, CastHandle<Object>(TrueObject()));
@@ -2262,6 +2268,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ ldr(R0, FieldAddress(R1, target::RegExp::function_offset(kOneByteStringCid,
                                                               sticky)));
 
+  // Regexps matched by the linear engine have no specialized functions.
+  __ CompareClassId(R0, kFunctionCid);
+  __ b(normal_ir_body, NE);
+
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R5.
   __ eor(R5, R5, Operand(R5));
@@ -2270,6 +2280,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ ldr(CODE_REG, FieldAddress(R0, target::Function::code_offset()));
   __ ldr(R1, FieldAddress(R0, target::Function::entry_point_offset()));
   __ br(R1);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+0).
@@ -2198,6 +2198,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
                    EBX, EDI, TIMES_4,
                    target::RegExp::function_offset(kOneByteStringCid, sticky)));
 
+  // Regexps matched by the linear engine have no specialized functions.
+  __ CompareClassId(EAX, kFunctionCid, EDI);
+  __ j(NOT_EQUAL, normal_ir_body);
+
   // Registers are now set up for the lazy compile stub. It expects the function
   // in EAX, the argument descriptor in EDX, and IC-Data in ECX.
   __ xorl(ECX, ECX);
@@ -2205,6 +2209,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ movl(EDI, FieldAddress(EAX, target::Function::entry_point_offset()));
   __ jmp(EDI);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+1), return-address (+0).
@@ -2138,7 +2138,7 @@ void AsmIntrinsifier::OneByteString_allocate(Assembler* assembler,
 static void StringEquality(Assembler* assembler,
                            Label* normal_ir_body,
                            intptr_t string_cid) {
-  Label is_true, is_false, loop;
+  Label is_true, is_false, word_loop, byte_loop;
   __ movq(RAX, Address(RSP, +2 * target::kWordSize));  // This.
   __ movq(RCX, Address(RSP, +1 * target::kWordSize));  // Other.
 
@@ -2157,29 +2157,35 @@ static void StringEquality(Assembler* assembler,
   __ cmpq(RDI, FieldAddress(RCX, target::String::length_offset()));
   __ j(NOT_EQUAL, &is_false, Assembler::kNearJump);
 
-  // Check contents, no fall-through possible.
-  // TODO(srdjan): write a faster check.
+  // Check contents, no fall-through possible. Compare eight bytes at a time
+  // starting from the end and then the remaining bytes one at a time.
+  ASSERT((string_cid == kOneByteStringCid) ||
+         (string_cid == kTwoByteStringCid));
+  const intptr_t offset = (string_cid == kOneByteStringCid)
+                              ? target::OneByteString::data_offset()
+                              : target::TwoByteString::data_offset();
   __ SmiUntag(RDI);
-  __ Bind(&loop);
+  if (string_cid == kTwoByteStringCid) {
+    __ addq(RDI, RDI);  // Length in bytes.
+  }
+  __ Bind(&word_loop);
+  __ cmpq(RDI, Immediate(target::kWordSize));
+  __ j(LESS, &byte_loop, Assembler::kNearJump);
+  __ subq(RDI, Immediate(target::kWordSize));
+  __ movq(RBX, FieldAddress(RAX, RDI, TIMES_1, offset));
+  __ cmpq(RBX, FieldAddress(RCX, RDI, TIMES_1, offset));
+  __ j(NOT_EQUAL, &is_false);
+  __ jmp(&word_loop, Assembler::kNearJump);
+
+  __ Bind(&byte_loop);
   __ decq(RDI);
   __ cmpq(RDI, Immediate(0));
   __ j(LESS, &is_true, Assembler::kNearJump);
-  if (string_cid == kOneByteStringCid) {
-    __ movzxb(RBX, FieldAddress(RAX, RDI, TIMES_1,
-                                target::OneByteString::data_offset()));
-    __ movzxb(RDX, FieldAddress(RCX, RDI, TIMES_1,
-                                target::OneByteString::data_offset()));
-  } else if (string_cid == kTwoByteStringCid) {
-    __ movzxw(RBX, FieldAddress(RAX, RDI, TIMES_2,
-                                target::TwoByteString::data_offset()));
-    __ movzxw(RDX, FieldAddress(RCX, RDI, TIMES_2,
-                                target::TwoByteString::data_offset()));
-  } else {
-    UNIMPLEMENTED();
-  }
+  __ movzxb(RBX, FieldAddress(RAX, RDI, TIMES_1, offset));
+  __ movzxb(RDX, FieldAddress(RCX, RDI, TIMES_1, offset));
   __ cmpq(RBX, RDX);
-  __ j(NOT_EQUAL, &is_false, Assembler::kNearJump);
-  __ jmp(&loop, Assembler::kNearJump);
+  __ j(NOT_EQUAL, &is_false);
+  __ jmp(&byte_loop, Assembler::kNearJump);
 
   __ Bind(&is_true);
   __ LoadObject(RAX, CastHandle<Object>(TrueObject()));
@@ -2226,6 +2232,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
                    RBX, RDI, TIMES_8,
                    target::RegExp::function_offset(kOneByteStringCid, sticky)));
 
+  // Regexps matched by the linear engine have no specialized functions.
+  __ CompareClassId(RAX, kFunctionCid);
+  __ j(NOT_EQUAL, normal_ir_body);
+
   // Registers are now set up for the lazy compile stub. It expects the function
   // in RAX, the argument descriptor in R10, and IC-Data in RCX.
   __ xorq(RCX, RCX);
@@ -2234,6 +2244,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movq(CODE_REG, FieldAddress(RAX, target::Function::code_offset()));
   __ movq(RDI, FieldAddress(RAX, target::Function::entry_point_offset()));
   __ jmp(RDI);
+
+  __ Bind(normal_ir_body);
 }
 
 // On stack: user tag (+1), return-address (+0).
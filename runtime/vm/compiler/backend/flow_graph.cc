@@ -52,6 +52,7 @@ FlowGraph::FlowGraph(const ParsedFunction& parsed_function,
       constant_null_(nullptr),
       constant_dead_(nullptr),
       licm_allowed_(true),
+      mid_tier_(false),
       prologue_info_(prologue_info),
       loop_hierarchy_(nullptr),
       loop_invariant_loads_(nullptr),
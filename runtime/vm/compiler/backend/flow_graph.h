@@ -293,6 +293,11 @@ class FlowGraph : public ZoneAllocated {
   // after this point.
   void disallow_licm() { licm_allowed_ = false; }
 
+  // Whether the graph is compiled by the cheaper mid-tier pipeline, whose
+  // code tiers up to the full optimizing pipeline once it gets hot.
+  bool is_mid_tier() const { return mid_tier_; }
+  void set_is_mid_tier() { mid_tier_ = true; }
+
   PrologueInfo prologue_info() const { return prologue_info_; }
 
   // Computes the loop hierarchy of the flow graph on demand.
@@ -519,6 +524,7 @@ class FlowGraph : public ZoneAllocated {
   ConstantInstr* constant_dead_;
 
   bool licm_allowed_;
+  bool mid_tier_;
 
   const PrologueInfo prologue_info_;
 
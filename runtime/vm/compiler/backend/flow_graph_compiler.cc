@@ -179,6 +179,11 @@ bool FlowGraphCompiler::IsUnboxedField(const Field& field) {
 }
 
 bool FlowGraphCompiler::IsPotentialUnboxedField(const Field& field) {
+  if (FLAG_precompiled_mode) {
+    // Guarded state of the field is inferred by TFA and never changes, so
+    // the representation of the field is known at compile time.
+    return IsUnboxedField(field);
+  }
   return field.is_unboxing_candidate() &&
          (FlowGraphCompiler::IsUnboxedField(field) ||
           (!field.is_final() && (field.guarded_cid() == kIllegalCid)));
@@ -241,6 +246,16 @@ bool FlowGraphCompiler::CanOSRFunction() const {
   return isolate()->use_osr() && CanOptimizeFunction() && !is_optimizing();
 }
 
+bool FlowGraphCompiler::is_mid_tier() const {
+  return flow_graph().is_mid_tier();
+}
+
+bool FlowGraphCompiler::CountsLoopIterations() const {
+  // Huge functions are never compiled by the full pipeline.
+  return isolate()->use_osr() && CanOptimizeFunction() && is_mid_tier() &&
+         parsed_function().function().IsOptimizable();
+}
+
 bool FlowGraphCompiler::ForceSlowPathForStackOverflow() const {
 #if !defined(PRODUCT)
   if ((FLAG_stacktrace_every > 0) || (FLAG_deoptimize_every > 0) ||
@@ -1170,8 +1185,7 @@ bool FlowGraphCompiler::TryIntrinsify() {
 
         // Only intrinsify getter if the field cannot contain a mutable double.
         // Reading from a mutable double box requires allocating a fresh double.
-        if (field.is_instance() &&
-            (FLAG_precompiled_mode || !IsPotentialUnboxedField(field))) {
+        if (field.is_instance() && !IsPotentialUnboxedField(field)) {
           SpecialStatsBegin(CombinedCodeStatistics::kTagIntrinsics);
           GenerateGetterIntrinsic(field.Offset());
           SpecialStatsEnd(CombinedCodeStatistics::kTagIntrinsics);
@@ -1184,8 +1198,11 @@ bool FlowGraphCompiler::TryIntrinsify() {
           const Field& field = Field::Handle(function().accessor_field());
           ASSERT(!field.IsNull());
 
+          // Storing a double into a field holding a mutable box requires
+          // updating the box in place.
           if (field.is_instance() &&
-              (FLAG_precompiled_mode || field.guarded_cid() == kDynamicCid)) {
+              (FLAG_precompiled_mode ? !IsUnboxedField(field)
+                                     : field.guarded_cid() == kDynamicCid)) {
             SpecialStatsBegin(CombinedCodeStatistics::kTagIntrinsics);
             GenerateSetterIntrinsic(field.Offset());
             SpecialStatsEnd(CombinedCodeStatistics::kTagIntrinsics);
@@ -1802,11 +1819,27 @@ const ICData* FlowGraphCompiler::GetOrAddStaticCallICData(
   return &ic_data;
 }
 
+bool FlowGraphCompiler::HasInvocationCountCheck() const {
+  if (!CanOptimizeFunction()) {
+    return false;
+  }
+  const Function& function = parsed_function().function();
+  if (!is_optimizing()) {
+    return function.IsOptimizable() || function.IsMidTierOptimizable();
+  }
+  // Huge functions are only ever compiled by the mid tier.
+  return function.IsOptimizable() && (may_reoptimize() || is_mid_tier());
+}
+
 intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
+  const Function& function = parsed_function_.function();
   intptr_t threshold;
-  if (is_optimizing()) {
+  if (is_mid_tier()) {
+    // Counting restarts when the mid-tier code is installed.
+    threshold = FLAG_optimization_counter_threshold;
+  } else if (is_optimizing()) {
     threshold = FLAG_reoptimization_counter_threshold;
-  } else if (parsed_function_.function().IsIrregexpFunction()) {
+  } else if (function.IsIrregexpFunction()) {
     threshold = FLAG_regexp_optimization_counter_threshold;
   } else {
     const intptr_t basic_blocks = flow_graph().preorder().length();
@@ -1816,6 +1849,13 @@ intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
     if (threshold > FLAG_optimization_counter_threshold) {
       threshold = FLAG_optimization_counter_threshold;
     }
+    // Warm functions are handed to the cheaper mid tier first, and huge ones
+    // are never compiled by the full pipeline.
+    if (function.IsMidTierOptimizable() &&
+        ((threshold > FLAG_mid_tier_counter_threshold) ||
+         !function.IsOptimizable())) {
+      threshold = FLAG_mid_tier_counter_threshold;
+    }
   }
   return threshold;
 }
@@ -378,6 +378,10 @@ class FlowGraphCompiler : public ValueObject {
   bool CanOptimizeFunction() const;
   bool CanOSRFunction() const;
   bool is_optimizing() const { return is_optimizing_; }
+  bool is_mid_tier() const;
+  // Whether loops of mid-tier code count their iterations to tier up to the
+  // full pipeline (see CheckStackOverflowInstr).
+  bool CountsLoopIterations() const;
 
   void EnterIntrinsicMode();
   void ExitIntrinsicMode();
@@ -946,6 +950,10 @@ class FlowGraphCompiler : public ValueObject {
 
   void EmitSourceLine(Instruction* instr);
 
+  // Whether the function entry compares the usage counter against the
+  // optimization threshold and calls the optimizing compiler once it is
+  // reached.
+  bool HasInvocationCountCheck() const;
   intptr_t GetOptimizationThreshold() const;
 
   StackMapTableBuilder* stackmap_table_builder() {
@@ -860,8 +860,7 @@ static const Register new_pp = NOTFP;
 
 void FlowGraphCompiler::EmitFrameEntry() {
   const Function& function = parsed_function().function();
-  if (CanOptimizeFunction() && function.IsOptimizable() &&
-      (!is_optimizing() || may_reoptimize())) {
+  if (HasInvocationCountCheck()) {
     __ Comment("Invocation Count Check");
     const Register function_reg = R8;
     if (!FLAG_precompiled_mode || !FLAG_use_bare_instructions) {
@@ -874,8 +873,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
     __ ldr(R3, FieldAddress(function_reg, Function::usage_counter_offset()));
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function. Mid-tier code counts
+    // invocations to tier up to the full optimizing pipeline.
+    if (!is_optimizing() || is_mid_tier()) {
       __ add(R3, R3, Operand(1));
       __ str(R3, FieldAddress(function_reg, Function::usage_counter_offset()));
     }
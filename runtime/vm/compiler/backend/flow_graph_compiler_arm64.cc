@@ -838,8 +838,7 @@ void FlowGraphCompiler::GenerateSetterIntrinsic(intptr_t offset) {
 void FlowGraphCompiler::EmitFrameEntry() {
   const Function& function = parsed_function().function();
   Register new_pp = kNoRegister;
-  if (CanOptimizeFunction() && function.IsOptimizable() &&
-      (!is_optimizing() || may_reoptimize())) {
+  if (HasInvocationCountCheck()) {
     __ Comment("Invocation Count Check");
     const Register function_reg = R6;
     new_pp = R13;
@@ -855,8 +854,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
     __ LoadFieldFromOffset(R7, function_reg, Function::usage_counter_offset(),
                            kWord);
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function. Mid-tier code counts
+    // invocations to tier up to the full optimizing pipeline.
+    if (!is_optimizing() || is_mid_tier()) {
       __ add(R7, R7, Operand(1));
       __ StoreFieldToOffset(R7, function_reg, Function::usage_counter_offset(),
                             kWord);
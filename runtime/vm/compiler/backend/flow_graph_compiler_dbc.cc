@@ -313,9 +313,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
   const intptr_t num_fixed_params = function.num_fixed_parameters();
   const int num_locals = parsed_function().num_stack_locals();
 
-  if (CanOptimizeFunction() && function.IsOptimizable() &&
-      (!is_optimizing() || may_reoptimize())) {
-    __ HotCheck(!is_optimizing(), GetOptimizationThreshold());
+  if (HasInvocationCountCheck()) {
+    __ HotCheck(!is_optimizing() || is_mid_tier(), GetOptimizationThreshold());
   }
 
   if (is_optimizing()) {
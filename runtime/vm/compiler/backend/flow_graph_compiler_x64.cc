@@ -864,16 +864,16 @@ void FlowGraphCompiler::EmitFrameEntry() {
     }
 
     const Function& function = parsed_function().function();
-    if (CanOptimizeFunction() && function.IsOptimizable() &&
-        (!is_optimizing() || may_reoptimize())) {
+    if (HasInvocationCountCheck()) {
       __ Comment("Invocation Count Check");
       const Register function_reg = RDI;
       // Load function object using the callee's pool pointer.
       __ LoadFunctionFromCalleePool(function_reg, function, new_pp);
 
       // Reoptimization of an optimized function is triggered by counting in
-      // IC stubs, but not at the entry of the function.
-      if (!is_optimizing()) {
+      // IC stubs, but not at the entry of the function. Mid-tier code counts
+      // invocations to tier up to the full optimizing pipeline.
+      if (!is_optimizing() || is_mid_tier()) {
         __ incl(FieldAddress(function_reg, Function::usage_counter_offset()));
       }
       __ cmpl(FieldAddress(function_reg, Function::usage_counter_offset()),
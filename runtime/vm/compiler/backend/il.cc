@@ -386,15 +386,9 @@ bool HierarchyInfo::CanUseGenericSubtypeRangeCheckFor(
          type.arguments() != TypeArguments::null());
 
   // If the type class is implemented the different implementations might have
-  // their type argument vector stored at different offsets and we can therefore
-  // not perform our optimized [CidRange]-based implementation.
-  //
-  // TODO(kustermann): If the class is implemented but all implementations
-  // store the instantator type argument vector at the same offset we can
-  // still do it!
-  if (type_class.is_implemented()) {
-    return false;
-  }
+  // their type argument vector stored at different offsets.  The type testing
+  // stub will then dispatch on the class id of the instance to find them (see
+  // [TypeTestingStubGenerator]).
 
   const TypeArguments& ta =
       TypeArguments::Handle(zone, Type::Cast(type).arguments());
@@ -402,11 +396,14 @@ bool HierarchyInfo::CanUseGenericSubtypeRangeCheckFor(
 
   // The last [num_type_pararameters] entries in the [TypeArguments] vector [ta]
   // are the values we have to check against.  Ensure we can handle all of them
-  // via [CidRange]-based checks or that it is a type parameter.
+  // via [CidRange]-based checks, that it is a type parameter or that it is an
+  // instantiated type (e.g. `Map<String, dynamic>` or `int Function(int)`)
+  // which the instance's type argument can be compared against for identity.
   AbstractType& type_arg = AbstractType::Handle(zone);
   for (intptr_t i = 0; i < num_type_parameters; ++i) {
     type_arg = ta.TypeAt(num_type_arguments - num_type_parameters + i);
-    if (!CanUseSubtypeRangeCheckFor(type_arg) && !type_arg.IsTypeParameter()) {
+    if (!CanUseSubtypeRangeCheckFor(type_arg) && !type_arg.IsTypeParameter() &&
+        !(type_arg.IsType() && type_arg.IsInstantiated())) {
       return false;
     }
   }
@@ -228,8 +228,9 @@ class HierarchyInfo : public ThreadStackResource {
   // determine if a given instance's type is a subtype of [type].
   //
   // This is the case for [type]s with type arguments where we are able to do a
-  // [CidRange]-based subclass-check against the class and [CidRange]-based
-  // subtype-checks against the type arguments.
+  // [CidRange]-based subclass-check (or, for implemented classes, a subtype
+  // check) against the class and [CidRange]-based subtype-checks or identity
+  // checks against the type arguments.
   //
   // This method should only be called if [CanUseSubtypeRangecheckFor] returned
   // false.
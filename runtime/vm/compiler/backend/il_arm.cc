@@ -2208,6 +2208,9 @@ LocationSummary* StoreInstanceFieldInstr::MakeLocationSummary(Zone* zone,
   return summary;
 }
 
+// Unboxed fields own their box: compiled code allocates it on the first
+// store and the runtime copies values it stores (see Field::CloneForUnboxed),
+// so the box can be updated in place.
 static void EnsureMutableBox(FlowGraphCompiler* compiler,
                              StoreInstanceFieldInstr* instruction,
                              Register box_reg,
@@ -3100,7 +3103,8 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   CheckStackOverflowSlowPath* slow_path = new CheckStackOverflowSlowPath(this);
   compiler->AddSlowPathCode(slow_path);
   __ b(slow_path->entry_label(), LS);
-  if (compiler->CanOSRFunction() && in_loop()) {
+  if ((compiler->CanOSRFunction() || compiler->CountsLoopIterations()) &&
+      in_loop()) {
     const Register temp = locs()->temp(0).reg();
     // In unoptimized code check the usage counter to trigger OSR at loop
     // stack checks.  Use progressively higher thresholds for more deeply
@@ -3108,7 +3112,15 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     __ LoadObject(temp, compiler->parsed_function().function());
     intptr_t threshold =
         FLAG_optimization_counter_threshold * (loop_depth() + 1);
-    __ ldr(temp, FieldAddress(temp, Function::usage_counter_offset()));
+    if (compiler->CountsLoopIterations()) {
+      // Mid-tier code makes no IC calls that would count uses.
+      __ ldr(IP, FieldAddress(temp, Function::usage_counter_offset()));
+      __ add(IP, IP, Operand(1));
+      __ str(IP, FieldAddress(temp, Function::usage_counter_offset()));
+      __ mov(temp, Operand(IP));
+    } else {
+      __ ldr(temp, FieldAddress(temp, Function::usage_counter_offset()));
+    }
     __ CompareImmediate(temp, threshold);
     __ b(slow_path->osr_entry_label(), GE);
   }
@@ -1869,6 +1869,9 @@ class BoxAllocationSlowPath : public TemplateSlowPathCode<Instruction> {
   const Register result_;
 };
 
+// Unboxed fields own their box: compiled code allocates it on the first
+// store and the runtime copies values it stores (see Field::CloneForUnboxed),
+// so the box can be updated in place.
 static void EnsureMutableBox(FlowGraphCompiler* compiler,
                              StoreInstanceFieldInstr* instruction,
                              Register box_reg,
@@ -2782,7 +2785,8 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   // Assembler::EnterFrame.
   __ CompareRegisters(CSP, TMP);
   __ b(slow_path->entry_label(), LS);
-  if (compiler->CanOSRFunction() && in_loop()) {
+  if ((compiler->CanOSRFunction() || compiler->CountsLoopIterations()) &&
+      in_loop()) {
     const Register temp = locs()->temp(0).reg();
     // In unoptimized code check the usage counter to trigger OSR at loop
     // stack checks.  Use progressively higher thresholds for more deeply
@@ -2790,7 +2794,18 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     __ LoadObject(temp, compiler->parsed_function().function());
     intptr_t threshold =
         FLAG_optimization_counter_threshold * (loop_depth() + 1);
-    __ LoadFieldFromOffset(temp, temp, Function::usage_counter_offset(), kWord);
+    if (compiler->CountsLoopIterations()) {
+      // Mid-tier code makes no IC calls that would count uses.
+      __ LoadFieldFromOffset(TMP, temp, Function::usage_counter_offset(),
+                             kWord);
+      __ add(TMP, TMP, Operand(1));
+      __ StoreFieldToOffset(TMP, temp, Function::usage_counter_offset(),
+                            kWord);
+      __ mov(temp, TMP);
+    } else {
+      __ LoadFieldFromOffset(temp, temp, Function::usage_counter_offset(),
+                             kWord);
+    }
     __ CompareImmediate(temp, threshold);
     __ b(slow_path->osr_entry_label(), GE);
   }
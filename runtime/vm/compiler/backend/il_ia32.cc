@@ -1792,6 +1792,9 @@ LocationSummary* StoreInstanceFieldInstr::MakeLocationSummary(Zone* zone,
   return summary;
 }
 
+// Unboxed fields own their box: compiled code allocates it on the first
+// store and the runtime copies values it stores (see Field::CloneForUnboxed),
+// so the box can be updated in place.
 static void EnsureMutableBox(FlowGraphCompiler* compiler,
                              StoreInstanceFieldInstr* instruction,
                              Register box_reg,
@@ -2568,12 +2571,10 @@ void CatchBlockEntryInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 LocationSummary* CheckStackOverflowInstr::MakeLocationSummary(Zone* zone,
                                                               bool opt) const {
   const intptr_t kNumInputs = 0;
-  const intptr_t kNumTemps = opt ? 0 : 1;
+  const intptr_t kNumTemps = 1;
   LocationSummary* summary = new (zone) LocationSummary(
       zone, kNumInputs, kNumTemps, LocationSummary::kCallOnSlowPath);
-  if (!opt) {
-    summary->set_temp(0, Location::RequiresRegister());
-  }
+  summary->set_temp(0, Location::RequiresRegister());
   return summary;
 }
 
@@ -2630,14 +2631,20 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   __ cmpl(ESP, Address(THR, Thread::stack_limit_offset()));
   __ j(BELOW_EQUAL, slow_path->entry_label());
-  if (compiler->CanOSRFunction() && in_loop()) {
+  if ((compiler->CanOSRFunction() || compiler->CountsLoopIterations()) &&
+      in_loop()) {
+    const Register temp = locs()->temp(0).reg();
     // In unoptimized code check the usage counter to trigger OSR at loop
     // stack checks.  Use progressively higher thresholds for more deeply
     // nested loops to attempt to hit outer loops with OSR when possible.
-    __ LoadObject(EDI, compiler->parsed_function().function());
+    __ LoadObject(temp, compiler->parsed_function().function());
+    if (compiler->CountsLoopIterations()) {
+      // Mid-tier code makes no IC calls that would count uses.
+      __ incl(FieldAddress(temp, Function::usage_counter_offset()));
+    }
     intptr_t threshold =
         FLAG_optimization_counter_threshold * (loop_depth() + 1);
-    __ cmpl(FieldAddress(EDI, Function::usage_counter_offset()),
+    __ cmpl(FieldAddress(temp, Function::usage_counter_offset()),
             Immediate(threshold));
     __ j(GREATER_EQUAL, slow_path->osr_entry_label());
   }
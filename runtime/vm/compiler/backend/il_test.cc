@@ -3,10 +3,17 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/slot.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/parser.h"
+#include "vm/symbols.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, unbox_numeric_fields);
+
 ISOLATE_UNIT_TEST_CASE(InstructionTests) {
   TargetEntryInstr* target_instr =
       new TargetEntryInstr(1, kInvalidTryIndex, DeoptId::kNone);
@@ -40,4 +47,68 @@ ISOLATE_UNIT_TEST_CASE(OptimizationTests) {
   EXPECT(!c3->Equals(c1));
 }
 
+// In AOT the representation of a field is decided at compile time from the
+// guarded state inferred by TFA: stores into a non-nullable double field are
+// unboxed, and there is no runtime-dispatched "potential unboxed" path for
+// fields that are not.
+ISOLATE_UNIT_TEST_CASE(StoreInstanceField_UnboxedInPrecompiledMode) {
+  if (!FLAG_unbox_numeric_fields ||
+      !FlowGraphCompiler::SupportsUnboxedDoubles()) {
+    return;
+  }
+  SetFlagScope<bool> sfs(&FLAG_precompiled_mode, true);
+
+  const Class& dummy_class = Class::Handle(Class::New(
+      Library::Handle(), String::Handle(Symbols::New(thread, "DummyClass")),
+      Script::Handle(), TokenPosition::kNoSource));
+  dummy_class.set_is_synthesized_class();
+  const Function& dummy_function = Function::ZoneHandle(
+      Function::New(String::Handle(Symbols::New(thread, "foo")),
+                    RawFunction::kRegularFunction, false, false, false, false,
+                    false, dummy_class, TokenPosition::kMinSource));
+
+  const Field& unboxed = Field::Handle(
+      Field::New(String::Handle(Symbols::New(thread, "unboxed")),
+                 /*is_static=*/false, /*is_final=*/false, /*is_const=*/false,
+                 /*is_reflectable=*/true, dummy_class, Object::dynamic_type(),
+                 TokenPosition::kMinSource, TokenPosition::kMinSource));
+  unboxed.set_is_unboxing_candidate(true);
+  unboxed.set_guarded_cid(kDoubleCid);
+  unboxed.set_is_nullable(false);
+
+  const Field& nullable = Field::Handle(
+      Field::New(String::Handle(Symbols::New(thread, "nullable")),
+                 /*is_static=*/false, /*is_final=*/false, /*is_const=*/false,
+                 /*is_reflectable=*/true, dummy_class, Object::dynamic_type(),
+                 TokenPosition::kMinSource, TokenPosition::kMinSource));
+  nullable.set_is_unboxing_candidate(true);
+  nullable.set_guarded_cid(kDoubleCid);
+  nullable.set_is_nullable(true);
+
+  CompilerState compiler_state(thread);
+  ParsedFunction* parsed_function =
+      new ParsedFunction(thread, dummy_function);
+  ConstantInstr* instance = new ConstantInstr(Object::ZoneHandle());
+  ConstantInstr* value =
+      new ConstantInstr(Double::ZoneHandle(Double::NewCanonical(1.0)));
+
+  StoreInstanceFieldInstr* store = new StoreInstanceFieldInstr(
+      Slot::Get(Field::ZoneHandle(unboxed.CloneFromOriginal()),
+                parsed_function),
+      new Value(instance), new Value(value), kEmitStoreBarrier,
+      TokenPosition::kNoSource);
+  EXPECT(store->IsUnboxedStore());
+  EXPECT(store->IsPotentialUnboxedStore());
+  EXPECT_EQ(kUnboxedDouble, store->RequiredInputRepresentation(1));
+
+  store = new StoreInstanceFieldInstr(
+      Slot::Get(Field::ZoneHandle(nullable.CloneFromOriginal()),
+                parsed_function),
+      new Value(instance), new Value(value), kEmitStoreBarrier,
+      TokenPosition::kNoSource);
+  EXPECT(!store->IsUnboxedStore());
+  EXPECT(!store->IsPotentialUnboxedStore());
+  EXPECT_EQ(kTagged, store->RequiredInputRepresentation(1));
+}
+
 }  // namespace dart
@@ -1924,6 +1924,9 @@ LocationSummary* StoreInstanceFieldInstr::MakeLocationSummary(Zone* zone,
   return summary;
 }
 
+// Unboxed fields own their box: compiled code allocates it on the first
+// store and the runtime copies values it stores (see Field::CloneForUnboxed),
+// so the box can be updated in place.
 static void EnsureMutableBox(FlowGraphCompiler* compiler,
                              StoreInstanceFieldInstr* instruction,
                              Register box_reg,
@@ -2781,11 +2784,16 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   // Generate stack overflow check.
   __ cmpq(RSP, Address(THR, Thread::stack_limit_offset()));
   __ j(BELOW_EQUAL, slow_path->entry_label());
-  if (compiler->CanOSRFunction() && in_loop()) {
+  if ((compiler->CanOSRFunction() || compiler->CountsLoopIterations()) &&
+      in_loop()) {
     // In unoptimized code check the usage counter to trigger OSR at loop
     // stack checks.  Use progressively higher thresholds for more deeply
     // nested loops to attempt to hit outer loops with OSR when possible.
     __ LoadObject(temp, compiler->parsed_function().function());
+    if (compiler->CountsLoopIterations()) {
+      // Mid-tier code makes no IC calls that would count uses.
+      __ incl(FieldAddress(temp, Function::usage_counter_offset()));
+    }
     int32_t threshold =
         FLAG_optimization_counter_threshold * (loop_depth() + 1);
     __ cmpl(FieldAddress(temp, Function::usage_counter_offset()),
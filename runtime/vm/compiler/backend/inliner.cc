@@ -1485,11 +1485,13 @@ class CallSiteInliner : public ValueObject {
       // Under AOT, calls outside loops may pass our regular heuristics due
       // to a relatively high ratio. So, unless we are optimizing solely for
       // speed, such call sites are subject to subsequent stricter heuristic
-      // to limit code size increase.
-      bool stricter_heuristic = FLAG_precompiled_mode &&
-                                FLAG_optimization_level <= 2 &&
-                                !inliner_->AlwaysInline(target) &&
-                                call_info[call_idx].nesting_depth == 0;
+      // to limit code size increase. Callers that were hot in a training run
+      // get the regular inlining budget.
+      bool stricter_heuristic =
+          FLAG_precompiled_mode && FLAG_optimization_level <= 2 &&
+          !inliner_->AlwaysInline(target) &&
+          call_info[call_idx].nesting_depth == 0 &&
+          !inliner_->IsHotInTrainingRun(call_info[call_idx].caller());
       if (TryInlining(call->function(), call->argument_names(), &call_data,
                       stricter_heuristic)) {
         InlineCall(&call_data);
@@ -2290,6 +2292,14 @@ static bool IsInlineableOperator(const Function& function) {
          (function.name() == Symbols::Minus().raw());
 }
 
+bool FlowGraphInliner::IsHotInTrainingRun(const Function& function) const {
+#if defined(DART_PRECOMPILER)
+  return (precompiler_ != NULL) && precompiler_->IsHotInTrainingRun(function);
+#else
+  return false;
+#endif
+}
+
 bool FlowGraphInliner::AlwaysInline(const Function& function) {
   const char* kAlwaysInlineAnnotation = "AlwaysInline";
   if (FLAG_enable_inlining_annotations &&
@@ -102,6 +102,10 @@ class FlowGraphInliner : ValueObject {
 
   bool AlwaysInline(const Function& function);
 
+  // Whether [function] executed in the training run recorded for this AOT
+  // compilation (see --load_type_feedback).
+  bool IsHotInTrainingRun(const Function& function) const;
+
   FlowGraph* flow_graph() const { return flow_graph_; }
   intptr_t NextInlineId(const Function& function,
                         TokenPosition tp,
@@ -974,13 +974,30 @@ void FlowGraphAllocator::ConnectIncomingPhiMoves(JoinEntryInstr* join) {
       MoveOperands* move =
           goto_instr->parallel_move()->MoveOperandsAt(move_idx);
       move->set_dest(Location::PrefersRegister());
-      range->AddUse(pos, move->dest_slot());
+      // Hint the phi with the locations of its inputs so that the phi moves
+      // can be coalesced. Inputs from the loop body are allocated after the
+      // phi and instead get the phi's location as a hint.
+      Definition* input = phi->InputAt(pred_idx)->definition();
+      if (input->IsConstant()) {
+        range->AddUse(pos, move->dest_slot());
+      } else {
+        range->AddHintedUse(
+            pos, move->dest_slot(),
+            GetLiveRange(input->ssa_temp_index())->assigned_location_slot());
+      }
       if (is_pair_phi) {
         LiveRange* second_range = GetLiveRange(ToSecondPairVreg(vreg));
         MoveOperands* second_move =
             goto_instr->parallel_move()->MoveOperandsAt(move_idx + 1);
         second_move->set_dest(Location::PrefersRegister());
-        second_range->AddUse(pos, second_move->dest_slot());
+        if (input->IsConstant()) {
+          second_range->AddUse(pos, second_move->dest_slot());
+        } else {
+          second_range->AddHintedUse(
+              pos, second_move->dest_slot(),
+              GetLiveRange(ToSecondPairVreg(input->ssa_temp_index()))
+                  ->assigned_location_slot());
+        }
       }
     }
 
@@ -1676,7 +1693,9 @@ Location AllocationFinger::FirstHint() {
   UsePosition* use = first_hinted_use_;
 
   while (use != NULL) {
-    if (use->HasHint()) return use->hint();
+    // Skip hints pointing at ranges that are not allocated to a register
+    // (yet), e.g. phi inputs flowing in over a back edge.
+    if (use->HasHint() && use->hint().IsMachineRegister()) return use->hint();
     use = use->next();
   }
 
@@ -1918,6 +1937,26 @@ LiveRange* FlowGraphAllocator::SplitBetween(LiveRange* range,
   return range->SplitAt(split_pos);
 }
 
+intptr_t FlowGraphAllocator::HoistSpillPosition(LiveRange* range,
+                                                intptr_t from,
+                                                intptr_t to) {
+  // Moving the split to a loop header is only possible if there are no
+  // register uses in the loop, and only beneficial if the next register
+  // use is outside of it: otherwise the value is reloaded in the loop.
+  LoopInfo* loop_info = BlockEntryAt(from)->loop_info();
+  while ((loop_info != nullptr) &&
+         (range->Start() <= loop_info->header()->start_pos()) &&
+         (to >= extra_loop_info_[loop_info->id()]->end) &&
+         RangeHasOnlyUnconstrainedUsesInLoop(range, loop_info->id())) {
+    ASSERT(loop_info->header()->start_pos() <= from);
+    from = loop_info->header()->start_pos();
+    TRACE_ALLOC(
+        THR_Print("  moved spill position to loop header %" Pd "\n", from));
+    loop_info = loop_info->outer();
+  }
+  return from;
+}
+
 void FlowGraphAllocator::SpillBetween(LiveRange* range,
                                       intptr_t from,
                                       intptr_t to) {
@@ -1925,6 +1964,7 @@ void FlowGraphAllocator::SpillBetween(LiveRange* range,
   TRACE_ALLOC(THR_Print("spill v%" Pd " [%" Pd ", %" Pd ") "
                         "between [%" Pd ", %" Pd ")\n",
                         range->vreg(), range->Start(), range->End(), from, to));
+  from = HoistSpillPosition(range, from, to);
   LiveRange* tail = range->SplitAt(from);
 
   if (tail->Start() < to) {
@@ -1944,16 +1984,7 @@ void FlowGraphAllocator::SpillAfter(LiveRange* range, intptr_t from) {
 
   // When spilling the value inside the loop check if this spill can
   // be moved outside.
-  LoopInfo* loop_info = BlockEntryAt(from)->loop_info();
-  if (loop_info != nullptr) {
-    if ((range->Start() <= loop_info->header()->start_pos()) &&
-        RangeHasOnlyUnconstrainedUsesInLoop(range, loop_info->id())) {
-      ASSERT(loop_info->header()->start_pos() <= from);
-      from = loop_info->header()->start_pos();
-      TRACE_ALLOC(
-          THR_Print("  moved spill position to loop header %" Pd "\n", from));
-    }
-  }
+  from = HoistSpillPosition(range, from, kMaxPosition);
 
   LiveRange* tail = range->SplitAt(from);
   Spill(tail);
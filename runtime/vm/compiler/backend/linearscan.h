@@ -222,6 +222,13 @@ class FlowGraphAllocator : public ValueObject {
   // Allocate the given live range to a spill slot.
   void Spill(LiveRange* range);
 
+  // Returns the position a spill of the given live range at from can be
+  // hoisted to: the header of the outermost loop around from which the range
+  // is live into and has no register uses in before the to position. This
+  // keeps both the split and the reload before the next register use out of
+  // the loops.
+  intptr_t HoistSpillPosition(LiveRange* range, intptr_t from, intptr_t to);
+
   // Spill the given live range from the given position onwards.
   void SpillAfter(LiveRange* range, intptr_t from);
 
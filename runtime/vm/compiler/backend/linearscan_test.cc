@@ -0,0 +1,136 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests for the linear scan register allocator.
+// Note, try to avoid relying on information that is subject
+// to change (block ids, registers, spill slots, etc.) in order
+// to make this test less sensitive to unrelated changes.
+
+#include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/inliner.h"
+#include "vm/compiler/backend/type_propagator.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(TARGET_ARCH_DBC)
+
+static bool IsStackLocation(Location loc) {
+  return loc.IsStackSlot() || loc.IsDoubleStackSlot() ||
+         loc.IsQuadStackSlot();
+}
+
+static bool HasStackMove(ParallelMoveInstr* parallel_move) {
+  if (parallel_move == nullptr) {
+    return false;
+  }
+  for (intptr_t i = 0; i < parallel_move->NumMoves(); i++) {
+    MoveOperands* move = parallel_move->MoveOperandsAt(i);
+    if (!move->IsRedundant() &&
+        (IsStackLocation(move->src()) || IsStackLocation(move->dest()))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of blocks inside loops which spill to or reload from
+// the stack.
+static intptr_t CountLoopBlocksWithStackMoves(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    if (block->loop_info() == nullptr) {
+      continue;
+    }
+    bool has_stack_move = HasStackMove(block->parallel_move());
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* instr = it.Current();
+      if (instr->IsParallelMove()) {
+        has_stack_move =
+            HasStackMove(instr->AsParallelMove()) || has_stack_move;
+      } else if (instr->IsGoto()) {
+        has_stack_move =
+            HasStackMove(instr->AsGoto()->parallel_move()) || has_stack_move;
+      }
+    }
+    if (has_stack_move) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Builds the flow graph of "foo" after running "main" and allocates its
+// registers.
+static FlowGraph* AllocateRegisters(Thread* thread, const char* script_chars) {
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  Zone* zone = thread->zone();
+  Library& lib =
+      Library::ZoneHandle(Library::RawCast(Api::UnwrapHandle(script)));
+  RawFunction* raw_func =
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, "foo")));
+  ParsedFunction* parsed_function =
+      new (zone) ParsedFunction(thread, Function::ZoneHandle(zone, raw_func));
+
+  CompilerState state(thread);
+  ZoneGrowableArray<const ICData*>* ic_data_array =
+      new (zone) ZoneGrowableArray<const ICData*>();
+  parsed_function->function().RestoreICDataMap(ic_data_array, true);
+  kernel::FlowGraphBuilder builder(parsed_function, ic_data_array, nullptr,
+                                   nullptr, true, DeoptId::kNone);
+  FlowGraph* flow_graph = builder.BuildGraph();
+  EXPECT(flow_graph != nullptr);
+
+  SpeculativeInliningPolicy speculative_policy(/*enable_blacklist*/ false);
+  JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
+  flow_graph->ComputeSSA(0, nullptr);
+  FlowGraphTypePropagator::Propagate(flow_graph);
+  call_specializer.ApplyICData();
+  flow_graph->SelectRepresentations();
+  FlowGraphTypePropagator::Propagate(flow_graph);
+  flow_graph->Canonicalize();
+  flow_graph->RemoveRedefinitions();
+
+  flow_graph->GetLoopHierarchy();
+  FlowGraphAllocator allocator(*flow_graph);
+  allocator.AllocateRegisters();
+  return flow_graph;
+}
+
+// A value which is live through a loop nest with a call in the innermost
+// loop, but only used after the nest, is spilled before the outer loop.
+// Otherwise the back edges reload it on every iteration.
+TEST_CASE(LinearScan_HoistSpillOutOfLoopNest) {
+  const char* script_chars =
+      "int n = 0;\n"
+      "bool next() => (++n % 4) != 0;\n"
+      "foo(a) {\n"
+      "  final x = a + 1;\n"
+      "  while (next()) {\n"
+      "    while (next()) {}\n"
+      "  }\n"
+      "  return x;\n"
+      "}\n"
+      "main() {\n"
+      "  foo(1);\n"
+      "}\n";
+  FlowGraph* flow_graph = AllocateRegisters(thread, script_chars);
+  EXPECT_EQ(0, CountLoopBlocksWithStackMoves(flow_graph));
+}
+
+#endif  // !defined(TARGET_ARCH_DBC)
+
+}  // namespace dart
@@ -11,6 +11,7 @@
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/loops.h"
+#include "vm/compiler/compiler_state.h"
 #include "vm/hash_map.h"
 #include "vm/stack_frame.h"
 
@@ -583,6 +584,121 @@ Place* Place::Wrap(Zone* zone, const Place& place, intptr_t id) {
   return wrapped;
 }
 
+EffectSummary* EffectSummary::Compute(Zone* zone, FlowGraph* flow_graph) {
+  EffectSummary* summary = new (zone) EffectSummary(zone);
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator instr_it(block_it.Current());
+         !instr_it.Done(); instr_it.Advance()) {
+      Instruction* instr = instr_it.Current();
+      if (instr->IsParallelMove()) {
+        // Inserted by the register allocator, has no memory effects.
+        continue;
+      }
+
+      bool is_load = false, is_store = false;
+      Place place(instr, &is_load, &is_store);
+      if (is_store) {
+        switch (place.kind()) {
+          case Place::kInstanceField:
+            if (place.instance_field().IsDartField()) {
+              if (!summary->AddField(place.instance_field().field())) {
+                return NULL;
+              }
+            } else {
+              summary->writes_other_slots_ = true;
+            }
+            break;
+          case Place::kStaticField:
+            if (!summary->AddField(place.static_field())) {
+              return NULL;
+            }
+            break;
+          default:
+            summary->writes_indexed_ = true;
+            break;
+        }
+      }
+
+      if (instr->HasUnknownSideEffects()) {
+        const EffectSummary* callee_summary = Lookup(instr);
+        if ((callee_summary == NULL) || !summary->Merge(*callee_summary)) {
+          return NULL;
+        }
+      }
+    }
+  }
+  return summary;
+}
+
+const EffectSummary* EffectSummary::Lookup(Instruction* call) {
+  const EffectSummaryTable* table = CompilerState::Current().effect_summaries();
+  StaticCallInstr* static_call = call->AsStaticCall();
+  if ((table != NULL) && (static_call != NULL)) {
+    return table->Lookup(static_call->function());
+  }
+  return NULL;
+}
+
+bool EffectSummary::MayWriteField(const Field& field) const {
+  const RawField* original = field.Original();
+  for (intptr_t i = 0; i < fields_.length(); i++) {
+    if (fields_[i]->raw() == original) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EffectSummary::AddField(const Field& field) {
+  if (MayWriteField(field)) {
+    return true;
+  }
+  if (fields_.length() == kMaxFields) {
+    return false;
+  }
+  fields_.Add(&Field::ZoneHandle(zone_, field.Original()));
+  return true;
+}
+
+bool EffectSummary::Merge(const EffectSummary& other) {
+  for (intptr_t i = 0; i < other.fields_.length(); i++) {
+    if (!AddField(*other.fields_[i])) {
+      return false;
+    }
+  }
+  writes_indexed_ = writes_indexed_ || other.writes_indexed_;
+  writes_other_slots_ = writes_other_slots_ || other.writes_other_slots_;
+  return true;
+}
+
+void EffectSummaryTable::Record(const Function& function,
+                                const EffectSummary* summary) {
+  KeyValueTrait::Pair* pair = map_.Lookup(&function);
+  if (pair != NULL) {
+    pair->value = summary;
+  } else if (summary != NULL) {
+    map_.Insert(KeyValueTrait::Pair(
+        &Function::ZoneHandle(zone_, function.raw()), summary));
+  }
+}
+
+void EffectSummary::Print() const {
+  THR_Print("{");
+  for (intptr_t i = 0; i < fields_.length(); i++) {
+    THR_Print("%s%s", (i > 0) ? ", " : "",
+              String::Handle(fields_[i]->name()).ToCString());
+  }
+  if (writes_indexed_) {
+    THR_Print("%s[*]", fields_.is_empty() ? "" : ", ");
+  }
+  if (writes_other_slots_) {
+    THR_Print("%s<slots>",
+              (fields_.is_empty() && !writes_indexed_) ? "" : ", ");
+  }
+  THR_Print("}");
+}
+
 // Correspondence between places connected through outgoing phi moves on the
 // edge that targets join.
 class PhiPlaceMoves : public ZoneAllocated {
@@ -669,6 +785,20 @@ class AliasedSet : public ZoneAllocated {
 
   BitVector* aliased_by_effects() const { return aliased_by_effects_; }
 
+  // Returns the subset of places aliased by effects which can be written by
+  // a call to a function with the given effect [summary].
+  BitVector* KilledBy(const EffectSummary* summary) {
+    BitVector* killed = new (zone_) BitVector(zone_, max_place_id());
+    for (BitVector::Iterator it(aliased_by_effects_); !it.Done();
+         it.Advance()) {
+      const Place* place = places_[it.Current()];
+      if (MayBeWrittenBy(place, summary)) {
+        killed->Add(place->id());
+      }
+    }
+    return killed;
+  }
+
   const ZoneGrowableArray<Place*>& places() const { return places_; }
 
   Place* LookupCanonical(Place* place) const {
@@ -935,6 +1065,25 @@ class AliasedSet : public ZoneAllocated {
   // Returns true if the given load is unaffected by external side-effects.
   // This essentially means that no stores to the same location can
   // occur in other functions.
+  static bool MayBeWrittenBy(const Place* place,
+                             const EffectSummary* summary) {
+    switch (place->kind()) {
+      case Place::kInstanceField:
+        return place->instance_field().IsDartField()
+                   ? summary->MayWriteField(place->instance_field().field())
+                   : summary->writes_other_slots();
+      case Place::kStaticField:
+        return summary->MayWriteField(place->static_field());
+      case Place::kIndexed:
+      case Place::kConstantIndexed:
+        return summary->writes_indexed();
+      case Place::kNone:
+        break;
+    }
+    UNREACHABLE();
+    return true;
+  }
+
   bool IsIndependentFromEffects(Place* place) {
     if (place->IsImmutableField()) {
       return true;
@@ -1571,13 +1720,25 @@ class LoadOptimizer : public ValueObject {
           }
         }
 
-        // If instruction has effects then kill all loads affected.
+        // If instruction has effects then kill all loads affected. Calls to
+        // functions with a known effect summary only kill the places the
+        // callee may write.
         if (instr->HasUnknownSideEffects()) {
-          kill->AddAll(aliased_set_->aliased_by_effects());
+          BitVector* killed_by_effects = aliased_set_->aliased_by_effects();
+          const EffectSummary* summary = EffectSummary::Lookup(instr);
+          if (summary != NULL) {
+            killed_by_effects = aliased_set_->KilledBy(summary);
+            if (FLAG_trace_load_optimization) {
+              THR_Print("%s kills only ", instr->ToCString());
+              aliased_set_->PrintSet(killed_by_effects);
+              THR_Print("\n");
+            }
+          }
+          kill->AddAll(killed_by_effects);
           // There is no need to clear out_values when removing values from GEN
           // set because only those values that are in the GEN set
           // will ever be used.
-          gen->RemoveAll(aliased_set_->aliased_by_effects());
+          gen->RemoveAll(killed_by_effects);
           continue;
         }
 
@@ -1633,6 +1794,27 @@ class LoadOptimizer : public ValueObject {
           continue;
         }
 
+        // Similarly, elements of a freshly allocated array are null until
+        // they are written.
+        CreateArrayInstr* array_alloc = instr->AsCreateArray();
+        if (array_alloc != NULL) {
+          for (Value* use = array_alloc->input_use_list(); use != NULL;
+               use = use->next_use()) {
+            if (use->use_index() != 0) {
+              continue;
+            }
+
+            LoadIndexedInstr* load = use->instruction()->AsLoadIndexed();
+            if ((load != NULL) && (load->class_id() == kArrayCid) &&
+                load->HasPlaceId() && load->index()->BindsToConstant()) {
+              gen->Add(load->place_id());
+              if (out_values == NULL) out_values = CreateBlockOutValues();
+              (*out_values)[load->place_id()] = graph_->constant_null();
+            }
+          }
+          continue;
+        }
+
         if (!IsLoadEliminationCandidate(defn)) {
           continue;
         }
@@ -2573,10 +2755,50 @@ void DeadStoreElimination::Optimize(FlowGraph* graph) {
 // Allocation Sinking
 //
 
+// Maximum length of a fixed-length array that is considered for allocation
+// sinking.
+static const intptr_t kMaxSinkableArrayLength = 16;
+
 // Returns true if the given instruction is an allocation that
 // can be sunk by the Allocation Sinking pass.
+//
+// Closures and iterators are plain AllocateObject instructions: they become
+// candidates once the calls they are passed to are inlined. Contexts are
+// lowered to AllocateUninitializedContext by the call specializer in both
+// JIT and AOT. Boxed doubles and Mints are not handled here: Box/Unbox pairs
+// are folded by canonicalization and unused boxes are removed as dead code,
+// while any other use of a box (a call, a phi or a store into an object
+// that is not a candidate) makes it escape.
 static bool IsSupportedAllocation(Instruction* instr) {
-  return instr->IsAllocateObject() || instr->IsAllocateUninitializedContext();
+  if (instr->IsAllocateObject() || instr->IsAllocateUninitializedContext()) {
+    return true;
+  }
+
+  // Fixed-length arrays are supported when their length is a small constant,
+  // so that every element can be addressed with a constant index.
+  CreateArrayInstr* array = instr->AsCreateArray();
+  if ((array != NULL) && array->num_elements()->BindsToConstant()) {
+    const Object& length = array->num_elements()->BoundConstant();
+    return length.IsSmi() && (Smi::Cast(length).Value() >= 0) &&
+           (Smi::Cast(length).Value() <= kMaxSinkableArrayLength);
+  }
+
+  return false;
+}
+
+// Returns true if the given store writes an element of the array allocated
+// by [array] at a constant in-bounds index.
+static bool IsConstantIndexStoreInto(StoreIndexedInstr* store,
+                                     CreateArrayInstr* array) {
+  if ((store->class_id() != kArrayCid) ||
+      (store->array()->definition() != array) ||
+      !store->index()->BindsToConstant()) {
+    return false;
+  }
+  const Object& index = store->index()->BoundConstant();
+  const Object& length = array->num_elements()->BoundConstant();
+  return index.IsSmi() && (Smi::Cast(index).Value() >= 0) &&
+         (Smi::Cast(index).Value() < Smi::Cast(length).Value());
 }
 
 enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
@@ -2587,7 +2809,11 @@ enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
 //     - any store into the allocation candidate itself is unconditionally safe
 //       as it just changes the rematerialization state of this candidate;
 //     - store into another object is only safe if another object is allocation
-//       candidate.
+//       candidate;
+//     - stores into elements of a candidate array are safe if the index is a
+//       constant within the bounds of the array. Values stored into arrays
+//       are considered escaping, and arrays themselves can't be stored into
+//       other candidates because they can't be rematerialized.
 //
 // We use a simple fix-point algorithm to discover the set of valid candidates
 // (see CollectCandidates method), that's why this IsSafeUse can operate in two
@@ -2610,13 +2836,21 @@ static bool IsSafeUse(Value* use, SafeUseCheck check_type) {
   if (store != NULL) {
     if (use == store->value()) {
       Definition* instance = store->instance()->definition();
-      return IsSupportedAllocation(instance) &&
+      return !use->definition()->IsCreateArray() &&
+             IsSupportedAllocation(instance) &&
              ((check_type == kOptimisticCheck) ||
               instance->Identity().IsAllocationSinkingCandidate());
     }
     return true;
   }
 
+  StoreIndexedInstr* store_indexed = use->instruction()->AsStoreIndexed();
+  if (store_indexed != NULL) {
+    CreateArrayInstr* array = use->definition()->AsCreateArray();
+    return (array != NULL) && (use == store_indexed->array()) &&
+           IsConstantIndexStoreInto(store_indexed, array);
+  }
+
   return false;
 }
 
@@ -2625,6 +2859,12 @@ static bool IsSafeUse(Value* use, SafeUseCheck check_type) {
 // instructions that write into fields of the allocated object.
 static bool IsAllocationSinkingCandidate(Definition* alloc,
                                          SafeUseCheck check_type) {
+  // Arrays can't be rematerialized by MaterializeObject, so they can only be
+  // eliminated if no deoptimization exit refers to them.
+  if (alloc->IsCreateArray() && (alloc->env_use_list() != NULL)) {
+    return false;
+  }
+
   for (Value* use = alloc->input_use_list(); use != NULL;
        use = use->next_use()) {
     if (!IsSafeUse(use, check_type)) {
@@ -7,6 +7,7 @@
 
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/il.h"
+#include "vm/hash_map.h"
 
 namespace dart {
 
@@ -79,6 +80,104 @@ class AllocationSinking : public ZoneAllocated {
   ExitsCollector exits_collector_;
 };
 
+// Summary of the memory a compiled function may write, including writes done
+// by the functions it calls. Load forwarding uses summaries to kill only the
+// places a call may actually write instead of all places aliased by effects.
+//
+// Summaries are recorded by the precompiler for every function it compiles
+// (see Precompiler::RecordEffectSummary) and looked up in the
+// EffectSummaryTable of the current CompilerState.
+class EffectSummary : public ZoneAllocated {
+ public:
+  // Functions writing more distinct fields than this are not summarized.
+  static const intptr_t kMaxFields = 16;
+
+  explicit EffectSummary(Zone* zone)
+      : zone_(zone),
+        fields_(zone, 4),
+        writes_indexed_(false),
+        writes_other_slots_(false) {}
+
+  // Computes the summary of the optimized [flow_graph] in [zone]. Returns
+  // NULL if the graph has effects which can't be summarized, e.g. a call to a
+  // function without a recorded summary.
+  static EffectSummary* Compute(Zone* zone, FlowGraph* flow_graph);
+
+  // Returns the summary of the function called by [call] or NULL if there is
+  // no EffectSummaryTable for the current compilation.
+  static const EffectSummary* Lookup(Instruction* call);
+
+  // Whether the instance or static [field] may be written.
+  bool MayWriteField(const Field& field) const;
+
+  // Whether an element of an array, typed data or string may be written.
+  bool writes_indexed() const { return writes_indexed_; }
+
+  // Whether a VM-internal slot (e.g. a context variable) may be written.
+  bool writes_other_slots() const { return writes_other_slots_; }
+
+  void Print() const;
+
+ private:
+  bool AddField(const Field& field);
+  bool Merge(const EffectSummary& other);
+
+  Zone* zone_;
+  GrowableArray<const Field*> fields_;
+  bool writes_indexed_;
+  bool writes_other_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(EffectSummary);
+};
+
+// Effect summaries of the functions compiled so far, keyed by function.
+class EffectSummaryTable : public ZoneAllocated {
+ public:
+  explicit EffectSummaryTable(Zone* zone) : zone_(zone), map_() {}
+
+  // Records the [summary] of [function], replacing any earlier summary. A
+  // NULL [summary] marks the effects of [function] as unknown.
+  void Record(const Function& function, const EffectSummary* summary);
+
+  // Returns the summary recorded for [function] or NULL.
+  const EffectSummary* Lookup(const Function& function) const {
+    return map_.LookupValue(&function);
+  }
+
+ private:
+  class KeyValueTrait {
+   public:
+    typedef const Function* Key;
+    typedef const EffectSummary* Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(NULL), value(NULL) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+
+    static Value ValueOf(Pair kv) { return kv.value; }
+
+    static inline intptr_t Hashcode(Key key) {
+      return (key->kernel_offset() > 0) ? key->kernel_offset()
+                                        : key->token_pos().value();
+    }
+
+    static inline bool IsKeyEqual(Pair pair, Key key) {
+      return pair.key->raw() == key->raw();
+    }
+  };
+
+  Zone* zone_;
+  DirectChainedHashMap<KeyValueTrait> map_;
+
+  DISALLOW_COPY_AND_ASSIGN(EffectSummaryTable);
+};
+
 // A simple common subexpression elimination based
 // on the dominator tree.
 class DominatorBasedCSE : public AllStatic {
@@ -0,0 +1,249 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/redundancy_elimination.h"
+#include "vm/compiler/backend/inliner.h"
+#include "vm/compiler/backend/type_propagator.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Builds the flow graph of the top-level function [name] after running
+// "main". The caller must provide the CompilerState.
+static FlowGraph* BuildFlowGraph(Thread* thread,
+                                 const Library& lib,
+                                 const char* name) {
+  Zone* zone = thread->zone();
+  RawFunction* raw_func =
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, name)));
+  ParsedFunction* parsed_function =
+      new (zone) ParsedFunction(thread, Function::ZoneHandle(zone, raw_func));
+
+  ZoneGrowableArray<const ICData*>* ic_data_array =
+      new (zone) ZoneGrowableArray<const ICData*>();
+  parsed_function->function().RestoreICDataMap(ic_data_array, true);
+  kernel::FlowGraphBuilder builder(parsed_function, ic_data_array, nullptr,
+                                   nullptr, true, DeoptId::kNone);
+  FlowGraph* flow_graph = builder.BuildGraph();
+  EXPECT(flow_graph != nullptr);
+
+  SpeculativeInliningPolicy speculative_policy(/*enable_blacklist*/ false);
+  JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
+  flow_graph->ComputeSSA(0, nullptr);
+  FlowGraphTypePropagator::Propagate(flow_graph);
+  call_specializer.ApplyICData();
+  flow_graph->Canonicalize();
+  return flow_graph;
+}
+
+// Computes the effect summary of the top-level function "foo".
+static const EffectSummary* ComputeEffectSummary(Thread* thread,
+                                                 const Library& lib) {
+  CompilerState state(thread);
+  return EffectSummary::Compute(thread->zone(),
+                                BuildFlowGraph(thread, lib, "foo"));
+}
+
+static intptr_t CountStaticFieldLoads(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsLoadStaticField()) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+static intptr_t CountArrayAllocations(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsCreateArray()) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+// Nothing deoptimizes in AOT, so all environments are gone by the time
+// allocation sinking runs (see FlowGraph::EliminateEnvironments). Emulate
+// that for graphs built in JIT mode.
+static void RemoveAllEnvironments(FlowGraph* flow_graph) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    block->RemoveEnvironment();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      it.Current()->RemoveEnvironment();
+    }
+  }
+}
+
+static RawField* LookupField(Thread* thread,
+                             const Library& lib,
+                             const char* name) {
+  return lib.LookupLocalField(String::Handle(Symbols::New(thread, name)));
+}
+
+TEST_CASE(EffectSummary_StaticFields) {
+  const char* script_chars =
+      "int a = 0;\n"
+      "int b = 0;\n"
+      "int c = 0;\n"
+      "foo() {\n"
+      "  a = 1;\n"
+      "  b = 2;\n"
+      "}\n"
+      "main() {\n"
+      "  foo();\n"
+      "}\n";
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+  const EffectSummary* summary = ComputeEffectSummary(thread, lib);
+  EXPECT(summary != NULL);
+
+  Field& field = Field::Handle();
+  field = LookupField(thread, lib, "a");
+  EXPECT(summary->MayWriteField(field));
+  field = LookupField(thread, lib, "b");
+  EXPECT(summary->MayWriteField(field));
+  field = LookupField(thread, lib, "c");
+  EXPECT(!summary->MayWriteField(field));
+  EXPECT(!summary->writes_indexed());
+}
+
+TEST_CASE(EffectSummary_UnknownCall) {
+  const char* script_chars =
+      "int a = 0;\n"
+      "@pragma('vm:never-inline')\n"
+      "bar() {\n"
+      "  a++;\n"
+      "}\n"
+      "foo() {\n"
+      "  a = 1;\n"
+      "  bar();\n"
+      "}\n"
+      "main() {\n"
+      "  foo();\n"
+      "}\n";
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+
+  // No summary is recorded for bar() outside of the precompiler, so the
+  // effects of foo() are unknown.
+  EXPECT(ComputeEffectSummary(thread, lib) == NULL);
+}
+
+TEST_CASE(LoadOptimizer_ForwardAcrossCallWithSummary) {
+  const char* script_chars =
+      "int a = 0;\n"
+      "int b = 0;\n"
+      "@pragma('vm:never-inline')\n"
+      "bar() {\n"
+      "  b = 1;\n"
+      "}\n"
+      "foo() {\n"
+      "  var v = a;\n"
+      "  bar();\n"
+      "  return v + a;\n"
+      "}\n"
+      "main() {\n"
+      "  foo();\n"
+      "}\n";
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+  const Function& bar = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, "bar"))));
+
+  // Without a summary for bar() the call kills the first load of a.
+  {
+    CompilerState state(thread);
+    FlowGraph* flow_graph = BuildFlowGraph(thread, lib, "foo");
+    EXPECT_EQ(2, CountStaticFieldLoads(flow_graph));
+    DominatorBasedCSE::Optimize(flow_graph);
+    EXPECT_EQ(2, CountStaticFieldLoads(flow_graph));
+  }
+
+  // bar() only writes b, so the second load of a is replaced by the first.
+  {
+    CompilerState state(thread);
+    EffectSummaryTable summaries(thread->zone());
+    const EffectSummary* bar_summary = EffectSummary::Compute(
+        thread->zone(), BuildFlowGraph(thread, lib, "bar"));
+    EXPECT(bar_summary != NULL);
+    summaries.Record(bar, bar_summary);
+    state.set_effect_summaries(&summaries);
+
+    FlowGraph* flow_graph = BuildFlowGraph(thread, lib, "foo");
+    EXPECT_EQ(2, CountStaticFieldLoads(flow_graph));
+    DominatorBasedCSE::Optimize(flow_graph);
+    EXPECT_EQ(1, CountStaticFieldLoads(flow_graph));
+  }
+}
+
+TEST_CASE(AllocationSinking_FixedLengthArray) {
+  const char* script_chars =
+      "foo(a, b) {\n"
+      "  final pair = new List(2);\n"
+      "  pair[0] = a;\n"
+      "  pair[1] = b;\n"
+      "  return pair[1];\n"
+      "}\n"
+      "main() {\n"
+      "  for (var i = 0; i < 10; i++) {\n"
+      "    foo(i, i + 1);\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle script = TestCase::LoadTestScript(script_chars, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+
+  CompilerState state(thread);
+  FlowGraph* flow_graph = BuildFlowGraph(thread, lib, "foo");
+  EXPECT_EQ(1, CountArrayAllocations(flow_graph));
+
+  // Forward the loads of the elements, then the array is only used by its
+  // own stores and the allocation is removed.
+  RemoveAllEnvironments(flow_graph);
+  flow_graph->Canonicalize();
+  DominatorBasedCSE::Optimize(flow_graph);
+  flow_graph->Canonicalize();
+  AllocationSinking* sinking = new AllocationSinking(flow_graph);
+  sinking->Optimize();
+  EXPECT_EQ(0, CountArrayAllocations(flow_graph));
+}
+
+}  // namespace dart
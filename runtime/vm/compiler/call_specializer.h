@@ -60,6 +60,8 @@ class CallSpecializer : public FlowGraphVisitor {
   // specialization of calls. They are here for historical reasons.
   // Find a better place for them.
   virtual void VisitLoadCodeUnits(LoadCodeUnitsInstr* instr);
+  virtual void VisitAllocateContext(AllocateContextInstr* instr);
+  virtual void VisitCloneContext(CloneContextInstr* instr);
 
  protected:
   Thread* thread() const { return flow_graph_->thread(); }
@@ -117,6 +119,11 @@ class CallSpecializer : public FlowGraphVisitor {
  protected:
   void InlineImplicitInstanceGetter(Definition* call, const Field& field);
 
+  void LowerContextAllocation(
+      Definition* instr,
+      const GrowableArray<LocalVariable*>& context_variables,
+      Value* context_value);
+
   SpeculativeInliningPolicy* speculative_policy_;
   const bool should_clone_fields_;
 
@@ -209,6 +209,10 @@ void CompilerPass::PrintGraph(CompilerPassState* state,
 
 void CompilerPass::RunPipeline(PipelineMode mode,
                                CompilerPassState* pass_state) {
+  if (mode == kJITMidTier) {
+    RunMidTierPipeline(pass_state);
+    return;
+  }
   INVOKE_PASS(ComputeSSA);
 #if defined(DART_PRECOMPILER)
   if (mode == kAOT) {
@@ -270,6 +274,27 @@ void CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(ReorderBlocks);
 }
 
+// The mid tier specializes calls using the type feedback, which also inlines
+// implicit getters and setters, but skips the inliner and the passes which
+// analyze the whole graph repeatedly (CSE, LICM, range analysis, allocation
+// sinking), so it is cheap enough for huge functions.
+void CompilerPass::RunMidTierPipeline(CompilerPassState* pass_state) {
+  INVOKE_PASS(ComputeSSA);
+  INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(SetOuterInliningId);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyClassIds);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(SelectRepresentations);
+  INVOKE_PASS(EliminateDeadPhis);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(WriteBarrierElimination);
+  INVOKE_PASS(FinalizeGraph);
+  INVOKE_PASS(AllocateRegisters);
+  INVOKE_PASS(ReorderBlocks);
+}
+
 COMPILER_PASS(ComputeSSA, {
   // Transform to SSA (virtual register 0 and no inlining arguments).
   flow_graph->ComputeSSA(0, NULL);
@@ -137,7 +137,9 @@ class CompilerPass {
 
   static void ParseFilters(const char* filter);
 
-  enum PipelineMode { kJIT, kAOT };
+  // kJITMidTier is the cheaper pipeline used for warm and huge functions in
+  // JIT mode.
+  enum PipelineMode { kJIT, kJITMidTier, kAOT };
 
   static void RunPipeline(PipelineMode mode, CompilerPassState* state);
 
@@ -157,6 +159,8 @@ class CompilerPass {
     return NULL;
   }
 
+  static void RunMidTierPipeline(CompilerPassState* state);
+
   void PrintGraph(CompilerPassState* state, Flag mask, intptr_t round) const;
 
   static CompilerPass* passes_[];
@@ -11,6 +11,7 @@
 
 namespace dart {
 
+class EffectSummaryTable;
 class LocalScope;
 class LocalVariable;
 class SlotCache;
@@ -88,6 +89,15 @@ class CompilerState : public ThreadStackResource {
   SlotCache* slot_cache() const { return slot_cache_; }
   void set_slot_cache(SlotCache* cache) { slot_cache_ = cache; }
 
+  // Summaries of the functions compiled so far, used to forward loads across
+  // calls to them (see EffectSummary). NULL if no summaries are available.
+  const EffectSummaryTable* effect_summaries() const {
+    return effect_summaries_;
+  }
+  void set_effect_summaries(const EffectSummaryTable* table) {
+    effect_summaries_ = table;
+  }
+
   // Create a dummy list of local variables representing a context object
   // with the given number of captured variables and given ID.
   //
@@ -121,6 +131,8 @@ class CompilerState : public ThreadStackResource {
   // Cache for Slot objects created during compilation (see slot.h).
   SlotCache* slot_cache_ = nullptr;
 
+  const EffectSummaryTable* effect_summaries_ = nullptr;
+
   // Caches for dummy LocalVariables and LocalScopes created during
   // bytecode to IL translation.
   ZoneGrowableArray<LocalScope*>* dummy_scopes_ = nullptr;
@@ -92,7 +92,6 @@ DEFINE_FLAG(bool,
 DECLARE_FLAG(bool, enable_interpreter);
 DECLARE_FLAG(bool, huge_method_cutoff_in_code_size);
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
-DECLARE_FLAG(bool, unbox_numeric_fields);
 
 static void PrecompilationModeHandler(bool value) {
   if (value) {
@@ -117,11 +116,6 @@ static void PrecompilationModeHandler(bool value) {
     FLAG_use_field_guards = false;
     FLAG_use_cha_deopt = false;
 
-#if !defined(DART_PRECOMPILED_RUNTIME)
-    // Not present with DART_PRECOMPILED_RUNTIME
-    FLAG_unbox_numeric_fields = false;
-#endif
-
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
     // Set flags affecting runtime accordingly for gen_snapshot.
     // These flags are constants with PRODUCT and DART_PRECOMPILED_RUNTIME.
@@ -312,7 +306,7 @@ bool Compiler::CanOptimizeFunction(Thread* thread, const Function& function) {
       return false;
     }
   }
-  if (!function.IsOptimizable()) {
+  if (!function.IsOptimizable() && !function.IsMidTierOptimizable()) {
     // Huge methods (code size above --huge_method_cutoff_in_code_size) become
     // non-optimizable only after the code has been generated.
     if (FLAG_trace_failed_optimization_attempts) {
@@ -334,6 +328,21 @@ RawError* Compiler::Compile(const Library& library, const Script& script) {
   return Error::null();
 }
 
+// Whether an optimizing compilation of the function should use the mid-tier
+// pipeline. Huge functions are only ever compiled by the mid tier, others go
+// through it once before the full pipeline recompiles them when they get hot.
+static bool UseMidTier(const Function& function, intptr_t osr_id) {
+  if (!function.IsMidTierOptimizable()) {
+    return false;
+  }
+  if (!function.IsOptimizable()) {
+    return true;
+  }
+  return (FLAG_mid_tier_counter_threshold <
+          FLAG_optimization_counter_threshold) &&
+         (osr_id == Compiler::kNoOSRDeoptId) && !function.HasOptimizedCode();
+}
+
 class CompileParsedFunctionHelper : public ValueObject {
  public:
   CompileParsedFunctionHelper(ParsedFunction* parsed_function,
@@ -341,6 +350,8 @@ class CompileParsedFunctionHelper : public ValueObject {
                               intptr_t osr_id)
       : parsed_function_(parsed_function),
         optimized_(optimized),
+        mid_tier_(optimized &&
+                  UseMidTier(parsed_function->function(), osr_id)),
         osr_id_(osr_id),
         thread_(Thread::Current()),
         loading_invalidation_gen_at_start_(
@@ -351,6 +362,7 @@ class CompileParsedFunctionHelper : public ValueObject {
  private:
   ParsedFunction* parsed_function() const { return parsed_function_; }
   bool optimized() const { return optimized_; }
+  bool mid_tier() const { return mid_tier_; }
   intptr_t osr_id() const { return osr_id_; }
   Thread* thread() const { return thread_; }
   Isolate* isolate() const { return thread_->isolate(); }
@@ -364,6 +376,7 @@ class CompileParsedFunctionHelper : public ValueObject {
 
   ParsedFunction* parsed_function_;
   const bool optimized_;
+  const bool mid_tier_;
   const intptr_t osr_id_;
   Thread* const thread_;
   const intptr_t loading_invalidation_gen_at_start_;
@@ -389,6 +402,7 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
       function, graph_compiler, assembler, Code::PoolAttachment::kAttachPool,
       optimized(), /*stats=*/nullptr));
   code.set_is_optimized(optimized());
+  code.set_is_mid_tier(mid_tier());
   code.set_owner(function);
 #if !defined(PRODUCT)
   ZoneGrowableArray<TokenPosition>* await_token_positions =
@@ -415,7 +429,7 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
   }
 #endif  // !defined(PRODUCT)
 
-  if (!function.IsOptimizable()) {
+  if (!function.IsOptimizable() && !function.IsMidTierOptimizable()) {
     // A function with huge unoptimized code can become non-optimizable
     // after generating unoptimized code.
     function.SetUsageCounter(INT_MIN);
@@ -523,7 +537,8 @@ RawCode* CompileParsedFunctionHelper::FinalizeCompilation(
     function.set_unoptimized_code(code);
     function.AttachCode(code);
     function.SetWasCompiled(true);
-    if (function.IsOptimizable() && (function.usage_counter() < 0)) {
+    if ((function.IsOptimizable() || function.IsMidTierOptimizable()) &&
+        (function.usage_counter() < 0)) {
       // While doing compilation in background, usage counter is set
       // to INT_MIN. Reset counter so that function can be optimized further.
       function.SetUsageCounter(0);
@@ -555,7 +570,7 @@ void CompileParsedFunctionHelper::CheckIfBackgroundCompilerIsBeingStopped() {
 RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   ASSERT(!FLAG_precompiled_mode);
   const Function& function = parsed_function()->function();
-  if (optimized() && !function.IsOptimizable()) {
+  if (optimized() && !mid_tier() && !function.IsOptimizable()) {
     return Code::null();
   }
   Zone* const zone = thread()->zone();
@@ -622,6 +637,9 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
         flow_graph = pipeline->BuildFlowGraph(
             zone, parsed_function(), ic_data_array, osr_id(), optimized());
+        if (mid_tier()) {
+          flow_graph->set_is_mid_tier();
+        }
       }
 
       const bool print_flow_graph =
@@ -661,7 +679,9 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
         pass_state.call_specializer = &call_specializer;
 
-        CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        CompilerPass::RunPipeline(
+            mid_tier() ? CompilerPass::kJITMidTier : CompilerPass::kJIT,
+            &pass_state);
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
@@ -462,6 +462,7 @@ word Array::header_size() {
   V(Thread, bool_false_offset)                                                 \
   V(Thread, bool_true_offset)                                                  \
   V(Thread, dart_stream_offset)                                                \
+  V(Thread, dispatch_table_offset)                                             \
   V(Thread, end_offset)                                                        \
   V(Thread, global_object_pool_offset)                                         \
   V(Thread, isolate_offset)                                                    \
@@ -484,6 +485,8 @@ word Array::header_size() {
   V(TypeRef, type_offset)                                                      \
   V(Type, signature_offset)                                                    \
   V(Type, type_state_offset)                                                   \
+  V(UnlinkedCall, args_descriptor_offset)                                      \
+  V(UnlinkedCall, dispatch_table_offset_offset)                                \
   V(UserTag, tag_offset)
 
 #define DEFINE_FORWARDER(clazz, name)                                          \
@@ -568,6 +571,10 @@ word Thread::ic_lookup_through_code_stub_offset() {
   return dart::Thread::ic_lookup_through_code_stub_offset();
 }
 
+word Thread::unlinked_call_stub_offset() {
+  return dart::Thread::unlinked_call_stub_offset();
+}
+
 word Thread::lazy_specialize_type_test_stub_offset() {
   return dart::Thread::lazy_specialize_type_test_stub_offset();
 }
@@ -416,6 +416,12 @@ class MegamorphicCache : public AllStatic {
   static word arguments_descriptor_offset();
 };
 
+class UnlinkedCall : public AllStatic {
+ public:
+  static word args_descriptor_offset();
+  static word dispatch_table_offset_offset();
+};
+
 class SingleTargetCache : public AllStatic {
  public:
   static word lower_limit_offset();
@@ -525,6 +531,7 @@ class Thread : public AllStatic {
  public:
   static word dart_stream_offset();
   static word async_stack_trace_offset();
+  static word dispatch_table_offset();
   static word predefined_symbols_address_offset();
 
   static word active_exception_offset();
@@ -559,6 +566,7 @@ class Thread : public AllStatic {
 
   static word monomorphic_miss_stub_offset();
   static word ic_lookup_through_code_stub_offset();
+  static word unlinked_call_stub_offset();
   static word lazy_specialize_type_test_stub_offset();
   static word slow_type_test_stub_offset();
   static word call_to_runtime_stub_offset();
@@ -2883,6 +2883,44 @@ void StubCodeCompiler::GenerateSingleTargetCallStub(Assembler* assembler) {
       CODE_REG, target::Code::entry_point_offset(CodeEntryKind::kMonomorphic)));
 }
 
+// Called from switchable calls whose selector has a row in the dispatch
+// table. Falls back to the UnlinkedCall stub if the table slot for the
+// receiver's class belongs to another selector.
+//  R0: receiver
+//  R9: UnlinkedCall (preserved)
+// Passed to target:
+//  CODE_REG: target Code object
+//  R4: arguments descriptor
+void StubCodeCompiler::GenerateDispatchTableCallStub(Assembler* assembler) {
+  Label miss;
+  const intptr_t offset_offset =
+      target::UnlinkedCall::dispatch_table_offset_offset();
+  const intptr_t base = target::Array::data_offset();
+  __ LoadTaggedClassIdMayBeSmi(R1, R0);
+  __ ldr(R2, FieldAddress(R9, offset_offset));
+  __ add(R1, R1, Operand(R2));
+  // Every table slot is a (selector offset, target code) pair.
+  __ add(R1, R1, Operand(R1));
+  // R1: Smi index of the slot's selector offset.
+  __ ldr(R3, Address(THR, target::Thread::dispatch_table_offset()));
+  __ ldr(R8, FieldAddress(R3, target::Array::length_offset()));
+  __ cmp(R1, Operand(R8));
+  __ b(&miss, CS);  // Branch if unsigned higher or equal, also if negative.
+
+  __ add(R3, R3, Operand(R1, LSL, 1));
+  __ ldr(R8, FieldAddress(R3, base));
+  __ cmp(R8, Operand(R2));
+  __ b(&miss, NE);
+  __ ldr(CODE_REG, FieldAddress(R3, base + target::kWordSize));
+  __ ldr(R4, FieldAddress(R9, target::UnlinkedCall::args_descriptor_offset()));
+  __ Branch(FieldAddress(CODE_REG, target::Code::entry_point_offset()));
+
+  __ Bind(&miss);
+  __ ldr(CODE_REG, Address(THR, target::Thread::unlinked_call_stub_offset()));
+  __ Branch(FieldAddress(CODE_REG, target::Code::entry_point_offset(
+                                       CodeEntryKind::kMonomorphic)));
+}
+
 // Called from the monomorphic checked entry.
 //  R0: receiver
 void StubCodeCompiler::GenerateMonomorphicMissStub(Assembler* assembler) {
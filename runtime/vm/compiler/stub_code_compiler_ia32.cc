@@ -2354,6 +2354,10 @@ void StubCodeCompiler::GenerateSingleTargetCallStub(Assembler* assembler) {
   __ int3();
 }
 
+void StubCodeCompiler::GenerateDispatchTableCallStub(Assembler* assembler) {
+  __ int3();
+}
+
 void StubCodeCompiler::GenerateMonomorphicMissStub(Assembler* assembler) {
   __ int3();
 }
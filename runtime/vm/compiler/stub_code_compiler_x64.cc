@@ -3193,6 +3193,43 @@ void StubCodeCompiler::GenerateSingleTargetCallStub(Assembler* assembler) {
   __ jmp(RCX);
 }
 
+// Called from switchable calls whose selector has a row in the dispatch
+// table. Falls back to the UnlinkedCall stub if the table slot for the
+// receiver's class belongs to another selector.
+//  RDI: receiver
+//  RBX: UnlinkedCall (preserved)
+// Passed to target:
+//  CODE_REG: target Code object
+//  R10: arguments descriptor
+void StubCodeCompiler::GenerateDispatchTableCallStub(Assembler* assembler) {
+  Label miss;
+  const intptr_t offset_offset =
+      target::UnlinkedCall::dispatch_table_offset_offset();
+  __ LoadTaggedClassIdMayBeSmi(RAX, RDI);
+  __ addq(RAX, FieldAddress(RBX, offset_offset));
+  // Every table slot is a (selector offset, target code) pair.
+  __ addq(RAX, RAX);
+  // RAX: Smi index of the slot's selector offset.
+  __ movq(R9, Address(THR, target::Thread::dispatch_table_offset()));
+  __ cmpq(RAX, FieldAddress(R9, target::Array::length_offset()));
+  __ j(ABOVE_EQUAL, &miss, Assembler::kNearJump);  // Also if negative.
+
+  const intptr_t base = target::Array::data_offset();
+  __ movq(RCX, FieldAddress(R9, RAX, TIMES_4, base));
+  __ cmpq(RCX, FieldAddress(RBX, offset_offset));
+  __ j(NOT_EQUAL, &miss, Assembler::kNearJump);
+  __ movq(CODE_REG,
+          FieldAddress(R9, RAX, TIMES_4, base + target::kWordSize));
+  __ movq(R10,
+          FieldAddress(RBX, target::UnlinkedCall::args_descriptor_offset()));
+  __ jmp(FieldAddress(CODE_REG, target::Code::entry_point_offset()));
+
+  __ Bind(&miss);
+  __ movq(CODE_REG, Address(THR, target::Thread::unlinked_call_stub_offset()));
+  __ jmp(FieldAddress(CODE_REG, target::Code::entry_point_offset(
+                                    CodeEntryKind::kMonomorphic)));
+}
+
 // Called from the monomorphic checked entry.
 //  RDI: receiver
 void StubCodeCompiler::GenerateMonomorphicMissStub(Assembler* assembler) {
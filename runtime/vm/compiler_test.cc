@@ -110,6 +110,101 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+static void InvokeSum(Thread* thread, const Library& lib) {
+  Dart_Handle api_lib = Api::NewHandle(thread, lib.raw());
+  TransitionVMToNative transition(thread);
+  Dart_Handle args[] = {Dart_NewInteger(1), Dart_NewInteger(2)};
+  Dart_Handle result = Dart_Invoke(api_lib, NewString("sum"), 2, args);
+  EXPECT_VALID(result);
+}
+
+ISOLATE_UNIT_TEST_CASE(CompileFunction_MidTierTiersUp) {
+  SetFlagScope<bool> sfs(&FLAG_background_compilation, false);
+  SetFlagScope<int> sfs2(&FLAG_mid_tier_counter_threshold, 5);
+  SetFlagScope<int> sfs3(&FLAG_optimization_counter_threshold, 100);
+  const char* kScriptChars = "sum(a, b) => a + b;\n";
+  Dart_Handle api_lib;
+  {
+    TransitionVMToNative transition(thread);
+    api_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(api_lib);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(api_lib)));
+  const Function& sum = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, "sum"))));
+  EXPECT(!sum.IsNull());
+
+  // A warm function is compiled by the mid tier first...
+  for (intptr_t i = 0; (i < 1000) && !sum.HasOptimizedCode(); i++) {
+    InvokeSum(thread, lib);
+  }
+  Code& code = Code::Handle(sum.CurrentCode());
+  EXPECT(code.is_optimized());
+  EXPECT(code.is_mid_tier());
+
+  // ...and by the full pipeline once the mid-tier code gets hot.
+  for (intptr_t i = 0; (i < 1000) && code.is_mid_tier(); i++) {
+    InvokeSum(thread, lib);
+    code = sum.CurrentCode();
+  }
+  EXPECT(code.is_optimized());
+  EXPECT(!code.is_mid_tier());
+}
+
+static int64_t InvokeLoop(Thread* thread, const Library& lib, intptr_t n) {
+  Dart_Handle api_lib = Api::NewHandle(thread, lib.raw());
+  TransitionVMToNative transition(thread);
+  Dart_Handle args[] = {Dart_NewInteger(n)};
+  Dart_Handle result = Dart_Invoke(api_lib, NewString("loop"), 1, args);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  return value;
+}
+
+ISOLATE_UNIT_TEST_CASE(CompileFunction_MidTierLoopTiersUp) {
+  SetFlagScope<bool> sfs(&FLAG_background_compilation, false);
+  SetFlagScope<int> sfs2(&FLAG_mid_tier_counter_threshold, 5);
+  SetFlagScope<int> sfs3(&FLAG_optimization_counter_threshold, 100);
+  if (!thread->isolate()->use_osr()) {
+    return;
+  }
+  const char* kScriptChars =
+      "loop(n) {\n"
+      "  var sum = 0;\n"
+      "  for (var i = 0; i < n; i++) {\n"
+      "    sum += i;\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n";
+  Dart_Handle api_lib;
+  {
+    TransitionVMToNative transition(thread);
+    api_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(api_lib);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(api_lib)));
+  const Function& loop = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, "loop"))));
+  EXPECT(!loop.IsNull());
+
+  for (intptr_t i = 0; (i < 1000) && !loop.HasOptimizedCode(); i++) {
+    EXPECT_EQ(0, InvokeLoop(thread, lib, 1));
+  }
+  Code& code = Code::Handle(loop.CurrentCode());
+  EXPECT(code.is_mid_tier());
+
+  // A single call with a hot loop leaves the mid-tier code: the loop counts
+  // its iterations, and the function gets code of the full pipeline.
+  const intptr_t n = 100 * 1000;
+  EXPECT_EQ(static_cast<int64_t>(n) * (n - 1) / 2, InvokeLoop(thread, lib, n));
+  code = loop.CurrentCode();
+  EXPECT(code.is_optimized());
+  EXPECT(!code.is_mid_tier());
+}
+
 ISOLATE_UNIT_TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
@@ -1124,9 +1124,15 @@ bool ApiMessageWriter::WriteCObjectInlined(Dart_CObject* object,
         case Dart_TypedData_kUint8:
           class_id = kTypedDataUint8ArrayCid;
           break;
+        case Dart_TypedData_kInt32:
+          class_id = kTypedDataInt32ArrayCid;
+          break;
         case Dart_TypedData_kUint32:
           class_id = kTypedDataUint32ArrayCid;
           break;
+        case Dart_TypedData_kInt64:
+          class_id = kTypedDataInt64ArrayCid;
+          break;
         default:
           class_id = kTypedDataUint8ArrayCid;
           UNIMPLEMENTED();
@@ -1147,11 +1153,17 @@ bool ApiMessageWriter::WriteCObjectInlined(Dart_CObject* object,
           WriteBytes(bytes, len);
           break;
         }
+        case kTypedDataInt32ArrayCid:
         case kTypedDataUint32ArrayCid: {
           uint8_t* bytes = object->value.as_typed_data.values;
           WriteBytes(bytes, len * sizeof(uint32_t));
           break;
         }
+        case kTypedDataInt64ArrayCid: {
+          uint8_t* bytes = object->value.as_typed_data.values;
+          WriteBytes(bytes, len * sizeof(int64_t));
+          break;
+        }
         default:
           UNIMPLEMENTED();
       }
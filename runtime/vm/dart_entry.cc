@@ -122,12 +122,14 @@ RawObject* DartEntry::InvokeFunction(const Function& function,
 #if !defined(DART_PRECOMPILED_RUNTIME)
     UNREACHABLE();
 #else
+    Thread* thread = Thread::Current();
     if (FLAG_precompiled_mode && FLAG_use_bare_instructions) {
-      Thread* thread = Thread::Current();
       thread->set_global_object_pool(
           thread->isolate()->object_store()->global_object_pool());
       ASSERT(thread->global_object_pool() != Object::null());
     }
+    thread->set_dispatch_table(
+        thread->isolate()->object_store()->dispatch_table());
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
   }
 
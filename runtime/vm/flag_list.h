@@ -102,7 +102,8 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(guess_icdata_cid, bool, true,                                              \
     "Artificially create type feedback for arithmetic etc. operations")        \
   P(huge_method_cutoff_in_tokens, int, 20000,                                  \
-    "Huge method cutoff in tokens: Disables optimizations for huge methods.")  \
+    "Huge method cutoff in tokens: Huge methods are not optimized, except "    \
+    "by the mid tier when it is enabled.")                                     \
   P(idle_timeout_micros, int, 1000 * kMicrosecondsPerMillisecond,              \
     "Consider thread pool isolates for idle tasks after this long.")           \
   P(idle_duration_micros, int, 500 * kMicrosecondsPerMillisecond,              \
@@ -121,6 +122,9 @@ constexpr bool kDartPrecompiledRuntime = false;
     "Maximum number of polymorphic check, otherwise it is megamorphic.")       \
   P(max_equality_polymorphic_checks, int, 32,                                  \
     "Maximum number of polymorphic checks in equality operator,")              \
+  P(mid_tier_counter_threshold, int, USING_DBC ? -1 : 2000,                    \
+    "Function's usage-counter value before it is compiled by the cheaper "     \
+    "mid-tier optimizing compiler, -1 means never")                            \
   P(new_gen_semi_max_size, int, (kWordSize <= 4) ? 8 : 16,                     \
     "Max size of new gen semi space in MB")                                    \
   P(new_gen_semi_initial_size, int, (kWordSize <= 4) ? 1 : 2,                  \
@@ -6453,6 +6453,14 @@ bool Function::IsOptimizable() const {
   return false;
 }
 
+bool Function::IsMidTierOptimizable() const {
+  if (FLAG_precompiled_mode || (FLAG_mid_tier_counter_threshold < 0)) {
+    return false;
+  }
+  return !is_native() && !IsIrregexpFunction() && is_optimizable() &&
+         (script() != Script::null());
+}
+
 void Function::SetIsOptimizable(bool value) const {
   ASSERT(!is_native());
   set_is_optimizable(value);
@@ -8777,16 +8785,16 @@ bool Field::UpdateGuardedCidAndLength(const Object& value) const {
   return true;
 }
 
-// Given the type G<T0, ..., Tn> and class C<U0, ..., Un> find path to C at G.
+// Given the class G<T0, ..., Tn> and class C<U0, ..., Un> find path to C at G.
 // This path can be used to compute type arguments of C at G.
 //
 // Note: we are relying on the restriction that the same class can only occur
 // once among the supertype.
-static bool FindInstantiationOf(const Type& type,
+static bool FindInstantiationOf(const Class& type_class,
                                 const Class& cls,
                                 GrowableArray<const AbstractType*>* path,
                                 bool consider_only_super_classes) {
-  if (type.type_class() == cls.raw()) {
+  if (type_class.raw() == cls.raw()) {
     return true;  // Found instantiation.
   }
 
@@ -8796,7 +8804,8 @@ static bool FindInstantiationOf(const Type& type,
   if (!super_type.IsNull() && !super_type.IsObjectType()) {
     cls2 = super_type.type_class();
     path->Add(&super_type);
-    if (FindInstantiationOf(type, cls2, path, consider_only_super_classes)) {
+    if (FindInstantiationOf(type_class, cls2, path,
+                            consider_only_super_classes)) {
       return true;  // Found instantiation.
     }
     path->RemoveLast();
@@ -8808,7 +8817,7 @@ static bool FindInstantiationOf(const Type& type,
       super_type ^= super_interfaces.At(i);
       cls2 = super_type.type_class();
       path->Add(&super_type);
-      if (FindInstantiationOf(type, cls2, path,
+      if (FindInstantiationOf(type_class, cls2, path,
                               /*consider_only_supertypes=*/false)) {
         return true;  // Found instantiation.
       }
@@ -8819,6 +8828,31 @@ static bool FindInstantiationOf(const Type& type,
   return false;  // Not found.
 }
 
+RawTypeArguments* Class::GetInstantiationOf(const Class& cls) const {
+  if (raw() == cls.raw()) {
+    return Type::Handle(DeclarationType()).arguments();
+  }
+  GrowableArray<const AbstractType*> path(10);
+  if (!FindInstantiationOf(cls, *this, &path,
+                           /*consider_only_super_classes=*/false)) {
+    return TypeArguments::null();
+  }
+  ASSERT(!path.is_empty());
+
+  // See [StaticTypeExactnessState::Compute] for how the chain of supertypes
+  // is instantiated back down to this class.
+  AbstractType& type = AbstractType::Handle(path.Last()->raw());
+  TypeArguments& args = TypeArguments::Handle();
+  for (intptr_t i = path.length() - 2; (i >= 0) && !type.IsInstantiated();
+       i--) {
+    args = path[i]->arguments();
+    type = type.InstantiateFrom(args, TypeArguments::null_type_arguments(),
+                                kAllFree,
+                                /*instantiation_trail=*/nullptr, Heap::kNew);
+  }
+  return type.arguments();
+}
+
 static StaticTypeExactnessState TrivialTypeExactnessFor(const Class& cls) {
   const intptr_t type_arguments_offset = cls.type_arguments_field_offset();
   ASSERT(type_arguments_offset != Class::kNoTypeArguments);
@@ -8848,14 +8882,15 @@ StaticTypeExactnessState StaticTypeExactnessState::Compute(
 
   ASSERT(static_type.IsFinalized());
   const Class& cls = Class::Handle(value.clazz());
+  const Class& static_type_class = Class::Handle(static_type.type_class());
   GrowableArray<const AbstractType*> path(10);
 
   bool is_super_class = true;
-  if (!FindInstantiationOf(static_type, cls, &path,
+  if (!FindInstantiationOf(static_type_class, cls, &path,
                            /*consider_only_super_classes=*/true)) {
     is_super_class = false;
     bool found_super_interface = FindInstantiationOf(
-        static_type, cls, &path, /*consider_only_super_classes=*/false);
+        static_type_class, cls, &path, /*consider_only_super_classes=*/false);
     ASSERT(found_super_interface);
   }
 
@@ -9064,6 +9099,23 @@ void Field::RecordStore(const Object& value) const {
   }
 }
 
+const Object* Field::CloneForUnboxed(const Object& value) const {
+  // The guarded state is not available in precompiled mode, so check the
+  // class of the value instead: copying a double or SIMD value is not
+  // observable.
+  if (!is_unboxing_candidate() || is_final() || is_static()) {
+    return &value;
+  }
+  switch (value.GetClassId()) {
+    case kDoubleCid:
+    case kFloat32x4Cid:
+    case kFloat64x2Cid:
+      return &Object::Handle(Object::Clone(value, Heap::kNew));
+    default:
+      return &value;
+  }
+}
+
 void Field::ForceDynamicGuardedCidAndLength() const {
   // Assume nothing about this field.
   set_is_unboxing_candidate(false);
@@ -12513,7 +12565,7 @@ const char* PcDescriptors::ToCString() const {
 void PcDescriptors::Verify(const Function& function) const {
 #if defined(DEBUG)
   // Only check ids for unoptimized code that is optimizable.
-  if (!function.IsOptimizable()) {
+  if (!function.IsOptimizable() && !function.IsMidTierOptimizable()) {
     return;
   }
   intptr_t max_deopt_id = 0;
@@ -13029,6 +13081,10 @@ void UnlinkedCall::set_args_descriptor(const Array& value) const {
   StorePointer(&raw_ptr()->args_descriptor_, value.raw());
 }
 
+void UnlinkedCall::set_dispatch_table_offset(const Smi& value) const {
+  StoreSmi(&raw_ptr()->dispatch_table_offset_, value.raw());
+}
+
 const char* UnlinkedCall::ToCString() const {
   return "UnlinkedCall";
 }
@@ -14141,6 +14197,10 @@ void Code::set_is_optimized(bool value) const {
   set_state_bits(OptimizedBit::update(value, raw_ptr()->state_bits_));
 }
 
+void Code::set_is_mid_tier(bool value) const {
+  set_state_bits(MidTierBit::update(value, raw_ptr()->state_bits_));
+}
+
 void Code::set_is_alive(bool value) const {
   set_state_bits(AliveBit::update(value, raw_ptr()->state_bits_));
 }
@@ -21389,6 +21449,20 @@ void RegExp::set_pattern(const String& pattern) const {
   StorePointer(&raw_ptr()->pattern_, pattern.raw());
 }
 
+void RegExp::set_literal(const String& literal,
+                         bool is_prefix,
+                         bool in_line) const {
+  ASSERT(!(is_prefix && in_line));
+  intptr_t value = flags() & ~(kLiteralIsPrefix | kLiteralInLine);
+  if (is_prefix) {
+    value |= kLiteralIsPrefix;
+  } else if (in_line) {
+    value |= kLiteralInLine;
+  }
+  set_flags(value);
+  StorePointer(&raw_ptr()->literal_, literal.raw());
+}
+
 void RegExp::set_function(intptr_t cid,
                           bool sticky,
                           const Function& value) const {
@@ -21432,7 +21506,7 @@ RawRegExp* RegExp::New(Heap::Space space) {
 }
 
 const char* RegExp::Flags() const {
-  switch (flags()) {
+  switch (flags() & (kGlobal | kIgnoreCase | kMultiLine)) {
     case kGlobal | kIgnoreCase | kMultiLine:
     case kIgnoreCase | kMultiLine:
       return "im";
@@ -883,6 +883,15 @@ class Class : public Object {
   // C.DeclarationType() --> C [R, int, R]
   RawType* DeclarationType() const;
 
+  // Returns the type arguments of the supertype [cls] of this class expressed
+  // in terms of the type parameters of this class, or null if [cls] is not a
+  // supertype of this class.
+  // e.g. given
+  // class B<T, S>
+  // class C<R> extends B<R, int>
+  // C.GetInstantiationOf(B) --> [R, int]
+  RawTypeArguments* GetInstantiationOf(const Class& cls) const;
+
   static intptr_t declaration_type_offset() {
     return OFFSET_OF(RawClass, declaration_type_);
   }
@@ -1539,6 +1548,20 @@ class UnlinkedCall : public Object {
   RawArray* args_descriptor() const { return raw_ptr()->args_descriptor_; }
   void set_args_descriptor(const Array& args_descriptor) const;
 
+  // Offset of the selector's row in the AOT dispatch table, see
+  // [StubCode::DispatchTableCall]. Null if the call site does not load its
+  // target from the table.
+  RawSmi* dispatch_table_offset() const {
+    return raw_ptr()->dispatch_table_offset_;
+  }
+  void set_dispatch_table_offset(const Smi& offset) const;
+  static intptr_t args_descriptor_offset() {
+    return OFFSET_OF(RawUnlinkedCall, args_descriptor_);
+  }
+  static intptr_t dispatch_table_offset_offset() {
+    return OFFSET_OF(RawUnlinkedCall, dispatch_table_offset_);
+  }
+
   static intptr_t InstanceSize() {
     return RoundedAllocationSize(sizeof(RawUnlinkedCall));
   }
@@ -2420,7 +2443,12 @@ class Function : public Object {
 
   RawExternalTypedData* KernelData() const;
 
+  // Whether the function can be compiled by the full optimizing pipeline.
+  // Huge functions cannot.
   bool IsOptimizable() const;
+  // Whether the function can be compiled by the cheaper mid-tier optimizing
+  // pipeline, regardless of its size.
+  bool IsMidTierOptimizable() const;
   void SetIsOptimizable(bool value) const;
 
   bool CanBeInlined() const;
@@ -3245,6 +3273,12 @@ class Field : public Object {
   // deoptimization of dependent optimized code.
   void RecordStore(const Object& value) const;
 
+  // Returns the value to store into an instance field by the runtime. Values
+  // stored into fields that might use the mutable-box representation are
+  // copied: compiled code updates such boxes in place, so the field must own
+  // its box instead of sharing the caller's (possibly canonical) one.
+  const Object* CloneForUnboxed(const Object& value) const;
+
   void InitializeGuardedListLengthInObjectOffset() const;
 
   // Return the list of optimized code objects that were optimized under
@@ -4709,6 +4743,11 @@ class Code : public Object {
     return OptimizedBit::decode(raw_ptr()->state_bits_);
   }
   void set_is_optimized(bool value) const;
+  // Whether the code was compiled by the mid-tier optimizing pipeline.
+  bool is_mid_tier() const {
+    return MidTierBit::decode(raw_ptr()->state_bits_);
+  }
+  void set_is_mid_tier(bool value) const;
   bool is_alive() const { return AliveBit::decode(raw_ptr()->state_bits_); }
   void set_is_alive(bool value) const;
 
@@ -5047,12 +5086,14 @@ class Code : public Object {
   enum {
     kOptimizedBit = 0,
     kAliveBit = 1,
-    kPtrOffBit = 2,
-    kPtrOffSize = 30,
+    kMidTierBit = 2,
+    kPtrOffBit = 3,
+    kPtrOffSize = 29,
   };
 
   class OptimizedBit : public BitField<int32_t, bool, kOptimizedBit, 1> {};
   class AliveBit : public BitField<int32_t, bool, kAliveBit, 1> {};
+  class MidTierBit : public BitField<int32_t, bool, kMidTierBit, 1> {};
   class PtrOffBits
       : public BitField<int32_t, intptr_t, kPtrOffBit, kPtrOffSize> {};
 
@@ -5699,7 +5740,8 @@ class Instance : public Object {
 
   void SetField(const Field& field, const Object& value) const {
     field.RecordStore(value);
-    StorePointer(FieldAddr(field), value.raw());
+    const Object* stored_value = field.CloneForUnboxed(value);
+    StorePointer(FieldAddr(field), stored_value->raw());
   }
 
   RawAbstractType* GetType(Heap::Space space) const;
@@ -7306,6 +7348,12 @@ class OneByteString : public AllStatic {
     return reinterpret_cast<RawOneByteString*>(Object::null());
   }
 
+  // The returned pointer is only valid while no safepoint is reached.
+  static uint8_t* DataStart(const String& str) {
+    ASSERT(str.IsOneByteString());
+    return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[0];
+  }
+
  private:
   static RawOneByteString* raw(const String& str) {
     return reinterpret_cast<RawOneByteString*>(str.raw());
@@ -7321,11 +7369,6 @@ class OneByteString : public AllStatic {
     return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[index];
   }
 
-  static uint8_t* DataStart(const String& str) {
-    ASSERT(str.IsOneByteString());
-    return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[0];
-  }
-
   static RawOneByteString* ReadFrom(SnapshotReader* reader,
                                     intptr_t object_id,
                                     intptr_t tags,
@@ -7429,6 +7472,13 @@ class TwoByteString : public AllStatic {
 
   static const ClassId kClassId = kTwoByteStringCid;
 
+  // Use this instead of CharAddr(0).  It will not assert that the index is <
+  // length. The returned pointer is only valid while no safepoint is reached.
+  static uint16_t* DataStart(const String& str) {
+    ASSERT(str.IsTwoByteString());
+    return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[0];
+  }
+
  private:
   static RawTwoByteString* raw(const String& str) {
     return reinterpret_cast<RawTwoByteString*>(str.raw());
@@ -7444,13 +7494,6 @@ class TwoByteString : public AllStatic {
     return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[index];
   }
 
-  // Use this instead of CharAddr(0).  It will not assert that the index is <
-  // length.
-  static uint16_t* DataStart(const String& str) {
-    ASSERT(str.IsTwoByteString());
-    return &str.UnsafeMutableNonPointer(raw_ptr(str)->data())[0];
-  }
-
   static RawTwoByteString* ReadFrom(SnapshotReader* reader,
                                     intptr_t object_id,
                                     intptr_t tags,
@@ -8658,13 +8701,13 @@ class LinkedHashMap : public Instance {
     const intptr_t length_;
   };
 
- private:
-  FINAL_HEAP_OBJECT_IMPLEMENTATION(LinkedHashMap, Instance);
-
   // Keep this in sync with Dart implementation (lib/compact_hash.dart).
   static const intptr_t kInitialIndexBits = 3;
   static const intptr_t kInitialIndexSize = 1 << (kInitialIndexBits + 1);
 
+ private:
+  FINAL_HEAP_OBJECT_IMPLEMENTATION(LinkedHashMap, Instance);
+
   // Allocate a map, but leave all fields set to null.
   // Used during deserialization (since map might contain itself as key/value).
   static RawLinkedHashMap* NewUninitialized(Heap::Space space = Heap::kNew);
@@ -8858,18 +8901,25 @@ class RegExp : public Instance {
 
   // Flags are passed to a regex object as follows:
   // 'i': ignore case, 'g': do global matches, 'm': pattern is multi line.
+  // kLinear is not user visible and marks regexps which are matched by the
+  // linear time engine, see LinearRegExp. kLiteralIsPrefix and
+  // kLiteralInLine are not user visible either and tell where matches start
+  // relative to literal(), see RegExpEngine::RequiredLiteral.
   enum Flags {
     kNone = 0,
     kGlobal = 1,
     kIgnoreCase = 2,
     kMultiLine = 4,
+    kLinear = 8,
+    kLiteralIsPrefix = 16,
+    kLiteralInLine = 32,
   };
 
   enum {
     kTypePos = 0,
     kTypeSize = 2,
     kFlagsPos = 2,
-    kFlagsSize = 4,
+    kFlagsSize = 6,
   };
 
   class TypeBits : public BitField<int8_t, RegExType, kTypePos, kTypeSize> {};
@@ -8882,10 +8932,16 @@ class RegExp : public Instance {
   bool is_global() const { return (flags() & kGlobal); }
   bool is_ignore_case() const { return (flags() & kIgnoreCase); }
   bool is_multi_line() const { return (flags() & kMultiLine); }
+  bool is_linear() const { return (flags() & kLinear); }
+  // Every match starts with literal().
+  bool literal_is_prefix() const { return (flags() & kLiteralIsPrefix); }
+  // Every match starts on the line literal() occurs on.
+  bool literal_in_line() const { return (flags() & kLiteralInLine); }
 
   intptr_t num_registers() const { return raw_ptr()->num_registers_; }
 
   RawString* pattern() const { return raw_ptr()->pattern_; }
+  RawString* literal() const { return raw_ptr()->literal_; }
   RawSmi* num_bracket_expressions() const {
     return raw_ptr()->num_bracket_expressions_;
   }
@@ -8939,6 +8995,7 @@ class RegExp : public Instance {
   }
 
   void set_pattern(const String& pattern) const;
+  void set_literal(const String& literal, bool is_prefix, bool in_line) const;
   void set_function(intptr_t cid, bool sticky, const Function& value) const;
   void set_bytecode(bool is_one_byte,
                     bool sticky,
@@ -8948,6 +9005,7 @@ class RegExp : public Instance {
   void set_is_global() const { set_flags(flags() | kGlobal); }
   void set_is_ignore_case() const { set_flags(flags() | kIgnoreCase); }
   void set_is_multi_line() const { set_flags(flags() | kMultiLine); }
+  void set_is_linear() const { set_flags(flags() | kLinear); }
   void set_is_simple() const { set_type(kSimple); }
   void set_is_complex() const { set_type(kComplex); }
   void set_num_registers(intptr_t value) const {
@@ -1481,7 +1481,7 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !is_ignore_case());
   jsobj.AddProperty("isMultiLine", is_multi_line());
 
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp && !is_linear()) {
     Function& func = Function::Handle();
     func = function(kOneByteStringCid, /*sticky=*/false);
     jsobj.AddProperty("_oneByteFunction", func);
@@ -127,6 +127,7 @@ class ObjectPointerVisitor;
   RW(Array, library_load_error_table)                                          \
   RW(Array, unique_dynamic_targets)                                            \
   RW(GrowableObjectArray, megamorphic_cache_table)                             \
+  RW(Array, dispatch_table)                                                    \
   RW(Code, build_method_extractor_code)                                        \
   RW(Code, null_error_stub_with_fpu_regs_stub)                                 \
   RW(Code, null_error_stub_without_fpu_regs_stub)                              \
@@ -137,6 +138,7 @@ class ObjectPointerVisitor;
   R_(Code, megamorphic_miss_code)                                              \
   R_(Function, megamorphic_miss_function)                                      \
   RW(Array, code_order_table)                                                  \
+  RW(GrowableObjectArray, precompiler_type_feedback)                           \
   RW(Array, obfuscation_map)                                                   \
   RW(GrowableObjectArray, changed_in_last_reload)                              \
   RW(Class, ffi_pointer_class)                                                 \
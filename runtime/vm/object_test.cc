@@ -2919,6 +2919,45 @@ ISOLATE_UNIT_TEST_CASE(FieldTests) {
                String::Handle(Field::NameFromSetter(setter_f)).ToCString());
 }
 
+TEST_CASE(Instance_SetFieldCopiesUnboxedValues) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  double x = 0.0;\n"
+      "  final double y = 0.0;\n"
+      "}\n";
+  TestCase::LoadTestScript(kScriptChars, NULL);
+  TransitionNativeToVM transition(thread);
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  const String& name = String::Handle(String::New(TestCase::url()));
+  const Library& lib = Library::Handle(Library::LookupLibrary(thread, name));
+  EXPECT(!lib.IsNull());
+  const Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(cls.EnsureIsFinalized(thread) == Error::null());
+  const Field& x = Field::Handle(
+      cls.LookupInstanceFieldAllowPrivate(String::Handle(String::New("x"))));
+  const Field& y = Field::Handle(
+      cls.LookupInstanceFieldAllowPrivate(String::Handle(String::New("y"))));
+  x.set_is_unboxing_candidate(true);
+  y.set_is_unboxing_candidate(true);
+
+  // Compiled code might update the box of x in place, so x must not share
+  // the stored (here canonical) double.
+  const Instance& a = Instance::Handle(Instance::New(cls));
+  const Double& value = Double::Handle(Double::NewCanonical(1.5));
+  a.SetField(x, value);
+  const Double& stored = Double::Handle(Double::RawCast(a.GetField(x)));
+  EXPECT(stored.raw() != value.raw());
+  EXPECT(!stored.IsCanonical());
+  EXPECT_EQ(1.5, stored.value());
+
+  // Final fields are never unboxed and other values are never copied.
+  a.SetField(y, value);
+  EXPECT_EQ(value.raw(), a.GetField(y));
+  a.SetField(x, Object::null_object());
+  EXPECT_EQ(Object::null(), a.GetField(x));
+}
+
 // Expose helper function from object.cc for testing.
 bool EqualsIgnoringPrivate(const String& name, const String& private_name);
 
@@ -1694,7 +1694,8 @@ class RawUnlinkedCall : public RawObject {
   VISIT_FROM(RawObject*, target_name_);
   RawString* target_name_;
   RawArray* args_descriptor_;
-  VISIT_TO(RawObject*, args_descriptor_);
+  RawSmi* dispatch_table_offset_;  // Null if not dispatched through the table.
+  VISIT_TO(RawObject*, dispatch_table_offset_);
   RawObject** to_snapshot(Snapshot::Kind kind) { return to(); }
 };
 
@@ -2328,14 +2329,18 @@ class RawRegExp : public RawInstance {
   } two_byte_sticky_;
   RawFunction* external_one_byte_sticky_function_;
   RawFunction* external_two_byte_sticky_function_;
-  VISIT_TO(RawObject*, external_two_byte_sticky_function_)
+  // A literal every match contains, the empty string if there is none, or
+  // null if it has not been looked for yet.
+  RawString* literal_;
+  VISIT_TO(RawObject*, literal_)
   RawObject** to_snapshot(Snapshot::Kind kind) { return to(); }
 
   intptr_t num_registers_;
 
   // A bitfield with two fields:
   // type: Uninitialized, simple or complex.
-  // flags: Represents global/local, case insensitive, multiline.
+  // flags: Represents global/local, case insensitive, multiline, and how
+  // matches relate to literal_.
   int8_t type_flags_;
 };
 
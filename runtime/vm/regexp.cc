@@ -9,6 +9,8 @@
 #include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
 #include "vm/regexp_ast.h"
+#include "vm/regexp_linear.h"
+#include "vm/regexp_parser.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
 #include "vm/unibrow-inl.h"
@@ -4913,6 +4915,11 @@ RawRegExp* RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
+  // Regexps matched in linear time need no specialized functions.
+  if (LinearRegExp::Prepare(regexp, zone)) {
+    return regexp.raw();
+  }
+
   if (!FLAG_interpret_irregexp) {
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
@@ -4930,4 +4937,164 @@ RawRegExp* RegExpEngine::CreateRegExp(Thread* thread,
   return regexp.raw();
 }
 
+static bool IsLineTerminator(intptr_t c) {
+  return (c == '\n') || (c == '\r') || (c == 0x2028) || (c == 0x2029);
+}
+
+// Whether the tree may consume a line terminator. Conservative for
+// lookarounds and backreferences.
+static bool CanMatchLineTerminator(RegExpTree* tree) {
+  if (tree->IsAtom()) {
+    ZoneGrowableArray<uint16_t>* data = tree->AsAtom()->data();
+    for (intptr_t i = 0; i < data->length(); i++) {
+      if (IsLineTerminator(data->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsCharacterClass()) {
+    static const uint16_t kLineTerminators[] = {'\n', '\r', 0x2028, 0x2029};
+    RegExpCharacterClass* char_class = tree->AsCharacterClass();
+    ZoneGrowableArray<CharacterRange>* ranges = char_class->ranges();
+    for (intptr_t i = 0; i < ARRAY_SIZE(kLineTerminators); i++) {
+      bool contained = false;
+      for (intptr_t j = 0; j < ranges->length(); j++) {
+        contained = contained || ranges->At(j).Contains(kLineTerminators[i]);
+      }
+      if (contained != char_class->is_negated()) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      if (CanMatchLineTerminator(elements->At(i).tree())) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (CanMatchLineTerminator(nodes->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    for (intptr_t i = 0; i < alternatives->length(); i++) {
+      if (CanMatchLineTerminator(alternatives->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsQuantifier()) {
+    return CanMatchLineTerminator(tree->AsQuantifier()->body());
+  }
+  if (tree->IsCapture()) {
+    return CanMatchLineTerminator(tree->AsCapture()->body());
+  }
+  return !tree->IsAssertion() && !tree->IsEmpty();
+}
+
+// Appends the subtrees which the tree matches one after the other. Atoms of
+// texts are appended individually.
+static void FlattenSequence(RegExpTree* tree,
+                            GrowableArray<RegExpTree*>* sequence) {
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      FlattenSequence(nodes->At(i), sequence);
+    }
+  } else if (tree->IsCapture()) {
+    FlattenSequence(tree->AsCapture()->body(), sequence);
+  } else if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      sequence->Add(elements->At(i).tree());
+    }
+  } else if (!tree->IsEmpty()) {
+    sequence->Add(tree);
+  }
+}
+
+RawString* RegExpEngine::RequiredLiteral(const RegExp& regexp, Zone* zone) {
+  String& literal = String::Handle(zone, regexp.literal());
+  if (!literal.IsNull()) {
+    return literal.raw();
+  }
+  literal = Symbols::Empty().raw();
+  bool is_prefix = false;
+  bool in_line = false;
+
+  // Case-insensitive literals would need a case-folding search.
+  if (!regexp.is_ignore_case()) {
+    const String& pattern = String::Handle(zone, regexp.pattern());
+    RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+    // Parsing failures are handled in the RegExp factory constructor.
+    RegExpParser::ParseRegExp(pattern, regexp.is_multi_line(), compile_data);
+    GrowableArray<RegExpTree*> sequence(zone, 8);
+    FlattenSequence(compile_data->tree, &sequence);
+
+    // Consecutive atoms form a run, which zero-width assertions do not
+    // interrupt. A run at the start is preferred, as matches can then only
+    // start where it occurs. Otherwise the longest run is used.
+    GrowableArray<uint16_t> run(zone, 16);
+    GrowableArray<uint16_t> best(zone, 16);
+    intptr_t run_start = 0;
+    intptr_t best_start = -1;
+    bool at_start = true;
+    for (intptr_t i = 0; i <= sequence.length(); i++) {
+      RegExpTree* node = (i < sequence.length()) ? sequence[i] : NULL;
+      if ((node != NULL) && node->IsAtom()) {
+        if (run.is_empty()) {
+          run_start = i;
+        }
+        ZoneGrowableArray<uint16_t>* data = node->AsAtom()->data();
+        for (intptr_t j = 0; j < data->length(); j++) {
+          run.Add(data->At(j));
+        }
+        continue;
+      }
+      if ((node != NULL) && node->IsAssertion()) {
+        continue;
+      }
+      if (!run.is_empty() && (at_start || (run.length() > best.length()))) {
+        best.Clear();
+        for (intptr_t j = 0; j < run.length(); j++) {
+          best.Add(run[j]);
+        }
+        best_start = run_start;
+        if (at_start) {
+          break;
+        }
+      }
+      at_start = false;
+      run.Clear();
+    }
+
+    if (best_start >= 0) {
+      literal = String::FromUTF16(best.data(), best.length(), Heap::kOld);
+      is_prefix = true;
+      in_line = true;
+      for (intptr_t i = 0; i < best_start; i++) {
+        is_prefix = is_prefix && sequence[i]->IsAssertion();
+        in_line = in_line && !CanMatchLineTerminator(sequence[i]);
+      }
+      in_line = in_line && !is_prefix;
+    }
+  }
+
+  regexp.set_literal(literal, is_prefix, in_line);
+  return literal.raw();
+}
+
 }  // namespace dart
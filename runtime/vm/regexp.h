@@ -1382,6 +1382,11 @@ class RegExpEngine : public AllStatic {
                                  bool multi_line,
                                  bool ignore_case);
 
+  // Returns a literal which every match of the regexp contains, or the empty
+  // string if there is none. It is looked for once and cached on the regexp,
+  // together with whether matches start with it or on its line.
+  static RawString* RequiredLiteral(const RegExp& regexp, Zone* zone);
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
@@ -0,0 +1,722 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp_linear.h"
+
+#include "vm/flags.h"
+#include "vm/regexp.h"
+#include "vm/regexp_ast.h"
+#include "vm/regexp_parser.h"
+#include "vm/unicode.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            linear_regexp,
+            true,
+            "Match regexps prone to exponential backtracking in linear time.");
+DEFINE_FLAG(bool,
+            force_linear_regexp,
+            false,
+            "Match all regexps without backreferences or lookarounds in "
+            "linear time.");
+
+// Each instruction is an opcode followed by two operands. The ranges of
+// character classes follow the instructions as pairs of inclusive bounds.
+enum LinearOpcode {
+  kLinearChar,    // Consumes the code unit a.
+  kLinearClass,   // Consumes a code unit in the b ranges starting at word a.
+  kLinearSplit,   // Continues at a and, with lower priority, at b.
+  kLinearJump,    // Continues at a.
+  kLinearSave,    // Stores the position in capture register a.
+  kLinearClear,   // Resets capture registers a to b.
+  kLinearAssert,  // Continues if the RegExpAssertion::AssertionType a holds.
+  kLinearMatch,
+};
+
+static const intptr_t kInstructionSize = 3;
+
+// Larger programs, e.g. from nested counted repetitions, are left to the
+// backtracking engines.
+static const intptr_t kMaxInstructions = 1 << 14;
+
+class LinearCompiler : public ValueObject {
+ public:
+  LinearCompiler(bool ignore_case, Zone* zone)
+      : ignore_case_(ignore_case),
+        zone_(zone),
+        code_(zone, 64),
+        ranges_(zone, 16) {}
+
+  // Returns null if the program would be too large.
+  RawTypedData* Compile(RegExpTree* tree) {
+    Emit(kLinearSave, RegExpCapture::StartRegister(0));
+    if (!Visit(tree)) {
+      return TypedData::null();
+    }
+    Emit(kLinearSave, RegExpCapture::EndRegister(0));
+    Emit(kLinearMatch);
+
+    const intptr_t code_length = code_.length();
+    for (intptr_t i = 0; i < code_length; i += kInstructionSize) {
+      if (code_[i] == kLinearClass) {
+        code_[i + 1] += code_length;
+      }
+    }
+    const intptr_t length = code_length + ranges_.length();
+    const TypedData& program = TypedData::Handle(
+        zone_, TypedData::New(kTypedDataInt32ArrayCid, length, Heap::kOld));
+    NoSafepointScope no_safepoint;
+    int32_t* data = reinterpret_cast<int32_t*>(program.DataAddr(0));
+    for (intptr_t i = 0; i < code_length; i++) {
+      data[i] = code_[i];
+    }
+    for (intptr_t i = 0; i < ranges_.length(); i++) {
+      data[code_length + i] = ranges_[i];
+    }
+    return program.raw();
+  }
+
+ private:
+  intptr_t next_pc() const { return code_.length() / kInstructionSize; }
+
+  intptr_t Emit(LinearOpcode opcode, intptr_t a = 0, intptr_t b = 0) {
+    const intptr_t pc = next_pc();
+    code_.Add(opcode);
+    code_.Add(a);
+    code_.Add(b);
+    return pc;
+  }
+
+  void Patch(intptr_t pc, intptr_t operand, intptr_t value) {
+    code_[pc * kInstructionSize + 1 + operand] = value;
+  }
+
+  bool Visit(RegExpTree* tree) {
+    if (next_pc() > kMaxInstructions) {
+      return false;
+    }
+    if (tree->IsDisjunction()) {
+      ZoneGrowableArray<RegExpTree*>* alternatives =
+          tree->AsDisjunction()->alternatives();
+      GrowableArray<intptr_t> jumps(zone_, alternatives->length());
+      const intptr_t last = alternatives->length() - 1;
+      for (intptr_t i = 0; i < last; i++) {
+        const intptr_t split = Emit(kLinearSplit, next_pc() + 1);
+        if (!Visit(alternatives->At(i))) {
+          return false;
+        }
+        jumps.Add(Emit(kLinearJump));
+        Patch(split, 1, next_pc());
+      }
+      if (!Visit(alternatives->At(last))) {
+        return false;
+      }
+      for (intptr_t i = 0; i < jumps.length(); i++) {
+        Patch(jumps[i], 0, next_pc());
+      }
+      return true;
+    }
+    if (tree->IsAlternative()) {
+      ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+      for (intptr_t i = 0; i < nodes->length(); i++) {
+        if (!Visit(nodes->At(i))) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if (tree->IsAssertion()) {
+      Emit(kLinearAssert, tree->AsAssertion()->assertion_type());
+      return true;
+    }
+    if (tree->IsAtom()) {
+      EmitAtom(tree->AsAtom());
+      return true;
+    }
+    if (tree->IsCharacterClass()) {
+      EmitClass(tree->AsCharacterClass());
+      return true;
+    }
+    if (tree->IsText()) {
+      GrowableArray<TextElement>* elements = tree->AsText()->elements();
+      for (intptr_t i = 0; i < elements->length(); i++) {
+        const TextElement& element = elements->At(i);
+        if (element.text_type() == TextElement::ATOM) {
+          EmitAtom(element.atom());
+        } else {
+          EmitClass(element.char_class());
+        }
+      }
+      return true;
+    }
+    if (tree->IsCapture()) {
+      RegExpCapture* capture = tree->AsCapture();
+      Emit(kLinearSave, RegExpCapture::StartRegister(capture->index()));
+      if (!Visit(capture->body())) {
+        return false;
+      }
+      Emit(kLinearSave, RegExpCapture::EndRegister(capture->index()));
+      return true;
+    }
+    if (tree->IsQuantifier()) {
+      return VisitQuantifier(tree->AsQuantifier());
+    }
+    ASSERT(tree->IsEmpty());
+    return true;
+  }
+
+  // Unrolls the required iterations and chains the optional ones.
+  bool VisitQuantifier(RegExpQuantifier* quantifier) {
+    RegExpTree* body = quantifier->body();
+    const Interval captures = body->CaptureRegisters();
+    // The preferred branch of each split enters the body when greedy.
+    const intptr_t enter = quantifier->is_non_greedy() ? 1 : 0;
+    const intptr_t leave = 1 - enter;
+    for (intptr_t i = 0; i < quantifier->min(); i++) {
+      if (!VisitIteration(body, captures)) {
+        return false;
+      }
+    }
+    if (quantifier->max() == RegExpTree::kInfinity) {
+      // Coming back to the split at the same position means the iteration
+      // was empty. Such threads are dropped, as ECMAScript requires.
+      const intptr_t loop = Emit(kLinearSplit);
+      Patch(loop, enter, next_pc());
+      if (!VisitIteration(body, captures)) {
+        return false;
+      }
+      Emit(kLinearJump, loop);
+      Patch(loop, leave, next_pc());
+      return true;
+    }
+    GrowableArray<intptr_t> splits(zone_, 4);
+    for (intptr_t i = quantifier->min(); i < quantifier->max(); i++) {
+      const intptr_t split = Emit(kLinearSplit);
+      Patch(split, enter, next_pc());
+      splits.Add(split);
+      if (!VisitIteration(body, captures)) {
+        return false;
+      }
+    }
+    for (intptr_t i = 0; i < splits.length(); i++) {
+      Patch(splits[i], leave, next_pc());
+    }
+    return true;
+  }
+
+  // Captures inside a quantifier are reset on each iteration.
+  bool VisitIteration(RegExpTree* body, const Interval& captures) {
+    if (!captures.is_empty()) {
+      Emit(kLinearClear, captures.from(), captures.to());
+    }
+    return Visit(body);
+  }
+
+  void EmitAtom(RegExpAtom* atom) {
+    ZoneGrowableArray<uint16_t>* data = atom->data();
+    for (intptr_t i = 0; i < data->length(); i++) {
+      const uint16_t c = data->At(i);
+      if (!ignore_case_) {
+        Emit(kLinearChar, c);
+        continue;
+      }
+      ZoneGrowableArray<CharacterRange>* ranges =
+          new (zone_) ZoneGrowableArray<CharacterRange>(2);
+      CharacterRange range = CharacterRange::Singleton(c);
+      ranges->Add(range);
+      range.AddCaseEquivalents(ranges, /*is_one_byte=*/false, zone_);
+      CharacterRange::Canonicalize(ranges);
+      EmitRanges(ranges);
+    }
+  }
+
+  void EmitClass(RegExpCharacterClass* char_class) {
+    ZoneGrowableArray<CharacterRange>* ranges = char_class->ranges();
+    ZoneGrowableArray<CharacterRange>* set =
+        new (zone_) ZoneGrowableArray<CharacterRange>(ranges->length());
+    for (intptr_t i = 0; i < ranges->length(); i++) {
+      set->Add(ranges->At(i));
+    }
+    // Standard classes are closed under case equivalence.
+    if (ignore_case_ && !char_class->is_standard()) {
+      for (intptr_t i = 0; i < ranges->length(); i++) {
+        CharacterRange range = ranges->At(i);
+        range.AddCaseEquivalents(set, /*is_one_byte=*/false, zone_);
+      }
+    }
+    CharacterRange::Canonicalize(set);
+    if (char_class->is_negated()) {
+      ZoneGrowableArray<CharacterRange>* negated =
+          new (zone_) ZoneGrowableArray<CharacterRange>(set->length() + 1);
+      intptr_t from = 0;
+      for (intptr_t i = 0; i < set->length(); i++) {
+        if (set->At(i).from() > from) {
+          negated->Add(CharacterRange(from, set->At(i).from() - 1));
+        }
+        from = set->At(i).to() + 1;
+      }
+      if (from <= Utf16::kMaxCodeUnit) {
+        negated->Add(CharacterRange(from, Utf16::kMaxCodeUnit));
+      }
+      set = negated;
+    }
+    EmitRanges(set);
+  }
+
+  void EmitRanges(ZoneGrowableArray<CharacterRange>* ranges) {
+    if (ranges->length() == 1 && ranges->At(0).IsSingleton()) {
+      Emit(kLinearChar, ranges->At(0).from());
+      return;
+    }
+    Emit(kLinearClass, ranges_.length(), ranges->length());
+    for (intptr_t i = 0; i < ranges->length(); i++) {
+      ranges_.Add(ranges->At(i).from());
+      ranges_.Add(ranges->At(i).to());
+    }
+  }
+
+  const bool ignore_case_;
+  Zone* zone_;
+  GrowableArray<int32_t> code_;
+  GrowableArray<int32_t> ranges_;
+};
+
+// Runs a program over the subject, advancing all threads one code unit at a
+// time. Threads are kept in priority order, and a thread reaching an
+// instruction another thread already reached at the same position is dropped
+// as its continuation can only yield a lower priority match.
+//
+// Capture registers are shared between threads and copied on write. Each set
+// is prefixed by its reference count.
+class LinearMatcher : public ValueObject {
+ public:
+  LinearMatcher(const TypedData& program,
+                const String& subject,
+                intptr_t register_count,
+                Zone* zone)
+      : program_(reinterpret_cast<const int32_t*>(program.DataAddr(0))),
+        subject_(subject),
+        length_(subject.Length()),
+        register_count_(register_count),
+        zone_(zone),
+        stack_(zone, 16),
+        free_(zone, 16) {
+    // The number of instructions is bounded by the program length.
+    const intptr_t capacity = program.Length() / kInstructionSize;
+    marks_ = zone->Alloc<intptr_t>(capacity);
+    for (intptr_t i = 0; i < capacity; i++) {
+      marks_[i] = -1;
+    }
+    current_.Initialize(capacity, zone);
+    next_.Initialize(capacity, zone);
+  }
+
+  bool Match(intptr_t start, bool sticky, int32_t* output) {
+    ThreadList* current = &current_;
+    ThreadList* next = &next_;
+    int32_t* matched = NULL;
+    for (intptr_t pos = start;; pos++) {
+      // A thread starting here has the lowest priority.
+      if (matched == NULL && (!sticky || pos == start)) {
+        int32_t* registers = NewRegisters();
+        for (intptr_t i = 1; i <= register_count_; i++) {
+          registers[i] = -1;
+        }
+        AddThread(current, 0, pos, registers);
+      }
+      const int32_t c = (pos < length_) ? subject_.CharAt(pos) : -1;
+      for (intptr_t i = 0; i < current->length; i++) {
+        const intptr_t pc = current->pcs[i];
+        int32_t* registers = current->registers[i];
+        const int32_t* instruction = &program_[pc * kInstructionSize];
+        switch (instruction[0]) {
+          case kLinearChar:
+            if (c == instruction[1]) {
+              AddThread(next, pc + 1, pos + 1, registers);
+              continue;
+            }
+            break;
+          case kLinearClass:
+            if (c >= 0 && InClass(instruction[1], instruction[2], c)) {
+              AddThread(next, pc + 1, pos + 1, registers);
+              continue;
+            }
+            break;
+          case kLinearMatch:
+            if (matched != NULL) {
+              Release(matched);
+            }
+            matched = registers;
+            // Threads of lower priority cannot produce a better match.
+            for (intptr_t j = i + 1; j < current->length; j++) {
+              Release(current->registers[j]);
+            }
+            current->length = i + 1;
+            continue;
+          default:
+            UNREACHABLE();
+        }
+        Release(registers);
+      }
+      current->length = 0;
+      ThreadList* swap = current;
+      current = next;
+      next = swap;
+      if ((pos >= length_) ||
+          ((current->length == 0) && ((matched != NULL) || sticky))) {
+        break;
+      }
+    }
+    if (matched == NULL) {
+      return false;
+    }
+    for (intptr_t i = 0; i < register_count_; i++) {
+      output[i] = matched[i + 1];
+    }
+    return true;
+  }
+
+ private:
+  struct ThreadList {
+    void Initialize(intptr_t capacity, Zone* zone) {
+      pcs = zone->Alloc<intptr_t>(capacity);
+      registers = zone->Alloc<int32_t*>(capacity);
+      length = 0;
+    }
+
+    intptr_t* pcs;
+    int32_t** registers;
+    intptr_t length;
+  };
+
+  struct Frame {
+    Frame() : pc(0), registers(NULL) {}
+    Frame(intptr_t pc, int32_t* registers) : pc(pc), registers(registers) {}
+
+    intptr_t pc;
+    int32_t* registers;
+  };
+
+  // Follows all instructions which do not consume input from pc, in
+  // priority order, and adds the threads waiting for input to the list.
+  void AddThread(ThreadList* list,
+                 intptr_t pc,
+                 intptr_t pos,
+                 int32_t* registers) {
+    stack_.Add(Frame(pc, registers));
+    while (!stack_.is_empty()) {
+      const Frame frame = stack_.RemoveLast();
+      pc = frame.pc;
+      registers = frame.registers;
+      while (true) {
+        if (marks_[pc] == pos) {
+          Release(registers);
+          break;
+        }
+        marks_[pc] = pos;
+        const int32_t* instruction = &program_[pc * kInstructionSize];
+        const int32_t opcode = instruction[0];
+        if (opcode == kLinearJump) {
+          pc = instruction[1];
+        } else if (opcode == kLinearSplit) {
+          registers[0]++;
+          stack_.Add(Frame(instruction[2], registers));
+          pc = instruction[1];
+        } else if (opcode == kLinearSave) {
+          registers = SetRegisters(registers, instruction[1], instruction[1],
+                                   pos);
+          pc++;
+        } else if (opcode == kLinearClear) {
+          registers = SetRegisters(registers, instruction[1], instruction[2],
+                                   -1);
+          pc++;
+        } else if (opcode == kLinearAssert) {
+          if (!Holds(instruction[1], pos)) {
+            Release(registers);
+            break;
+          }
+          pc++;
+        } else {
+          list->pcs[list->length] = pc;
+          list->registers[list->length] = registers;
+          list->length++;
+          break;
+        }
+      }
+    }
+  }
+
+  int32_t* NewRegisters() {
+    int32_t* registers = free_.is_empty()
+                             ? zone_->Alloc<int32_t>(register_count_ + 1)
+                             : free_.RemoveLast();
+    registers[0] = 1;
+    return registers;
+  }
+
+  void Release(int32_t* registers) {
+    if (--registers[0] == 0) {
+      free_.Add(registers);
+    }
+  }
+
+  int32_t* SetRegisters(int32_t* registers,
+                        intptr_t from,
+                        intptr_t to,
+                        int32_t value) {
+    bool changed = false;
+    for (intptr_t i = from; i <= to; i++) {
+      changed = changed || (registers[i + 1] != value);
+    }
+    if (!changed) {
+      return registers;
+    }
+    if (registers[0] > 1) {
+      int32_t* copy = NewRegisters();
+      for (intptr_t i = 1; i <= register_count_; i++) {
+        copy[i] = registers[i];
+      }
+      registers[0]--;
+      registers = copy;
+    }
+    for (intptr_t i = from; i <= to; i++) {
+      registers[i + 1] = value;
+    }
+    return registers;
+  }
+
+  bool InClass(intptr_t offset, intptr_t count, int32_t c) const {
+    const int32_t* ranges = &program_[offset];
+    intptr_t low = 0;
+    intptr_t high = count - 1;
+    while (low <= high) {
+      const intptr_t middle = (low + high) / 2;
+      if (c < ranges[2 * middle]) {
+        high = middle - 1;
+      } else if (c > ranges[2 * middle + 1]) {
+        low = middle + 1;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool IsLineTerminator(uint16_t c) {
+    return (c == '\n') || (c == '\r') || (c == 0x2028) || (c == 0x2029);
+  }
+
+  static bool IsWordCharacter(uint16_t c) {
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+           ((c >= '0') && (c <= '9')) || (c == '_');
+  }
+
+  bool Holds(intptr_t assertion, intptr_t pos) const {
+    switch (assertion) {
+      case RegExpAssertion::START_OF_INPUT:
+        return pos == 0;
+      case RegExpAssertion::START_OF_LINE:
+        return (pos == 0) || IsLineTerminator(subject_.CharAt(pos - 1));
+      case RegExpAssertion::END_OF_INPUT:
+        return pos == length_;
+      case RegExpAssertion::END_OF_LINE:
+        return (pos == length_) || IsLineTerminator(subject_.CharAt(pos));
+      case RegExpAssertion::BOUNDARY:
+      case RegExpAssertion::NON_BOUNDARY: {
+        const bool before =
+            (pos > 0) && IsWordCharacter(subject_.CharAt(pos - 1));
+        const bool after =
+            (pos < length_) && IsWordCharacter(subject_.CharAt(pos));
+        return (before != after) == (assertion == RegExpAssertion::BOUNDARY);
+      }
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  const int32_t* program_;
+  const String& subject_;
+  const intptr_t length_;
+  const intptr_t register_count_;
+  Zone* zone_;
+  intptr_t* marks_;
+  ThreadList current_;
+  ThreadList next_;
+  GrowableArray<Frame> stack_;
+  GrowableArray<int32_t*> free_;
+};
+
+static RegExpCompileData* ParseRegExp(const RegExp& regexp, Zone* zone) {
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+  // Parsing failures are handled in the RegExp factory constructor.
+  RegExpParser::ParseRegExp(pattern, regexp.is_multi_line(), compile_data);
+  return compile_data;
+}
+
+bool LinearRegExp::Prepare(const RegExp& regexp, Zone* zone) {
+  if (!FLAG_linear_regexp && !FLAG_force_linear_regexp) {
+    return false;
+  }
+  RegExpCompileData* compile_data = ParseRegExp(regexp, zone);
+  if (!CanMatch(compile_data->tree)) {
+    return false;
+  }
+  if (!FLAG_force_linear_regexp && !IsBacktrackingProne(compile_data->tree)) {
+    return false;
+  }
+  LinearCompiler compiler(regexp.is_ignore_case(), zone);
+  const TypedData& program =
+      TypedData::Handle(zone, compiler.Compile(compile_data->tree));
+  if (program.IsNull()) {
+    return false;
+  }
+  regexp.set_num_bracket_expressions(compile_data->capture_count);
+  regexp.set_bytecode(/*is_one_byte=*/true, /*sticky=*/false, program);
+  regexp.set_is_linear();
+  return true;
+}
+
+bool LinearRegExp::CanMatch(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    for (intptr_t i = 0; i < alternatives->length(); i++) {
+      if (!CanMatch(alternatives->At(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!CanMatch(nodes->At(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return CanMatch(tree->AsCapture()->body());
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    RegExpTree* body = quantifier->body();
+    if (quantifier->is_possessive()) {
+      return false;
+    }
+    // An optional iteration which matches the empty string must fail and
+    // leave its captures unset. The unrolled iterations of a bounded
+    // quantifier cannot detect that.
+    if ((quantifier->max() != RegExpTree::kInfinity) &&
+        (quantifier->max() > quantifier->min()) && (body->min_match() == 0) &&
+        !body->CaptureRegisters().is_empty()) {
+      return false;
+    }
+    return CanMatch(body);
+  }
+  return !tree->IsLookahead() && !tree->IsBackReference();
+}
+
+// Whether the tree can match in more than one way.
+static bool HasChoice(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (HasChoice(nodes->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsCapture()) {
+    return HasChoice(tree->AsCapture()->body());
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    return (quantifier->max() > quantifier->min()) ||
+           HasChoice(quantifier->body());
+  }
+  return false;
+}
+
+bool LinearRegExp::IsBacktrackingProne(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    for (intptr_t i = 0; i < alternatives->length(); i++) {
+      if (IsBacktrackingProne(alternatives->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (IsBacktrackingProne(nodes->At(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (tree->IsCapture()) {
+    return IsBacktrackingProne(tree->AsCapture()->body());
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if ((quantifier->max() == RegExpTree::kInfinity) &&
+        HasChoice(quantifier->body())) {
+      return true;
+    }
+    return IsBacktrackingProne(quantifier->body());
+  }
+  return false;
+}
+
+RawInstance* LinearRegExp::Execute(const RegExp& regexp,
+                                   const String& subject,
+                                   const Smi& start_index,
+                                   bool sticky,
+                                   Zone* zone) {
+  ASSERT(regexp.is_linear());
+  TypedData& program = TypedData::Handle(
+      zone, regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false));
+  if (program.IsNull()) {
+    // The program is not kept when the regexp is sent in a message.
+    RegExpCompileData* compile_data = ParseRegExp(regexp, zone);
+    LinearCompiler compiler(regexp.is_ignore_case(), zone);
+    program = compiler.Compile(compile_data->tree);
+    ASSERT(!program.IsNull());
+    regexp.set_bytecode(/*is_one_byte=*/true, /*sticky=*/false, program);
+  }
+
+  const intptr_t register_count =
+      (Smi::Value(regexp.num_bracket_expressions()) + 1) * 2;
+  int32_t* registers = zone->Alloc<int32_t>(register_count);
+  bool matched;
+  {
+    NoSafepointScope no_safepoint;
+    LinearMatcher matcher(program, subject, register_count, zone);
+    matched = matcher.Match(start_index.Value(), sticky, registers);
+  }
+  if (!matched) {
+    return Instance::null();
+  }
+
+  const TypedData& result = TypedData::Handle(
+      zone, TypedData::New(kTypedDataInt32ArrayCid, register_count));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(result.DataAddr(0), registers, register_count * sizeof(int32_t));
+  }
+  return result.raw();
+}
+
+}  // namespace dart
@@ -0,0 +1,50 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A matcher for regular expressions without backreferences and lookarounds
+// which runs in time linear in the length of the subject.
+//
+// The pattern is compiled to a small program for a Pike VM which simulates
+// all backtracking paths in lock step, keeping the threads ordered by the
+// priority irregexp would explore them in. This yields the same leftmost,
+// first-alternative results as backtracking without the exponential worst
+// case.
+
+#ifndef RUNTIME_VM_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class RegExpTree;
+
+class LinearRegExp : public AllStatic {
+ public:
+  // Decides whether the given regexp should be matched by the linear engine
+  // and, if so, compiles its program and marks it as linear. Returns whether
+  // the regexp was marked.
+  static bool Prepare(const RegExp& regexp, Zone* zone);
+
+  // Whether the tree only uses constructs the linear engine supports.
+  static bool CanMatch(RegExpTree* tree);
+
+  // Whether the tree contains a nested or alternating repetition which can
+  // make backtracking super-linear, e.g. (a+)+ or (a|aa)*.
+  static bool IsBacktrackingProne(RegExpTree* tree);
+
+  // Returns the capture registers of the leftmost match at or after
+  // start_index, or null if there is none. When sticky, the match must start
+  // at start_index.
+  static RawInstance* Execute(const RegExp& regexp,
+                              const String& subject,
+                              const Smi& start_index,
+                              bool sticky,
+                              Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_LINEAR_H_
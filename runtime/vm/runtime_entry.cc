@@ -1948,6 +1948,36 @@ static void HandleStackOverflowTestCases(Thread* thread) {
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+// Mid-tier code counts loop iterations to tier up hot loops, but optimized
+// frames cannot be entered or left through OSR. Install code of the full
+// pipeline for later calls, then deoptimize the mid-tier frame: its
+// unoptimized code continues the loop, finds the usage counter above the
+// threshold and enters the new code through the regular OSR path.
+static void HandleMidTierOSRRequest(Thread* thread,
+                                    const Code& code,
+                                    StackFrame* frame) {
+  ASSERT(code.is_mid_tier());
+  const Function& function = Function::Handle(code.function());
+  ASSERT(!function.IsNull());
+  if (FLAG_trace_osr) {
+    OS::PrintErr("Leaving mid-tier code of %s, count=%" Pd "\n",
+                 function.ToFullyQualifiedCString(), function.usage_counter());
+  }
+  const Error& error =
+      Error::Handle(Compiler::EnsureUnoptimizedCode(thread, function));
+  ThrowIfError(error);
+
+  // Since the function still has optimized code, this compiles it with the
+  // full pipeline.
+  if ((function.CurrentCode() == code.raw()) &&
+      Compiler::CanOptimizeFunction(thread, function)) {
+    const Object& result = Object::Handle(
+        Compiler::CompileOptimizedFunction(thread, function));
+    ThrowIfError(result);
+  }
+  DeoptimizeFrameLazily(code, frame);
+}
+
 static void HandleOSRRequest(Thread* thread) {
   Isolate* isolate = thread->isolate();
   ASSERT(isolate->use_osr());
@@ -1957,7 +1987,10 @@ static void HandleOSRRequest(Thread* thread) {
   ASSERT(frame != NULL);
   const Code& code = Code::ZoneHandle(frame->LookupDartCode());
   ASSERT(!code.IsNull());
-  ASSERT(!code.is_optimized());
+  if (code.is_optimized()) {
+    HandleMidTierOSRRequest(thread, code, frame);
+    return;
+  }
   const Function& function = Function::Handle(code.function());
   ASSERT(!function.IsNull());
 
@@ -2267,7 +2300,17 @@ void DeoptimizeAt(const Code& optimized_code, StackFrame* frame) {
     function.SwitchToUnoptimizedCode();
   }
 
+  DeoptimizeFrameLazily(optimized_code, frame);
+
+  // Mark code as dead (do not GC its embedded objects).
+  optimized_code.set_is_alive(false);
+}
+
+void DeoptimizeFrameLazily(const Code& optimized_code, StackFrame* frame) {
+  ASSERT(optimized_code.is_optimized());
 #if defined(TARGET_ARCH_DBC)
+  Zone* zone = Thread::Current()->zone();
+  const Function& function = Function::Handle(zone, optimized_code.function());
   const Instructions& instrs =
       Instructions::Handle(zone, optimized_code.instructions());
   {
@@ -2291,6 +2334,7 @@ void DeoptimizeAt(const Code& optimized_code, StackFrame* frame) {
     }
   }
 #else  // !DBC
+  Thread* thread = Thread::Current();
   if (frame->IsMarkedForLazyDeopt()) {
     // Deopt already scheduled.
     if (FLAG_trace_deoptimization) {
@@ -2315,9 +2359,6 @@ void DeoptimizeAt(const Code& optimized_code, StackFrame* frame) {
     }
   }
 #endif  // !DBC
-
-  // Mark code as dead (do not GC its embedded objects).
-  optimized_code.set_is_alive(false);
 }
 
 // Currently checks only that all optimized frames have kDeoptIndex
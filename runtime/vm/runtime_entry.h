@@ -148,6 +148,9 @@ LEAF_RUNTIME_ENTRY_LIST(DECLARE_LEAF_RUNTIME_ENTRY)
 const char* DeoptReasonToCString(ICData::DeoptReasonId deopt_reason);
 
 void DeoptimizeAt(const Code& optimized_code, StackFrame* frame);
+// Deoptimizes [frame] when control returns to it, without switching the
+// function away from its current code.
+void DeoptimizeFrameLazily(const Code& optimized_code, StackFrame* frame);
 void DeoptimizeFunctionsOnStack();
 
 double DartModulo(double a, double b);
@@ -36,6 +36,7 @@ namespace dart {
   V(UnlinkedCall)                                                              \
   V(MonomorphicMiss)                                                           \
   V(SingleTargetCall)                                                          \
+  V(DispatchTableCall)                                                         \
   V(ICCallThroughFunction)                                                     \
   V(ICCallThroughCode)                                                         \
   V(MegamorphicCall)                                                           \
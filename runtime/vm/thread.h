@@ -48,6 +48,7 @@ class Object;
 class OSThread;
 class JSONObject;
 class PcDescriptors;
+class RawArray;
 class RawBool;
 class RawObject;
 class RawCode;
@@ -113,6 +114,7 @@ class Zone;
   V(RawCode*, monomorphic_miss_stub_, StubCode::MonomorphicMiss().raw(), NULL) \
   V(RawCode*, ic_lookup_through_code_stub_,                                    \
     StubCode::ICCallThroughCode().raw(), NULL)                                 \
+  V(RawCode*, unlinked_call_stub_, StubCode::UnlinkedCall().raw(), NULL)       \
   V(RawCode*, deoptimize_stub_, StubCode::Deoptimize().raw(), NULL)            \
   V(RawCode*, lazy_deopt_from_return_stub_,                                    \
     StubCode::DeoptimizeLazyFromReturn().raw(), NULL)                          \
@@ -538,6 +540,14 @@ class Thread : public ThreadState {
     global_object_pool_ = raw_value;
   }
 
+  // The AOT dispatch table of the current isolate, see
+  // [ObjectStore::dispatch_table].
+  RawArray* dispatch_table() const { return dispatch_table_; }
+  void set_dispatch_table(RawArray* raw_value) { dispatch_table_ = raw_value; }
+  static intptr_t dispatch_table_offset() {
+    return OFFSET_OF(Thread, dispatch_table_);
+  }
+
   static bool CanLoadFromThread(const Object& object);
   static intptr_t OffsetFromThread(const Object& object);
   static bool ObjectAtOffset(intptr_t offset, Object* object);
@@ -802,6 +812,7 @@ class Thread : public ThreadState {
   MarkingStackBlock* deferred_marking_stack_block_;
   uword vm_tag_;
   RawStackTrace* async_stack_trace_;
+  RawArray* dispatch_table_;
   // Memory location dedicated for passing unboxed int64 values from
   // generated code to runtime.
   // TODO(dartbug.com/33549): Clean this up when unboxed values
@@ -179,7 +179,7 @@ RawCode* TypeTestingStubGenerator::BuildCodeForType(const Type& type) {
   HierarchyInfo* hi = Thread::Current()->hierarchy_info();
   ASSERT(hi != NULL);
 
-  if (!hi->CanUseSubtypeRangeCheckFor(type) &&
+  if (!type.IsFunctionType() && !hi->CanUseSubtypeRangeCheckFor(type) &&
       !hi->CanUseGenericSubtypeRangeCheckFor(type)) {
     return Code::null();
   }
@@ -245,7 +245,17 @@ void TypeTestingStubGenerator::BuildOptimizedTypeTestStubFastCases(
   }
 
   // Check the cid ranges which are a subtype of [type].
-  if (hi->CanUseSubtypeRangeCheckFor(type)) {
+  if (type.IsFunctionType()) {
+    // Whether a closure is a subtype of a function type depends on its
+    // signature and the type arguments it captured, so we can only consult the
+    // cache of earlier checks at the call site.
+    Label not_closure;
+    __ LoadClassIdMayBeSmi(class_id_reg, instance_reg);
+    __ CompareImmediate(class_id_reg, kClosureCid);
+    __ BranchIf(NOT_EQUAL, &not_closure);
+    BuildOptimizedClosureSubtypeTestCacheProbe(assembler);
+    __ Bind(&not_closure);
+  } else if (hi->CanUseSubtypeRangeCheckFor(type)) {
     const CidRangeVector& ranges = hi->SubtypeRangesForClass(type_class);
 
     const Type& int_type = Type::Handle(Type::IntType());
@@ -266,8 +276,13 @@ void TypeTestingStubGenerator::BuildOptimizedTypeTestStubFastCases(
     const TypeArguments& ta = TypeArguments::Handle(type.arguments());
     ASSERT(ta.Length() == num_type_arguments);
 
-    BuildOptimizedSubclassRangeCheckWithTypeArguments(assembler, hi, type_class,
-                                                      tp, ta);
+    if (type_class.is_implemented()) {
+      BuildOptimizedSubtypeRangeCheckWithTypeArguments(assembler, hi,
+                                                       type_class, ta);
+    } else {
+      BuildOptimizedSubclassRangeCheckWithTypeArguments(assembler, hi,
+                                                        type_class, tp, ta);
+    }
   }
 
   // Fast case for 'null'.
@@ -346,8 +361,7 @@ void TypeTestingStubGenerator::
         num_type_arguments - num_type_parameters + i;
 
     type_arg = ta.TypeAt(type_param_value_offset_i);
-    ASSERT(type_arg.IsTypeParameter() ||
-           hi->CanUseSubtypeRangeCheckFor(type_arg));
+    ASSERT(type_arg.IsTypeParameter() || type_arg.IsInstantiated());
 
     BuildOptimizedTypeArgumentValueCheck(
         assembler, hi, type_arg, type_param_value_offset_i, &check_failed);
@@ -358,6 +372,172 @@ void TypeTestingStubGenerator::
   __ Bind(&check_failed);
 }
 
+// Computes where instances of [klass] store the values of the type parameters
+// of the implemented [type_class] which need to be checked against
+// [type_arguments].
+//
+// The layout is the offset of the type arguments vector in the instances (or
+// [Class::kNoTypeArguments] if no check needs to load it), followed by the
+// index of the value of each type parameter in that vector (or -1 if [klass]
+// is known to instantiate [type_class] with a subtype of what is tested for).
+//
+// Returns null if instances of [klass] need to be checked by the slow path.
+static ZoneGrowableArray<intptr_t>* TypeArgumentsLayoutFor(
+    Zone* zone,
+    const Class& klass,
+    const Class& type_class,
+    const TypeArguments& type_arguments) {
+  const TypeArguments& instantiation =
+      TypeArguments::Handle(zone, klass.GetInstantiationOf(type_class));
+  const intptr_t num_type_parameters = type_class.NumTypeParameters();
+  const intptr_t num_type_arguments = type_class.NumTypeArguments();
+
+  auto layout = new (zone) ZoneGrowableArray<intptr_t>(num_type_parameters + 1);
+  layout->Add(Class::kNoTypeArguments);
+  AbstractType& type_arg = AbstractType::Handle(zone);
+  AbstractType& value = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < num_type_parameters; ++i) {
+    const intptr_t type_param_value_offset_i =
+        num_type_arguments - num_type_parameters + i;
+    type_arg = type_arguments.TypeAt(type_param_value_offset_i);
+    if (type_arg.raw() == Type::ObjectType() ||
+        type_arg.raw() == Type::DynamicType()) {
+      layout->Add(-1);
+      continue;
+    }
+    if (instantiation.IsNull()) {
+      return nullptr;
+    }
+    value = instantiation.TypeAt(type_param_value_offset_i);
+    if (value.IsTypeParameter() &&
+        TypeParameter::Cast(value).IsClassTypeParameter()) {
+      layout->Add(TypeParameter::Cast(value).index());
+      (*layout)[0] = klass.type_arguments_field_offset();
+    } else if (value.IsInstantiated() && type_arg.IsInstantiated() &&
+               value.IsSubtypeOf(type_arg, Heap::kOld)) {
+      layout->Add(-1);
+    } else {
+      return nullptr;
+    }
+  }
+  return layout;
+}
+
+static bool IsSameTypeArgumentsLayout(const ZoneGrowableArray<intptr_t>& a,
+                                      const ZoneGrowableArray<intptr_t>& b) {
+  ASSERT(a.length() == b.length());
+  for (intptr_t i = 0; i < a.length(); ++i) {
+    if (a[i] != b[i]) return false;
+  }
+  return true;
+}
+
+void TypeTestingStubGenerator::BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+    Assembler* assembler,
+    HierarchyInfo* hi,
+    const Class& type_class,
+    const TypeArguments& ta,
+    const Register class_id_reg,
+    const Register instance_reg,
+    const Register instance_type_args_reg) {
+  // Implementations of [type_class] can store their type arguments at
+  // different offsets and instantiate [type_class] with different parts of
+  // them, so we group their class ids by the layout of their type arguments
+  // and emit one check per group.  Classes we can't check this way and
+  // classes beyond the first few layouts are left to the slow path.
+  const intptr_t kMaxTypeArgumentsLayouts = 4;
+
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  ClassTable* class_table = thread->isolate()->class_table();
+  GrowableArray<ZoneGrowableArray<intptr_t>*> layouts;
+  CidRangeVector layout_ranges[kMaxTypeArgumentsLayouts];
+  Class& klass = Class::Handle(zone);
+
+  const CidRangeVector& ranges = hi->SubtypeRangesForClass(type_class);
+  for (intptr_t i = 0; i < ranges.length(); ++i) {
+    const CidRange& range = ranges[i];
+    if (range.IsIllegalRange()) continue;
+
+    intptr_t last_layout = -1;
+    for (intptr_t cid = range.cid_start; cid <= range.cid_end; ++cid) {
+      // Class ids without instances can be added to any group.
+      if (!class_table->HasValidClassAt(cid)) continue;
+      klass = class_table->At(cid);
+      if (klass.is_abstract() || klass.IsTopLevel()) continue;
+
+      ZoneGrowableArray<intptr_t>* layout = nullptr;
+      if (klass.is_finalized()) {
+        layout = TypeArgumentsLayoutFor(zone, klass, type_class, ta);
+      }
+      intptr_t index = -1;
+      if (layout != nullptr) {
+        for (intptr_t j = 0; j < layouts.length(); ++j) {
+          if (IsSameTypeArgumentsLayout(*layouts[j], *layout)) {
+            index = j;
+            break;
+          }
+        }
+        if (index == -1 && layouts.length() < kMaxTypeArgumentsLayouts) {
+          index = layouts.length();
+          layouts.Add(layout);
+        }
+      }
+      if (index != -1) {
+        CidRangeVector& group = layout_ranges[index];
+        if (index == last_layout) {
+          group[group.length() - 1].cid_end = cid;
+        } else {
+          group.Add(CidRange(cid, cid));
+        }
+      }
+      last_layout = index;
+    }
+  }
+
+  const intptr_t num_type_parameters = type_class.NumTypeParameters();
+  const intptr_t num_type_arguments = type_class.NumTypeArguments();
+  AbstractType& type_arg = AbstractType::Handle(zone);
+
+  Label check_failed;
+  for (intptr_t i = 0; i < layouts.length(); ++i) {
+    const ZoneGrowableArray<intptr_t>& layout = *layouts[i];
+
+    // a) First we make a cid-range check for the classes of this layout.
+    Label next_layout;
+    BuildOptimizedSubclassRangeCheck(assembler, layout_ranges[i], class_id_reg,
+                                     instance_reg, &next_layout);
+
+    // b) Then we'll load the values for the type parameters, if any of them
+    // needs to be checked.
+    if (layout[0] != Class::kNoTypeArguments) {
+      __ LoadField(instance_type_args_reg,
+                   FieldAddress(instance_reg, layout[0]));
+
+      // See [BuildOptimizedSubclassRangeCheckWithTypeArguments].
+      Label process_done;
+      __ CompareObject(instance_type_args_reg, Object::null_object());
+      __ BranchIf(NOT_EQUAL, &process_done);
+      __ Ret();
+      __ Bind(&process_done);
+
+      // c) Then we'll check each value of the type argument.
+      for (intptr_t j = 0; j < num_type_parameters; ++j) {
+        const intptr_t type_param_value_offset_j = layout[j + 1];
+        if (type_param_value_offset_j < 0) continue;
+        type_arg = ta.TypeAt(num_type_arguments - num_type_parameters + j);
+        BuildOptimizedTypeArgumentValueCheck(
+            assembler, hi, type_arg, type_param_value_offset_j, &check_failed);
+      }
+    }
+    __ Ret();
+    __ Bind(&next_layout);
+  }
+
+  // If anything fails.
+  __ Bind(&check_failed);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedSubclassRangeCheck(
     Assembler* assembler,
     const CidRangeVector& ranges,
@@ -383,8 +563,20 @@ void TypeTestingStubGenerator::BuildOptimizedTypeArgumentValueCheck(
     const Register function_type_args_reg,
     const Register own_type_arg_reg,
     Label* check_failed) {
-  if (type_arg.raw() != Type::ObjectType() &&
-      type_arg.raw() != Type::DynamicType()) {
+  if (type_arg.IsType() && type_arg.IsInstantiated() &&
+      !hi->CanUseSubtypeRangeCheckFor(type_arg)) {
+    // Generic types and function types can't be checked by class id ranges.
+    // Type arguments of instances are canonicalized, so we can check whether
+    // the value is exactly [type_arg] and leave anything else to the slow
+    // path.
+    __ LoadField(
+        class_id_reg,
+        FieldAddress(instance_type_args_reg,
+                     TypeArguments::type_at_offset(type_param_value_offset_i)));
+    __ CompareObject(class_id_reg, AbstractType::ZoneHandle(type_arg.raw()));
+    __ BranchIf(NOT_EQUAL, check_failed);
+  } else if (type_arg.raw() != Type::ObjectType() &&
+             type_arg.raw() != Type::DynamicType()) {
     // TODO(kustermann): Even though it should be safe to use TMP here, we
     // should avoid using TMP outside the assembler.  Try to find a free
     // register to use here!
@@ -89,6 +89,25 @@ class TypeTestingStubGenerator {
       const Register instance_reg,
       const Register instance_type_args_reg);
 
+  static void BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+      Assembler* assembler,
+      HierarchyInfo* hi,
+      const Class& type_class,
+      const TypeArguments& type_arguments);
+
+  static void BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+      Assembler* assembler,
+      HierarchyInfo* hi,
+      const Class& type_class,
+      const TypeArguments& type_arguments,
+      const Register class_id_reg,
+      const Register instance_reg,
+      const Register instance_type_args_reg);
+
+  // Probes the [SubtypeTestCache] of the call site for the closure instance
+  // and returns if it has a positive entry.  Falls through otherwise.
+  static void BuildOptimizedClosureSubtypeTestCacheProbe(Assembler* assembler);
+
   static void BuildOptimizedSubclassRangeCheck(Assembler* assembler,
                                                const CidRangeVector& ranges,
                                                Register class_id_reg,
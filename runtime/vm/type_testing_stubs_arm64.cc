@@ -43,6 +43,98 @@ void TypeTestingStubGenerator::
       kInstanceTypeArguments);
 }
 
+void TypeTestingStubGenerator::BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+    Assembler* assembler,
+    HierarchyInfo* hi,
+    const Class& type_class,
+    const TypeArguments& ta) {
+  const Register kInstanceReg = R0;
+  const Register kInstanceTypeArguments = R7;
+  const Register kClassIdReg = R9;
+
+  BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+      assembler, hi, type_class, ta, kClassIdReg, kInstanceReg,
+      kInstanceTypeArguments);
+}
+
+void TypeTestingStubGenerator::BuildOptimizedClosureSubtypeTestCacheProbe(
+    Assembler* assembler) {
+  const Register kInstanceReg = R0;
+  const Register kInstantiatorTypeArgumentsReg = R1;
+  const Register kFunctionTypeArgumentsReg = R2;
+  const Register kSubtypeTestCacheReg = R3;
+
+  const Register kEntryReg = R4;
+  const Register kInstanceFunctionReg = R6;
+  const Register kScratchReg = R5;
+
+  Label loop, next_iteration, not_found;
+  __ CompareObject(kSubtypeTestCacheReg, Object::null_object());
+  __ b(&not_found, EQ);
+
+  __ ldr(kEntryReg,
+         FieldAddress(kSubtypeTestCacheReg, SubtypeTestCache::cache_offset()));
+  __ AddImmediate(kEntryReg, Array::data_offset() - kHeapObjectTag);
+  __ ldr(kInstanceFunctionReg,
+         FieldAddress(kInstanceReg, Closure::function_offset()));
+
+  // Same lookup as for closures in the Subtype6TestCache stub.
+  __ Bind(&loop);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize * SubtypeTestCache::kInstanceClassIdOrFunction));
+  __ CompareObject(kScratchReg, Object::null_object());
+  __ b(&not_found, EQ);
+  __ cmp(kScratchReg, Operand(kInstanceFunctionReg));
+  __ b(&next_iteration, NE);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize * SubtypeTestCache::kInstanceTypeArguments));
+  __ CompareWithFieldValue(
+      kScratchReg, FieldAddress(kInstanceReg,
+                                Closure::instantiator_type_arguments_offset()));
+  __ b(&next_iteration, NE);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize * SubtypeTestCache::kInstantiatorTypeArguments));
+  __ cmp(kScratchReg, Operand(kInstantiatorTypeArgumentsReg));
+  __ b(&next_iteration, NE);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize * SubtypeTestCache::kFunctionTypeArguments));
+  __ cmp(kScratchReg, Operand(kFunctionTypeArgumentsReg));
+  __ b(&next_iteration, NE);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize *
+                     SubtypeTestCache::kInstanceParentFunctionTypeArguments));
+  __ CompareWithFieldValue(
+      kScratchReg,
+      FieldAddress(kInstanceReg, Closure::function_type_arguments_offset()));
+  __ b(&next_iteration, NE);
+  __ ldr(kScratchReg,
+         Address(kEntryReg,
+                 kWordSize *
+                     SubtypeTestCache::kInstanceDelayedFunctionTypeArguments));
+  __ CompareWithFieldValue(
+      kScratchReg,
+      FieldAddress(kInstanceReg, Closure::delayed_type_arguments_offset()));
+  __ b(&next_iteration, NE);
+
+  // Negative entries are left to the slow stub, which reports the error.
+  __ ldr(kScratchReg,
+         Address(kEntryReg, kWordSize * SubtypeTestCache::kTestResult));
+  __ CompareObject(kScratchReg, Bool::True());
+  __ b(&not_found, NE);
+  __ Ret();
+
+  __ Bind(&next_iteration);
+  __ AddImmediate(kEntryReg, kWordSize * SubtypeTestCache::kTestEntryLength);
+  __ b(&loop);
+
+  __ Bind(&not_found);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedTypeArgumentValueCheck(
     Assembler* assembler,
     HierarchyInfo* hi,
@@ -42,6 +42,95 @@ void TypeTestingStubGenerator::
       kInstanceTypeArguments);
 }
 
+void TypeTestingStubGenerator::BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+    Assembler* assembler,
+    HierarchyInfo* hi,
+    const Class& type_class,
+    const TypeArguments& ta) {
+  const Register kInstanceReg = RAX;
+  const Register kInstanceTypeArguments = RSI;
+  const Register kClassIdReg = TMP;
+
+  BuildOptimizedSubtypeRangeCheckWithTypeArguments(
+      assembler, hi, type_class, ta, kClassIdReg, kInstanceReg,
+      kInstanceTypeArguments);
+}
+
+void TypeTestingStubGenerator::BuildOptimizedClosureSubtypeTestCacheProbe(
+    Assembler* assembler) {
+  const Register kInstanceReg = RAX;
+  const Register kInstantiatorTypeArgumentsReg = RDX;
+  const Register kFunctionTypeArgumentsReg = RCX;
+  const Register kSubtypeTestCacheReg = R9;
+
+  const Register kEntryReg = RSI;
+  const Register kInstanceFunctionReg = R10;
+  const Register kScratchReg = RDI;
+
+  Label loop, next_iteration, not_found;
+  __ CompareObject(kSubtypeTestCacheReg, Object::null_object());
+  __ BranchIf(EQUAL, &not_found);
+
+  __ movq(kEntryReg,
+          FieldAddress(kSubtypeTestCacheReg, SubtypeTestCache::cache_offset()));
+  __ addq(kEntryReg, Immediate(Array::data_offset() - kHeapObjectTag));
+  __ movq(kInstanceFunctionReg,
+          FieldAddress(kInstanceReg, Closure::function_offset()));
+
+  // Same lookup as for closures in the Subtype6TestCache stub.
+  __ Bind(&loop);
+  __ movq(kScratchReg,
+          Address(kEntryReg,
+                  kWordSize * SubtypeTestCache::kInstanceClassIdOrFunction));
+  __ CompareObject(kScratchReg, Object::null_object());
+  __ BranchIf(EQUAL, &not_found);
+  __ cmpq(kScratchReg, kInstanceFunctionReg);
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+  __ movq(kScratchReg,
+          FieldAddress(kInstanceReg,
+                       Closure::instantiator_type_arguments_offset()));
+  __ cmpq(kScratchReg,
+          Address(kEntryReg,
+                  kWordSize * SubtypeTestCache::kInstanceTypeArguments));
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+  __ cmpq(kInstantiatorTypeArgumentsReg,
+          Address(kEntryReg,
+                  kWordSize * SubtypeTestCache::kInstantiatorTypeArguments));
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+  __ cmpq(kFunctionTypeArgumentsReg,
+          Address(kEntryReg,
+                  kWordSize * SubtypeTestCache::kFunctionTypeArguments));
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+  __ movq(
+      kScratchReg,
+      FieldAddress(kInstanceReg, Closure::function_type_arguments_offset()));
+  __ cmpq(kScratchReg,
+          Address(kEntryReg,
+                  kWordSize *
+                      SubtypeTestCache::kInstanceParentFunctionTypeArguments));
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+  __ movq(kScratchReg,
+          FieldAddress(kInstanceReg, Closure::delayed_type_arguments_offset()));
+  __ cmpq(kScratchReg,
+          Address(kEntryReg,
+                  kWordSize *
+                      SubtypeTestCache::kInstanceDelayedFunctionTypeArguments));
+  __ BranchIf(NOT_EQUAL, &next_iteration);
+
+  // Negative entries are left to the slow stub, which reports the error.
+  __ movq(kScratchReg,
+          Address(kEntryReg, kWordSize * SubtypeTestCache::kTestResult));
+  __ CompareObject(kScratchReg, Bool::True());
+  __ BranchIf(NOT_EQUAL, &not_found);
+  __ Ret();
+
+  __ Bind(&next_iteration);
+  __ addq(kEntryReg, Immediate(kWordSize * SubtypeTestCache::kTestEntryLength));
+  __ jmp(&loop);
+
+  __ Bind(&not_found);
+}
+
 void TypeTestingStubGenerator::BuildOptimizedTypeArgumentValueCheck(
     Assembler* assembler,
     HierarchyInfo* hi,
@@ -2902,6 +2902,9 @@ class _DetachedSocket extends Stream<List<int>> implements Socket {
 
   Future flush() => _socket.flush();
 
+  Stream<int> sendFile(RandomAccessFile file, [int offset = 0, int length]) =>
+      _socket.sendFile(file, offset, length);
+
   Future close() => _socket.close();
 
   Future get done => _socket.done;
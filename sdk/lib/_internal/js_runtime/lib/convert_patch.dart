@@ -491,6 +491,24 @@ class Utf8Decoder {
   }
 }
 
+@patch
+class JsonEncoder {
+  // Currently not intercepting JSON encoding.
+  @patch
+  static String _convertIntercepted(Object object) {
+    return null; // This call was not intercepted.
+  }
+}
+
+@patch
+class Utf8Encoder {
+  // Currently not intercepting UTF-8 encoding.
+  @patch
+  static List<int> _convertIntercepted(String string, int start, int end) {
+    return null; // This call was not intercepted.
+  }
+}
+
 @patch
 int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   final to = endIndex;
@@ -206,6 +206,14 @@ class _Namespace {
   }
 }
 
+@patch
+class RandomAccessFile {
+  @patch
+  static Uint8List allocateBuffer(int length) {
+    throw new UnsupportedError("RandomAccessFile.allocateBuffer");
+  }
+}
+
 @patch
 class _RandomAccessFileOps {
   @patch
@@ -249,8 +249,23 @@ class JsonEncoder extends Converter<Object, String> {
   /// If an object is serialized more than once, [convert] may cache the text
   /// for it. In other words, if the content of an object changes after it is
   /// first serialized, the new values may not be reflected in the result.
-  String convert(Object object) =>
-      _JsonStringStringifier.stringify(object, _toEncodable, indent);
+  String convert(Object object) {
+    if (indent == null) {
+      // Allow the implementation to encode single-line JSON directly.
+      var result = _convertIntercepted(object);
+      if (result != null) {
+        return result;
+      }
+    }
+    return _JsonStringStringifier.stringify(object, _toEncodable, indent);
+  }
+
+  /// Returns the single-line JSON encoding of [object], or `null` if the
+  /// call was not intercepted.
+  ///
+  /// An implementation may only intercept the call if [object] and everything
+  /// it contains can be encoded without calling `toEncodable`.
+  external static String _convertIntercepted(Object object);
 
   /// Starts a chunked conversion.
   ///
@@ -80,6 +80,12 @@ class Utf8Encoder extends Converter<String, List<int>> {
     end = RangeError.checkValidRange(start, end, stringLength);
     var length = end - start;
     if (length == 0) return Uint8List(0);
+    // Allow the implementation to intercept and specialize based on the type
+    // of string.
+    var result = _convertIntercepted(string, start, end);
+    if (result != null) {
+      return result;
+    }
     // Create a new encoder with a length that is guaranteed to be big enough.
     // A single code unit uses at most 3 bytes, a surrogate pair at most 4.
     var encoder = _Utf8Encoder.withBufferSize(length * 3);
@@ -110,6 +116,9 @@ class Utf8Encoder extends Converter<String, List<int>> {
 
   // Override the base-classes bind, to provide a better type.
   Stream<List<int>> bind(Stream<String> stream) => super.bind(stream);
+
+  external static List<int> _convertIntercepted(
+      String string, int start, int end);
 }
 
 /// This class encodes Strings to UTF-8 code units (unsigned 8 bit integers).
@@ -308,11 +308,16 @@ abstract class Directory implements FileSystemEntity {
    * same recursive descent, but will report it as a [Link]
    * the second time it is seen.
    *
+   * If [parallel] is true, a recursive listing that does not follow links
+   * lists several sub-directories at the same time. The entries of a
+   * directory are then not necessarily followed by those of its
+   * sub-directories, and the order of the entries is unspecified.
+   *
    * The result is a stream of [FileSystemEntity] objects
    * for the directories, files, and links.
    */
   Stream<FileSystemEntity> list(
-      {bool recursive: false, bool followLinks: true});
+      {bool recursive: false, bool followLinks: true, bool parallel: false});
 
   /**
    * Lists the sub-directories and files of this [Directory].
@@ -229,14 +229,15 @@ class _Directory extends FileSystemEntity implements Directory {
   }
 
   Stream<FileSystemEntity> list(
-      {bool recursive: false, bool followLinks: true}) {
+      {bool recursive: false, bool followLinks: true, bool parallel: false}) {
     return new _AsyncDirectoryLister(
             // FIXME(bkonyi): here we're using `path` directly, which might cause issues
             // if it is not UTF-8 encoded.
             FileSystemEntity._toUtf8Array(
                 FileSystemEntity._ensureTrailingPathSeparators(path)),
             recursive,
-            followLinks)
+            followLinks,
+            parallel)
         .stream;
   }
 
@@ -290,6 +291,11 @@ class _AsyncDirectoryLister {
   static const int listLink = 2;
   static const int listError = 3;
   static const int listDone = 4;
+  static const int listPacked = 5;
+
+  // The number of requests listing subdirectories at the same time in
+  // parallel mode.
+  static const int parallelRequests = 4;
 
   static const int responseType = 0;
   static const int responsePath = 1;
@@ -299,15 +305,24 @@ class _AsyncDirectoryLister {
   final Uint8List rawPath;
   final bool recursive;
   final bool followLinks;
+  final bool parallel;
 
   StreamController<FileSystemEntity> controller;
   bool canceled = false;
-  bool nextRunning = false;
   bool closed = false;
   _AsyncDirectoryListerOps _ops;
   Completer closeCompleter = new Completer();
 
-  _AsyncDirectoryLister(this.rawPath, this.recursive, this.followLinks) {
+  // The number of ListNext requests running, and the number to keep running.
+  // In parallel mode a request that finds no subdirectory to list is not
+  // repeated until another one returns, possibly with more subdirectories.
+  int running = 0;
+  int wanted = 1;
+
+  bool get nextRunning => running > 0;
+
+  _AsyncDirectoryLister(
+      this.rawPath, this.recursive, this.followLinks, this.parallel) {
     controller = new StreamController<FileSystemEntity>(
         onListen: onListen, onResume: onResume, onCancel: onCancel, sync: true);
   }
@@ -325,7 +340,7 @@ class _AsyncDirectoryLister {
 
   void onListen() {
     _File._dispatchWithNamespace(_IOService.directoryListStart,
-        [null, rawPath, recursive, followLinks]).then((response) {
+        [null, rawPath, recursive, followLinks, parallel]).then((response) {
       if (response is int) {
         _ops = new _AsyncDirectoryListerOps(response);
         next();
@@ -340,9 +355,7 @@ class _AsyncDirectoryLister {
   }
 
   void onResume() {
-    if (!nextRunning) {
-      next();
-    }
+    next();
   }
 
   Future onCancel() {
@@ -360,44 +373,75 @@ class _AsyncDirectoryLister {
       close();
       return;
     }
-    if (controller.isPaused || nextRunning) {
-      return;
+    while (!controller.isPaused && running < wanted) {
+      var pointer = _pointer();
+      if (pointer == null) {
+        return;
+      }
+      running++;
+      _IOService._dispatch(_IOService.directoryListNext, [pointer])
+          .then(handleNext);
     }
-    var pointer = _pointer();
-    if (pointer == null) {
+  }
+
+  void handleNext(result) {
+    running--;
+    if (result is! List) {
+      controller.addError(new FileSystemException("Internal error"));
       return;
     }
-    nextRunning = true;
-    _IOService._dispatch(_IOService.directoryListNext, [pointer])
-        .then((result) {
-      nextRunning = false;
-      if (result is List) {
-        next();
-        assert(result.length % 2 == 0);
-        for (int i = 0; i < result.length; i++) {
-          assert(i % 2 == 0);
-          switch (result[i++]) {
-            case listFile:
-              controller.add(new File.fromRawPath(result[i]));
-              break;
-            case listDirectory:
-              controller.add(new Directory.fromRawPath(result[i]));
-              break;
-            case listLink:
-              controller.add(new Link.fromRawPath(result[i]));
-              break;
-            case listError:
-              error(result[i]);
-              break;
-            case listDone:
-              canceled = true;
-              return;
-          }
-        }
-      } else {
-        controller.addError(new FileSystemException("Internal error"));
+    if (parallel) {
+      wanted = result.isEmpty ? max(wanted - 1, 1) : parallelRequests;
+      if (result.isEmpty && running > 0) return;
+    }
+    next();
+    assert(result.length % 2 == 0);
+    for (int i = 0; i < result.length; i++) {
+      assert(i % 2 == 0);
+      switch (result[i++]) {
+        case listPacked:
+          addPacked(result[i]);
+          break;
+        case listFile:
+          controller.add(new File.fromRawPath(result[i]));
+          break;
+        case listDirectory:
+          controller.add(new Directory.fromRawPath(result[i]));
+          break;
+        case listLink:
+          controller.add(new Link.fromRawPath(result[i]));
+          break;
+        case listError:
+          error(result[i]);
+          break;
+        case listDone:
+          canceled = true;
+          if (!nextRunning) close();
+          return;
       }
-    });
+    }
+  }
+
+  // Adds the entries packed in [packed], each a type followed by its null
+  // terminated path.
+  void addPacked(Uint8List packed) {
+    int start = 0;
+    while (start < packed.length) {
+      int end = packed.indexOf(0, start + 1);
+      var rawPath = packed.sublist(start + 1, end + 1);
+      switch (packed[start]) {
+        case listFile:
+          controller.add(new File.fromRawPath(rawPath));
+          break;
+        case listDirectory:
+          controller.add(new Directory.fromRawPath(rawPath));
+          break;
+        case listLink:
+          controller.add(new Link.fromRawPath(rawPath));
+          break;
+      }
+      start = end + 1;
+    }
   }
 
   void _cleanup() {
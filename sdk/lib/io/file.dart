@@ -652,6 +652,15 @@ abstract class File implements FileSystemEntity {
  * synchronous methods. This will also throw a [FileSystemException].
  */
 abstract class RandomAccessFile {
+  /**
+   * Allocates a [Uint8List] of [length] bytes outside of the Dart heap, for
+   * use with [readIntoAt], [readIntoBuffersAt] and [writeFromAt].
+   *
+   * Reads into and writes from such a list go directly between the file and
+   * the list, without copying the data.
+   */
+  external static Uint8List allocateBuffer(int length);
+
   /**
    * Closes the file. Returns a `Future` that
    * completes when it has been closed.
@@ -750,6 +759,49 @@ abstract class RandomAccessFile {
    */
   void writeFromSync(List<int> buffer, [int start = 0, int end]);
 
+  /**
+   * Reads into [buffer] from the file at [position], without using or
+   * changing the position of the file. The bytes are filled into [buffer]
+   * from index [start] to index [end], which default to 0 and the length of
+   * [buffer].
+   *
+   * Returns a `Future<int>` that completes with the number of bytes read,
+   * which is only less than [end] - [start] at the end of the file.
+   *
+   * The bytes are read directly into lists from [allocateBuffer], and
+   * through a copy into other lists.
+   */
+  Future<int> readIntoAt(List<int> buffer, int position,
+      [int start = 0, int end]);
+
+  /**
+   * Reads into each of [buffers] in turn from the file at [position], without
+   * using or changing the position of the file. Each buffer is filled before
+   * the next one.
+   *
+   * Returns a `Future<int>` that completes with the total number of bytes
+   * read, which is only less than the total length of [buffers] at the end of
+   * the file.
+   *
+   * When all of [buffers] are from [allocateBuffer], the bytes are read
+   * directly into them, with as few system calls as the platform allows.
+   */
+  Future<int> readIntoBuffersAt(List<Uint8List> buffers, int position);
+
+  /**
+   * Writes from [buffer] to the file at [position], without using or changing
+   * the position of the file. It will write the buffer from index [start] to
+   * index [end], which default to 0 and the length of [buffer].
+   *
+   * Returns a `Future<RandomAccessFile>` that completes with this
+   * [RandomAccessFile] when the write completes.
+   *
+   * The bytes are written directly from lists from [allocateBuffer], and
+   * through a copy from other lists.
+   */
+  Future<RandomAccessFile> writeFromAt(List<int> buffer, int position,
+      [int start = 0, int end]);
+
   /**
    * Writes a string to the file using the given [Encoding]. Returns a
    * `Future<RandomAccessFile>` that completes with this
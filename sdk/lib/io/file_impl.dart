@@ -655,6 +655,7 @@ abstract class _RandomAccessFileOps {
   readInto(List<int> buffer, int start, int end);
   writeByte(int value);
   writeFrom(List<int> buffer, int start, int end);
+  bufferPointers(List<List<int>> buffers);
   position();
   setPosition(int position);
   truncate(int length);
@@ -881,6 +882,144 @@ class _RandomAccessFile implements RandomAccessFile {
     _resourceInfo.addWrite(end - (start - bufferAndStart.start));
   }
 
+  // The retained pointers to [buffers] when they are all from
+  // [RandomAccessFile.allocateBuffer], or null. The request they are passed
+  // to releases them, so they must only be taken once the request is sure to
+  // be dispatched.
+  List<int> _bufferPointers(List<List<int>> buffers) {
+    for (var buffer in buffers) {
+      if (buffer is! Uint8List) return null;
+    }
+    return _ops.bufferPointers(buffers);
+  }
+
+  Future<int> readIntoAt(List<int> buffer, int position,
+      [int start = 0, int end]) {
+    if ((buffer is! List) ||
+        (position is! int) ||
+        ((start != null) && (start is! int)) ||
+        ((end != null) && (end is! int))) {
+      throw new ArgumentError("Invalid arguments to readIntoAt");
+    }
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(0);
+    }
+    var error = _dispatchError();
+    if (error != null) return error;
+    List<int> pointers = _bufferPointers(<List<int>>[buffer]);
+    var request = [null, pointers?.first, start, end - start, position];
+    return _dispatch(_IOService.fileReadAt, request).then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(response, "readIntoAt failed", path);
+      }
+      int read;
+      if (pointers != null) {
+        read = response;
+      } else {
+        read = response[1];
+        buffer.setRange(start, start + read, response[2]);
+      }
+      _resourceInfo.addRead(read);
+      return read;
+    });
+  }
+
+  Future<int> readIntoBuffersAt(List<Uint8List> buffers, int position) {
+    if ((buffers is! List) || (position is! int)) {
+      throw new ArgumentError("Invalid arguments to readIntoBuffersAt");
+    }
+    RangeError.checkNotNegative(position, "position");
+    int length = 0;
+    for (var buffer in buffers) {
+      if (buffer is! List<int>) {
+        throw new ArgumentError("Invalid arguments to readIntoBuffersAt");
+      }
+      length += buffer.length;
+    }
+    if (length == 0) {
+      return new Future.value(0);
+    }
+    var error = _dispatchError();
+    if (error != null) return error;
+    List<int> pointers = _bufferPointers(buffers);
+    if (pointers == null) {
+      // Read all the bytes at once, and copy them into the buffers.
+      return _dispatch(
+              _IOService.fileReadAt, [null, null, 0, length, position])
+          .then((response) {
+        if (_isErrorResponse(response)) {
+          throw _exceptionFromResponse(
+              response, "readIntoBuffersAt failed", path);
+        }
+        int read = response[1];
+        List<int> data = response[2];
+        int offset = 0;
+        for (var buffer in buffers) {
+          if (offset == read) break;
+          int count = min(buffer.length, read - offset);
+          buffer.setRange(0, count, data, offset);
+          offset += count;
+        }
+        _resourceInfo.addRead(read);
+        return read;
+      });
+    }
+    return _dispatch(_IOService.fileReadVAt, [null, pointers, position])
+        .then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(
+            response, "readIntoBuffersAt failed", path);
+      }
+      _resourceInfo.addRead(response);
+      return response;
+    });
+  }
+
+  Future<RandomAccessFile> writeFromAt(List<int> buffer, int position,
+      [int start = 0, int end]) {
+    if ((buffer is! List) ||
+        (position is! int) ||
+        ((start != null) && (start is! int)) ||
+        ((end != null) && (end is! int))) {
+      throw new ArgumentError("Invalid arguments to writeFromAt");
+    }
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(this);
+    }
+    var error = _dispatchError();
+    if (error != null) return error;
+    List request = new List(5);
+    request[0] = null;
+    request[4] = position;
+    List<int> pointers = _bufferPointers(<List<int>>[buffer]);
+    if (pointers != null) {
+      request[1] = pointers.first;
+      request[2] = start;
+      request[3] = end;
+    } else {
+      _BufferAndStart result;
+      try {
+        result = _ensureFastAndSerializableByteData(buffer, start, end);
+      } catch (e) {
+        return new Future.error(e);
+      }
+      request[1] = result.buffer;
+      request[2] = result.start;
+      request[3] = end - (start - result.start);
+    }
+    return _dispatch(_IOService.fileWriteAt, request).then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(response, "writeFromAt failed", path);
+      }
+      _resourceInfo.addWrite(response);
+      return this;
+    });
+  }
+
   Future<RandomAccessFile> writeString(String string,
       {Encoding encoding: utf8}) {
     ArgumentError.checkNotNull(encoding, 'encoding');
@@ -1063,7 +1202,8 @@ class _RandomAccessFile implements RandomAccessFile {
   // count when it is finished with it.
   int _pointer() => _ops.getPointer();
 
-  Future _dispatch(int request, List data, {bool markClosed: false}) {
+  // The error a request dispatched now completes with, or null.
+  Future _dispatchError() {
     if (closed) {
       return new Future.error(new FileSystemException("File closed", path));
     }
@@ -1071,6 +1211,12 @@ class _RandomAccessFile implements RandomAccessFile {
       var msg = "An async operation is currently pending";
       return new Future.error(new FileSystemException(msg, path));
     }
+    return null;
+  }
+
+  Future _dispatch(int request, List data, {bool markClosed: false}) {
+    var error = _dispatchError();
+    if (error != null) return error;
     if (markClosed) {
       // Set closed to true to ensure that no more async requests can be issued
       // for this file.
@@ -49,6 +49,10 @@ class _IOService {
   static const int directoryListStop = 40;
   static const int directoryRename = 41;
   static const int sslProcessFilter = 42;
+  static const int fileReadAt = 43;
+  static const int fileReadVAt = 44;
+  static const int fileWriteAt = 45;
+  static const int socketSendFile = 46;
 
   external static Future _dispatch(int request, List data);
 }
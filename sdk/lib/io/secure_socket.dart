@@ -692,6 +692,22 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     return result;
   }
 
+  int readInto(Uint8List buffer, [int offset = 0, int count]) {
+    if (offset == null) offset = 0;
+    if (count == null) count = buffer.length - offset;
+    RangeError.checkValidRange(offset, offset + count, buffer.length);
+    if (_closedRead) {
+      throw new SocketException("Reading from a closed socket");
+    }
+    if (_status != connectedStatus) {
+      return 0;
+    }
+    var result =
+        _secureFilter.buffers[readPlaintextId].readInto(buffer, offset, count);
+    _scheduleFilter();
+    return result;
+  }
+
   // Write the data to the socket, and schedule the filter to encrypt it.
   int write(List<int> data, [int offset, int bytes]) {
     if (bytes != null && (bytes is! int || bytes < 0)) {
@@ -1165,15 +1181,22 @@ class _ExternalBuffer {
     }
     if (bytes == 0) return null;
     List<int> result = new Uint8List(bytes);
+    readInto(result, 0, bytes);
+    return result;
+  }
+
+  int readInto(List<int> buffer, int offset, int bytes) {
+    bytes = min(bytes, length);
     int bytesRead = 0;
     // Loop over zero, one, or two linear data ranges.
     while (bytesRead < bytes) {
       int toRead = min(bytes - bytesRead, linearLength);
-      result.setRange(bytesRead, bytesRead + toRead, data, start);
+      buffer.setRange(offset + bytesRead, offset + bytesRead + toRead, data,
+          start);
       advanceStart(toRead);
       bytesRead += toRead;
     }
-    return result;
+    return bytesRead;
   }
 
   int write(List<int> inputData, int offset, int bytes) {
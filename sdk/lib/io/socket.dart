@@ -620,6 +620,18 @@ abstract class RawSocket implements Stream<RawSocketEvent> {
    */
   List<int> read([int len]);
 
+  /**
+   * Read up to [count] bytes from the socket into [buffer], starting at
+   * [offset]. If [count] is omitted, up to the rest of [buffer] is filled.
+   * This function is non-blocking and will only read data if data is
+   * available. Returns the number of bytes read, which is `0` if no data is
+   * available.
+   *
+   * Unlike [read], this does not allocate a new list for the data, so the
+   * same buffer can be used for all reads from a socket.
+   */
+  int readInto(Uint8List buffer, [int offset = 0, int count]);
+
   /**
    * Writes up to [count] bytes of the buffer from [offset] buffer offset to
    * the socket. The number of successfully written bytes is returned. This
@@ -765,6 +777,23 @@ abstract class Socket implements Stream<List<int>>, IOSink {
    */
   void destroy();
 
+  /**
+   * Sends [length] bytes of [file] starting at [offset], or the rest of the
+   * file if [length] is omitted, after the data already added to the socket.
+   *
+   * Where the platform supports it, the bytes are sent directly from the file
+   * by the operating system without being copied into the isolate, so the
+   * position of [file] is not used. Otherwise the range is read like
+   * [RandomAccessFile.read] does. No other operations may be performed on
+   * [file] until the sending is done.
+   *
+   * Returns a stream reporting the total number of bytes sent so far. The
+   * stream is done when the range has been sent, or when the end of the file
+   * is reached first. Like for [addStream], no data can be added to the
+   * socket until then.
+   */
+  Stream<int> sendFile(RandomAccessFile file, [int offset = 0, int length]);
+
   /**
    * Use [setOption] to customize the [RawSocket]. See [SocketOption] for
    * available options.
@@ -931,6 +960,33 @@ abstract class RawDatagramSocket extends Stream<RawSocketEvent> {
    */
   Datagram receive();
 
+  /**
+   * Send several datagrams to the same destination.
+   *
+   * The datagrams are stored back to back in [buffer]. Datagram `i` is the
+   * bytes from `ends[i - 1]` (`0` for the first datagram) up to `ends[i]`.
+   *
+   * Returns the number of datagrams sent, which may be less than
+   * `ends.length` if the socket cannot send more at the moment.
+   */
+  int sendMultiple(
+      Uint8List buffer, Int32List ends, InternetAddress address, int port);
+
+  /**
+   * Receive up to `ends.length` datagrams into [buffer].
+   *
+   * The datagrams received are stored back to back in [buffer] and their end
+   * offsets in [ends], so that datagram `i` is the bytes from `ends[i - 1]`
+   * (`0` for the first datagram) up to `ends[i]`. While receiving, [buffer]
+   * is split evenly between the datagrams, so a datagram longer than
+   * `buffer.length ~/ ends.length` bytes is truncated. The addresses of the
+   * senders are not reported.
+   *
+   * Returns the number of datagrams received, which is `0` if there are no
+   * datagrams available.
+   */
+  int receiveMultiple(Uint8List buffer, Int32List ends);
+
   /**
    * Join a multicast group.
    *
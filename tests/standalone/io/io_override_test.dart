@@ -31,7 +31,9 @@ class DirectoryMock extends FileSystemEntity implements Directory {
   Directory renameSync(String newPath) => null;
   Directory get absolute => null;
   Stream<FileSystemEntity> list(
-          {bool recursive: false, bool followLinks: true}) =>
+          {bool recursive: false,
+          bool followLinks: true,
+          bool parallel: false}) =>
       null;
   List<FileSystemEntity> listSync(
           {bool recursive: false, bool followLinks: true}) =>
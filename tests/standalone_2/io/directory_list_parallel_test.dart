@@ -0,0 +1,109 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that parallel recursive directory listings report the same entries
+// as ordered ones, for trees with more entries than fit in a single batch.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+// A batch of listing results holds 256KB of paths. With long file names a
+// few thousand entries fill several batches, and each directory fills enough
+// of a batch that some are cut off by a full batch and finished by the next.
+const directories = 12;
+const filesPerDirectory = 350;
+final fileName = 'file_' + 'x' * 150;
+
+// Creates a tree of nested and sibling directories with files, a link to a
+// file and a link making a loop, and returns the number of entries in it.
+int createTree(Directory root) {
+  int entries = 0;
+  var parent = root;
+  for (int i = 0; i < directories; i++) {
+    // Every fourth directory is nested in the previous one.
+    var directory = new Directory('${(i % 4 == 0 ? parent : root).path}/d$i')
+      ..createSync();
+    parent = directory;
+    entries++;
+    for (int j = 0; j < filesPerDirectory; j++) {
+      new File('${directory.path}/${fileName}_$j').createSync();
+      entries++;
+    }
+  }
+  new Link('${root.path}/d1/file_link')
+      .createSync('${root.path}/d1/${fileName}_0');
+  new Link('${root.path}/d2/loop').createSync(root.path);
+  return entries + 2;
+}
+
+Future<Map<String, FileSystemEntity>> listEntries(Directory directory,
+    {bool parallel, bool followLinks: false}) async {
+  var entries = <String, FileSystemEntity>{};
+  await for (var entry in directory.list(
+      recursive: true, followLinks: followLinks, parallel: parallel)) {
+    Expect.isFalse(entries.containsKey(entry.path), entry.path);
+    entries[entry.path] = entry;
+  }
+  return entries;
+}
+
+Future testParallelListing(Directory root, int entries) async {
+  var ordered = await listEntries(root, parallel: false);
+  var parallel = await listEntries(root, parallel: true);
+
+  Expect.equals(entries, ordered.length);
+  Expect.equals(entries, parallel.length);
+  ordered.forEach((path, entity) => Expect.equals(
+      entity.runtimeType, parallel[path].runtimeType, path));
+  Expect.isTrue(parallel['${root.path}/d2/loop'] is Link);
+
+  // Listings that follow links are ordered.
+  var followed = await listEntries(root, parallel: true, followLinks: true);
+  Expect.isTrue(followed['${root.path}/d1/file_link'] is File);
+  Expect.isTrue(followed['${root.path}/d2/loop'] is Directory);
+  Expect.isTrue(followed['${root.path}/d2/loop/d2/loop'] is Link);
+}
+
+Future testCancel(Directory root) async {
+  int count = 0;
+  var subscription;
+  var done = new Completer();
+  subscription = root.list(recursive: true, parallel: true).listen((_) {
+    if (++count == 1000) {
+      subscription.cancel().then(done.complete);
+    }
+  });
+  await done.future;
+  Expect.equals(1000, count);
+}
+
+Future testErrors(Directory root) async {
+  var missing = new Directory('${root.path}/missing');
+  var errors = 0;
+  await missing
+      .list(recursive: true, parallel: true)
+      .handleError((e) {
+        Expect.isTrue(e is FileSystemException);
+        errors++;
+      })
+      .toList();
+  Expect.equals(1, errors);
+}
+
+main() async {
+  asyncStart();
+  var root = await Directory.systemTemp.createTemp('directory_list_parallel');
+  try {
+    int entries = createTree(root);
+    await testParallelListing(root, entries);
+    await testCancel(root);
+    await testErrors(root);
+  } finally {
+    await root.delete(recursive: true);
+  }
+  asyncEnd();
+}
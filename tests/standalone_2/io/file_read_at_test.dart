@@ -0,0 +1,132 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test positional reads and writes past 2GB in a sparse file, with buffers
+// from RandomAccessFile.allocateBuffer and with plain lists.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const chunkSize = 16 * 1024 * 1024;
+
+// Files are not sparse on Windows, so the test would write out gigabytes
+// there. It uses a small file instead of going past the range of a 32-bit
+// signed offset.
+final int boundary =
+    Platform.isWindows ? 4 * chunkSize : 2 * 1024 * 1024 * 1024;
+final int fileSize = boundary + chunkSize + 12345;
+
+final markerPositions = [0, boundary - 8, boundary + 100, fileSize - 4];
+
+List<int> marker(int index) => [index + 1, 0xab, 0xcd, index + 1];
+
+Future writeMarkers(RandomAccessFile file) async {
+  await file.truncate(fileSize);
+  for (int i = 0; i < markerPositions.length; i++) {
+    var data = RandomAccessFile.allocateBuffer(8);
+    data.setRange(2, 6, marker(i));
+    // Direct buffers and plain lists, with a sub-range of the buffer.
+    if (i.isEven) {
+      await file.writeFromAt(data, markerPositions[i], 2, 6);
+    } else {
+      await file.writeFromAt(data.toList(), markerPositions[i], 2, 6);
+    }
+  }
+}
+
+// Reads the end of the file sequentially and checks the markers in it.
+Future testSequentialRead(RandomAccessFile file) async {
+  var buffer = RandomAccessFile.allocateBuffer(chunkSize);
+  var found = 0;
+  int start = boundary - 2 * chunkSize;
+  int position = start;
+  while (true) {
+    int read = await file.readIntoAt(buffer, position);
+    for (int i = 0; i < markerPositions.length; i++) {
+      int offset = markerPositions[i] - position;
+      if (offset >= 0 && offset + 4 <= read) {
+        Expect.listEquals(marker(i), buffer.sublist(offset, offset + 4));
+        found++;
+      }
+    }
+    position += read;
+    if (read < chunkSize) break;
+  }
+  Expect.equals(fileSize, position);
+  Expect.equals(markerPositions.where((p) => p >= start).length, found);
+}
+
+Future testReadIntoAt(RandomAccessFile file) async {
+  for (int i = 0; i < markerPositions.length; i++) {
+    var plain = new List<int>.filled(10, 0);
+    Expect.equals(4, await file.readIntoAt(plain, markerPositions[i], 3, 7));
+    Expect.listEquals([0, 0, 0]..addAll(marker(i))..addAll([0, 0, 0]), plain);
+    var direct = RandomAccessFile.allocateBuffer(4);
+    Expect.equals(4, await file.readIntoAt(direct, markerPositions[i]));
+    Expect.listEquals(marker(i), direct);
+  }
+  // Reads stop at the end of the file.
+  var buffer = RandomAccessFile.allocateBuffer(100);
+  Expect.equals(4, await file.readIntoAt(buffer, fileSize - 4));
+  Expect.equals(0, await file.readIntoAt(buffer, fileSize + 100));
+  Expect.equals(0, await file.readIntoAt(new List<int>(10), fileSize));
+}
+
+Future testReadIntoBuffersAt(RandomAccessFile file) async {
+  int position = markerPositions[1] - 3;
+  var expected = new List<int>.filled(120, 0);
+  expected.setRange(3, 7, marker(1));
+  expected.setRange(111, 115, marker(2));
+  for (bool direct in [true, false]) {
+    var buffers = [7, 1, 100, 12]
+        .map((length) => direct
+            ? RandomAccessFile.allocateBuffer(length)
+            : new Uint8List(length))
+        .toList();
+    Expect.equals(120, await file.readIntoBuffersAt(buffers, position));
+    Expect.listEquals(expected, buffers.expand((buffer) => buffer).toList());
+  }
+  // The last buffers are not filled at the end of the file.
+  var buffers = [
+    RandomAccessFile.allocateBuffer(2),
+    RandomAccessFile.allocateBuffer(10),
+    RandomAccessFile.allocateBuffer(10)
+  ];
+  buffers[2][0] = 42;
+  Expect.equals(4, await file.readIntoBuffersAt(buffers, fileSize - 4));
+  Expect.listEquals(marker(3).sublist(0, 2), buffers[0]);
+  Expect.listEquals(marker(3).sublist(2), buffers[1].sublist(0, 2));
+  Expect.equals(42, buffers[2][0]);
+  Expect.equals(0, await file.readIntoBuffersAt([], 0));
+}
+
+main() async {
+  asyncStart();
+  var directory = await Directory.systemTemp.createTemp('file_read_at');
+  var file =
+      await new File('${directory.path}/data').open(mode: FileMode.write);
+  try {
+    await file.setPosition(42);
+    await writeMarkers(file);
+    await testSequentialRead(file);
+    await testReadIntoAt(file);
+    await testReadIntoBuffersAt(file);
+    // The file position is not used.
+    Expect.equals(42, await file.position());
+    Expect.throws(() => RandomAccessFile.allocateBuffer(-1));
+  } finally {
+    await file.close();
+    await directory.delete(recursive: true);
+  }
+  // Requests on a closed file fail, and do not leak the buffers.
+  var buffer = RandomAccessFile.allocateBuffer(10);
+  await file.readIntoAt(buffer, 0).then((_) {
+    Expect.fail("readIntoAt on a closed file");
+  }, onError: (e) => Expect.isTrue(e is FileSystemException));
+  asyncEnd();
+}
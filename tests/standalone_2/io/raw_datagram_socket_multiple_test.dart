@@ -0,0 +1,84 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test sending and receiving several datagrams at a time.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const datagramCount = 200;
+
+int datagramLength(int i) => 1 + (i * 7) % 100;
+
+Future testSendReceiveMultiple() async {
+  var receiver = await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var sender = await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0);
+
+  var data = new Uint8List(datagramCount * 101);
+  var ends = new Int32List(datagramCount);
+  int end = 0;
+  for (int i = 0; i < datagramCount; i++) {
+    data.fillRange(end, end + datagramLength(i), i);
+    end += datagramLength(i);
+    ends[i] = end;
+  }
+  Expect.throws(() => sender.sendMultiple(new Uint8List(10), ends,
+      receiver.address, receiver.port));
+  Expect.throws(() => receiver.receiveMultiple(data, new Int32List(0)));
+
+  var done = new Completer();
+  var buffer = new Uint8List(16 * 101);
+  var received = new Int32List(16);
+  int next = 0;
+  receiver.listen((event) {
+    if (event != RawSocketEvent.read) return;
+    int count = receiver.receiveMultiple(buffer, received);
+    int start = 0;
+    for (int i = 0; i < count; i++, next++) {
+      Expect.equals(datagramLength(next), received[i] - start);
+      for (int j = start; j < received[i]; j++) {
+        Expect.equals(next, buffer[j]);
+      }
+      start = received[i];
+    }
+    // Interleave the single datagram path.
+    var datagram = receiver.receive();
+    if (datagram != null) {
+      Expect.equals(datagramLength(next), datagram.data.length);
+      Expect.isTrue(datagram.data.every((byte) => byte == next));
+      Expect.equals(sender.port, datagram.port);
+      next++;
+    }
+    if (next == datagramCount) done.complete();
+  });
+
+  // Send in small batches so that the receive buffers do not overflow.
+  int sent = 0;
+  while (sent < datagramCount) {
+    int start = sent == 0 ? 0 : ends[sent - 1];
+    int count = datagramCount - sent < 10 ? datagramCount - sent : 10;
+    var batchEnds = new Int32List(count);
+    for (int i = 0; i < count; i++) {
+      batchEnds[i] = ends[sent + i] - start;
+    }
+    var batch = new Uint8List.view(data.buffer, start);
+    sent +=
+        sender.sendMultiple(batch, batchEnds, receiver.address, receiver.port);
+    await new Future.delayed(const Duration(milliseconds: 1));
+  }
+  await done.future;
+  Expect.equals(0, receiver.receiveMultiple(buffer, received));
+  receiver.close();
+  sender.close();
+}
+
+main() async {
+  asyncStart();
+  await testSendReceiveMultiple();
+  asyncEnd();
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test closing many sockets while events for them are still being delivered,
+// which makes the event handler send several events for a socket in one
+// message.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const connectionsCount = 50;
+const messageSize = 100;
+
+Future<int> readAll(RawSocket socket) {
+  var completer = new Completer<int>();
+  int received = 0;
+  socket.listen((event) {
+    if (event == RawSocketEvent.read) {
+      var data = socket.read();
+      if (data != null) received += data.length;
+    } else if (event == RawSocketEvent.readClosed) {
+      socket.close().then((_) => completer.complete(received));
+    }
+  });
+  return completer.future;
+}
+
+Future testServerClosesImmediately() async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    socket.write(new List<int>.filled(messageSize, 1));
+    socket.close();
+  });
+  var received = await Future.wait(new List.generate(connectionsCount,
+      (_) => RawSocket.connect(server.address, server.port).then(readAll)));
+  for (var count in received) {
+    Expect.equals(messageSize, count);
+  }
+  await server.close();
+}
+
+Future testClientClosesAfterWrite() async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var destroyed = <Future>[];
+  server.listen((socket) {
+    destroyed.add(readAll(socket));
+  });
+  var clients = await Future.wait(new List.generate(connectionsCount,
+      (_) => RawSocket.connect(server.address, server.port)));
+  var closed = clients.map((client) {
+    client.write(new List<int>.filled(messageSize, 1));
+    return client.close();
+  }).toList();
+  await Future.wait(closed);
+  while (destroyed.length < connectionsCount) {
+    await new Future.delayed(const Duration(milliseconds: 10));
+  }
+  var received = await Future.wait(destroyed);
+  for (var count in received) {
+    Expect.equals(messageSize, count);
+  }
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await testServerClosesImmediately();
+  await testClientClosesAfterWrite();
+  asyncEnd();
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test reading from a RawSocket into a reused buffer.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const messageSize = 100000;
+
+Future testReadInto() async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    var data = new Uint8List(messageSize);
+    for (int i = 0; i < messageSize; i++) {
+      data[i] = i & 0xff;
+    }
+    int written = 0;
+    socket.listen((event) {
+      if (event == RawSocketEvent.write) {
+        written += socket.write(data, written);
+        if (written < messageSize) {
+          socket.writeEventsEnabled = true;
+        } else {
+          socket.shutdown(SocketDirection.send);
+        }
+      } else if (event == RawSocketEvent.readClosed) {
+        socket.close();
+      }
+    });
+  });
+
+  var client = await RawSocket.connect(server.address, server.port);
+  var done = new Completer();
+  var buffer = new Uint8List(1000);
+  int received = 0;
+  client.listen((event) {
+    if (event == RawSocketEvent.read) {
+      // Check that only the given range of the buffer is written.
+      Expect.equals(0, client.readInto(buffer, 100, 0));
+      buffer.fillRange(0, buffer.length, 0xaa);
+      int bytes = client.readInto(buffer, 100, 333);
+      Expect.isTrue(bytes <= 333);
+      for (int i = 0; i < buffer.length; i++) {
+        if (i < 100 || i >= 100 + bytes) {
+          Expect.equals(0xaa, buffer[i]);
+        } else {
+          Expect.equals((received + i - 100) & 0xff, buffer[i]);
+        }
+      }
+      received += bytes;
+      bytes = client.readInto(buffer);
+      for (int i = 0; i < bytes; i++) {
+        Expect.equals((received + i) & 0xff, buffer[i]);
+      }
+      received += bytes;
+    } else if (event == RawSocketEvent.readClosed) {
+      Expect.equals(0, client.readInto(buffer));
+      client.close();
+      done.complete();
+    }
+  });
+  await done.future;
+  Expect.equals(messageSize, received);
+  Expect.throws(() => client.readInto(buffer, 900, 200));
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await testReadInto();
+  asyncEnd();
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test sending ranges of a file on a socket, between data added to the
+// socket.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const fileSize = 1000000;
+
+Future testSendFile(RandomAccessFile file, Uint8List contents) async {
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = new Completer<List<int>>();
+  server.listen((socket) {
+    var bytes = <int>[];
+    socket.listen(bytes.addAll, onDone: () {
+      received.complete(bytes);
+      socket.destroy();
+    });
+  });
+
+  var client = await Socket.connect(server.address, server.port);
+  var expected = <int>[];
+  void expectRange(int start, int end) {
+    expected.addAll(contents.sublist(start, end < fileSize ? end : fileSize));
+  }
+
+  client.add([1, 2, 3]);
+  expected.addAll([1, 2, 3]);
+  var progress = await client.sendFile(file, 1000, 300000).toList();
+  expectRange(1000, 301000);
+  Expect.isTrue(progress.isNotEmpty);
+  Expect.equals(300000, progress.last);
+  for (int i = 1; i < progress.length; i++) {
+    Expect.isTrue(progress[i - 1] < progress[i]);
+  }
+
+  // Data added while the file is sent is rejected.
+  var sending = client.sendFile(file, fileSize - 10000).drain();
+  Expect.throws(() => client.add([4]), (e) => e is StateError);
+  await sending;
+  expectRange(fileSize - 10000, fileSize);
+
+  // A range past the end of the file stops at the end.
+  progress = await client.sendFile(file, fileSize - 100, 1000).toList();
+  expectRange(fileSize - 100, fileSize);
+  Expect.equals(100, progress.last);
+  await client.sendFile(file, 0, 0).drain();
+
+  // The file position is not used.
+  await file.setPosition(12345);
+  await client.sendFile(file).drain();
+  expectRange(0, fileSize);
+
+  client.add([5, 6]);
+  expected.addAll([5, 6]);
+  await client.close();
+  Expect.listEquals(expected, await received.future);
+  await server.close();
+}
+
+// Destroying the socket while a part of the file is sent on the IO service
+// closes it once that part is sent.
+Future testDestroyWhileSending(RandomAccessFile file) async {
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var closed = new Completer();
+  server.listen((socket) {
+    socket.listen((_) {}, onDone: () {
+      socket.destroy();
+      closed.complete();
+    });
+  });
+
+  var client = await Socket.connect(server.address, server.port);
+  client.sendFile(file).listen((_) {}, onError: (_) {});
+  await new Future.delayed(const Duration(milliseconds: 1));
+  client.destroy();
+  await closed.future;
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  var directory = await Directory.systemTemp.createTemp('socket_send_file');
+  var contents = new Uint8List(fileSize);
+  for (int i = 0; i < fileSize; i++) {
+    contents[i] = (i * 31) & 0xff;
+  }
+  var path = '${directory.path}/data';
+  await new File(path).writeAsBytes(contents);
+  var file = await new File(path).open();
+  try {
+    await testSendFile(file, contents);
+    await testDestroyWhileSending(file);
+  } finally {
+    await file.close();
+    await directory.delete(recursive: true);
+  }
+  asyncEnd();
+}
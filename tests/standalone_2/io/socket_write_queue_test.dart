@@ -0,0 +1,67 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test writing many buffers to a socket whose peer does not read for a while,
+// so that buffers are queued and written together.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const chunkCount = 1000;
+
+List<int> chunk(int i) {
+  int length = (i * 37) % 1000;
+  switch (i % 3) {
+    case 0:
+      return new Uint8List(length)..fillRange(0, length, i & 0xff);
+    case 1:
+      return new List<int>.filled(length, i & 0xff);
+    default:
+      var bytes = new Uint8List(length + 20);
+      bytes.fillRange(0, bytes.length, i & 0xff);
+      return new Uint8List.view(bytes.buffer, 10, length);
+  }
+}
+
+Future test({bool close}) async {
+  var server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = new Completer<List<int>>();
+  server.listen((socket) {
+    var bytes = <int>[];
+    var subscription;
+    subscription = socket.listen(bytes.addAll, onDone: () {
+      received.complete(bytes);
+      socket.destroy();
+    });
+    // Let the writer fill the socket buffers before reading.
+    subscription.pause(new Future.delayed(const Duration(milliseconds: 200)));
+  });
+
+  var client = await Socket.connect(server.address, server.port);
+  var expected = <int>[];
+  for (int i = 0; i < chunkCount; i++) {
+    var data = chunk(i);
+    expected.addAll(data);
+    client.add(data);
+  }
+  if (close) {
+    await client.close();
+  } else {
+    await client.flush();
+    client.destroy();
+  }
+  Expect.listEquals(expected, await received.future);
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  await test(close: true);
+  await test(close: false);
+  asyncEnd();
+}